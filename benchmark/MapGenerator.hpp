@@ -0,0 +1,147 @@
+#pragma once
+
+#include <random>
+#include <string>
+
+#include "multibot_util/Instance.hpp"
+
+namespace Benchmark
+{
+    namespace MapGenerator
+    {
+        enum Layout
+        {
+            RANDOM,
+            MAZE,
+            WAREHOUSE
+        }; // enum Layout
+
+        inline std::string layoutName(Layout _layout)
+        {
+            switch (_layout)
+            {
+            case Layout::RANDOM:
+                return "random";
+            case Layout::MAZE:
+                return "maze";
+            default:
+                return "warehouse";
+            }
+        }
+
+        // Fills the rectangle [_x, _x + _w) x [_y, _y + _h), clipped to the map
+        inline void fillRect(Instance::MapInstance::BitGrid &_grid, int _x, int _y, int _w, int _h)
+        {
+            for (int y = std::max(0, _y); y < std::min(_grid.height(), _y + _h); ++y)
+                for (int x = std::max(0, _x); x < std::min(_grid.width(), _x + _w); ++x)
+                    _grid.set(x, y, true);
+        }
+
+        // Isolated obstacle cells with the given density
+        inline void random(Instance::MapInstance::BitGrid &_grid, double _density, std::mt19937_64 &_rng)
+        {
+            std::bernoulli_distribution occupied(_density);
+            for (int y = 0; y < _grid.height(); ++y)
+                for (int x = 0; x < _grid.width(); ++x)
+                    _grid.set(x, y, occupied(_rng));
+        }
+
+        // Perfect maze carved by an iterative depth-first search over blocks of
+        // _corridor free cells separated by one-cell walls
+        inline void maze(Instance::MapInstance::BitGrid &_grid, int _corridor, std::mt19937_64 &_rng)
+        {
+            _grid.fill(true);
+
+            const int pitch = _corridor + 1;
+            const int cols = std::max(1, (_grid.width() - 1) / pitch);
+            const int rows = std::max(1, (_grid.height() - 1) / pitch);
+            const auto carve = [&](int _col, int _row, int _w, int _h)
+            {
+                for (int y = 1 + _row * pitch; y < 1 + _row * pitch + _h; ++y)
+                    for (int x = 1 + _col * pitch; x < 1 + _col * pitch + _w; ++x)
+                        if (x < _grid.width() and y < _grid.height())
+                            _grid.set(x, y, false);
+            };
+
+            std::vector<bool> visited(static_cast<std::size_t>(cols) * rows, false);
+            std::vector<int> stack{0};
+            visited[0] = true;
+            carve(0, 0, _corridor, _corridor);
+            while (not(stack.empty()))
+            {
+                const int current = stack.back();
+                const int col = current % cols;
+                const int row = current / cols;
+
+                int candidates[4];
+                int count = 0;
+                if (col > 0 and not(visited[current - 1]))
+                    candidates[count++] = current - 1;
+                if (col + 1 < cols and not(visited[current + 1]))
+                    candidates[count++] = current + 1;
+                if (row > 0 and not(visited[current - cols]))
+                    candidates[count++] = current - cols;
+                if (row + 1 < rows and not(visited[current + cols]))
+                    candidates[count++] = current + cols;
+
+                if (count == 0)
+                {
+                    stack.pop_back();
+                    continue;
+                }
+
+                const int next = candidates[std::uniform_int_distribution<int>(0, count - 1)(_rng)];
+                const int nextCol = next % cols;
+                const int nextRow = next / cols;
+                // Carving the union of both blocks also removes the wall between them
+                carve(std::min(col, nextCol), std::min(row, nextRow),
+                      _corridor + (nextCol != col) * pitch, _corridor + (nextRow != row) * pitch);
+
+                visited[next] = true;
+                stack.push_back(next);
+            }
+        }
+
+        // Border walls and rows of two-cell deep shelves separated by aisles,
+        // broken up by cross aisles
+        inline void warehouse(Instance::MapInstance::BitGrid &_grid, int _aisle, int _shelf_length)
+        {
+            _grid.fill(false);
+            fillRect(_grid, 0, 0, _grid.width(), 1);
+            fillRect(_grid, 0, _grid.height() - 1, _grid.width(), 1);
+            fillRect(_grid, 0, 0, 1, _grid.height());
+            fillRect(_grid, _grid.width() - 1, 0, 1, _grid.height());
+
+            for (int y = 1 + _aisle; y + 2 < _grid.height() - _aisle; y += 2 + _aisle)
+                for (int x = 1 + _aisle; x + _shelf_length < _grid.width() - _aisle; x += _shelf_length + _aisle)
+                    fillRect(_grid, x, y, _shelf_length, 2);
+        }
+
+        inline void generate(Instance::MapInstance::BinaryOccupancyMap &_map, Layout _layout, int _size,
+                             double _resolution = 0.05, std::uint64_t _seed = 1)
+        {
+            Instance::MapInstance::BinaryOccupancyMap::MapProperty property;
+            property.origin_ = MAPF_Util::Position::Coordinates(0.0, 0.0);
+            property.width_ = _size;
+            property.height_ = _size;
+            property.resolution_ = _resolution;
+            property.inflation_radius_ = 0.0;
+            _map.initialize(property);
+
+            std::mt19937_64 rng(_seed);
+            switch (_layout)
+            {
+            case Layout::RANDOM:
+                random(_map.mapData_, 0.05, rng);
+                break;
+            case Layout::MAZE:
+                maze(_map.mapData_, 20, rng);
+                break;
+            default:
+                warehouse(_map.mapData_, 24, 40);
+                break;
+            }
+            _map.computeDistanceField();
+        }
+    } // namespace MapGenerator
+} // namespace Benchmark
\ No newline at end of file
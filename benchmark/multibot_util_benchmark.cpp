@@ -0,0 +1,568 @@
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+#include "MapGenerator.hpp"
+#include "multibot_util/Traj/TrajCodec.hpp"
+#include "multibot_util/Traj/TrajSampler.hpp"
+#include "multibot_util/Util/EpisodeArena.hpp"
+
+using namespace Instance;
+
+namespace Benchmark
+{
+    struct Result
+    {
+        std::string name_;
+        std::size_t iterations_;
+        double median_ns_;
+        double min_ns_;
+    }; // struct Result
+
+    struct Options
+    {
+        std::string json_path_;
+        std::string baseline_path_;
+        std::string filter_;
+        double tolerance_ = 0.15;
+        double min_time_ = 0.2;
+        int max_size_ = 8000;
+    }; // struct Options
+
+    // Results feed this sink so the optimizer cannot drop the measured work
+    volatile std::size_t sink = 0;
+
+    class Runner
+    {
+    public:
+        bool enabled(const std::string &_name) const
+        {
+            return options_.filter_.empty() or _name.find(options_.filter_) != std::string::npos;
+        }
+
+        // Repeats _function until min_time_ has passed and at least three runs
+        // are done, unless a single run already takes longer than min_time_.
+        // _setup runs before every repetition and is not timed.
+        void run(const std::string &_name, const std::function<void()> &_function,
+                 const std::function<void()> &_setup = nullptr)
+        {
+            if (not(enabled(_name)))
+                return;
+
+            std::vector<double> samples;
+            double total = 0.0;
+            while (samples.size() < 3 or total < options_.min_time_)
+            {
+                if (_setup)
+                    _setup();
+
+                const auto begin = std::chrono::steady_clock::now();
+                _function();
+                const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+                samples.push_back(elapsed.count() * 1e9);
+                total += elapsed.count();
+                if (samples.size() == 1 and total > options_.min_time_)
+                    break;
+            }
+
+            std::sort(samples.begin(), samples.end());
+            results_.push_back(Result{_name, samples.size(), samples[samples.size() / 2], samples.front()});
+
+            std::cout << std::left << std::setw(56) << _name << std::right
+                      << std::setw(14) << std::fixed << std::setprecision(3) << samples[samples.size() / 2] * 1e-6 << " ms"
+                      << std::setw(8) << samples.size() << " runs" << std::endl;
+        }
+
+        bool writeJson(const std::string &_path) const
+        {
+            std::ofstream file(_path);
+            if (not(file.is_open()))
+            {
+                std::cerr << "[Error] Runner::writeJson(): Cannot open " << _path << std::endl;
+                return false;
+            }
+
+            file << "{\n  \"benchmarks\": [\n";
+            for (std::size_t i = 0; i < results_.size(); ++i)
+            {
+                file << "    {\"name\": \"" << results_[i].name_ << "\""
+                     << ", \"iterations\": " << results_[i].iterations_
+                     << ", \"median_ns\": " << std::fixed << std::setprecision(1) << results_[i].median_ns_
+                     << ", \"min_ns\": " << results_[i].min_ns_ << "}"
+                     << (i + 1 < results_.size() ? ",\n" : "\n");
+            }
+            file << "  ]\n}\n";
+
+            return file.good();
+        }
+
+        // Reads the name and median_ns of every entry written by writeJson()
+        static bool readJson(const std::string &_path, std::map<std::string, double> &_medians)
+        {
+            std::ifstream file(_path);
+            if (not(file.is_open()))
+            {
+                std::cerr << "[Error] Runner::readJson(): Cannot open " << _path << std::endl;
+                return false;
+            }
+
+            std::string line;
+            while (std::getline(file, line))
+            {
+                const auto name = line.find("\"name\": \"");
+                const auto median = line.find("\"median_ns\": ");
+                if (name == std::string::npos or median == std::string::npos)
+                    continue;
+
+                const auto nameBegin = name + std::strlen("\"name\": \"");
+                _medians[line.substr(nameBegin, line.find('"', nameBegin) - nameBegin)] =
+                    std::strtod(line.c_str() + median + std::strlen("\"median_ns\": "), nullptr);
+            }
+
+            return true;
+        }
+
+        // Number of benchmarks whose median is slower than the baseline by more than tolerance_
+        std::size_t compare(const std::map<std::string, double> &_baseline) const
+        {
+            std::size_t regressions = 0;
+            std::cout << std::endl << "Comparison against baseline (tolerance "
+                      << std::setprecision(0) << options_.tolerance_ * 100 << "%)" << std::endl;
+            for (const auto &result : results_)
+            {
+                const auto baseline = _baseline.find(result.name_);
+                if (baseline == _baseline.end() or baseline->second <= 0.0)
+                {
+                    std::cout << "  [New]  " << result.name_ << std::endl;
+                    continue;
+                }
+
+                const double ratio = result.median_ns_ / baseline->second;
+                const bool regressed = ratio > 1.0 + options_.tolerance_;
+                regressions += regressed;
+                std::cout << (regressed ? "  [Slow] " : "  [Ok]   ") << std::left << std::setw(56) << result.name_
+                          << std::right << std::setprecision(2) << ratio << "x" << std::endl;
+            }
+
+            return regressions;
+        }
+
+    private:
+        const Options &options_;
+        std::vector<Result> results_;
+
+    public:
+        Runner(const Options &_options) : options_(_options) {}
+    }; // class Runner
+
+    void benchmarkMaps(Runner &_runner, const Options &_options)
+    {
+        static const double radii[] = {0.1, 0.25, 0.5, 1.0};
+
+        for (int size : {100, 500, 2000, 8000})
+        {
+            if (size > _options.max_size_)
+                continue;
+
+            for (auto layout : {MapGenerator::RANDOM, MapGenerator::MAZE, MapGenerator::WAREHOUSE})
+            {
+                const std::string prefix = "map/" + MapGenerator::layoutName(layout) + "/" + std::to_string(size) + "/";
+
+                // Maps are generated on first use, so filtered runs skip unused layouts
+                MapInstance::BinaryOccupancyMap map;
+                bool generated = false;
+                const auto generate = [&]()
+                {
+                    if (not(generated))
+                        MapGenerator::generate(map, layout, size);
+                    generated = true;
+                };
+
+                _runner.run(prefix + "distance_field", [&]()
+                            { map.computeDistanceField(); sink = sink + map.distance_field_.empty(); },
+                            generate);
+
+                for (double radius : radii)
+                {
+                    std::ostringstream suffix;
+                    suffix << "/r" << radius;
+
+                    _runner.run(prefix + "inflate_edt" + suffix.str(), [&]()
+                                { sink = sink + map.inflate(radius, MapInstance::InflationMode::EDT).width(); },
+                                generate);
+
+                    // The priority-queue brushfire grows too slow to time on the largest maps
+                    if (size <= 2000)
+                    {
+                        _runner.run(prefix + "inflate_brushfire" + suffix.str(), [&]()
+                                    { sink = sink + map.inflate(radius, MapInstance::InflationMode::BRUSHFIRE).width(); },
+                                    generate);
+                    }
+
+                    // 100 single-cell footprints, as used when inserting one agent
+                    std::mt19937_64 rng(7);
+                    std::uniform_int_distribution<int> coordinate(0, size - 1);
+                    std::vector<Position::Index> roots;
+                    for (int i = 0; i < 100; ++i)
+                        roots.emplace_back(coordinate(rng), coordinate(rng));
+
+                    _runner.run(prefix + "inflated_area" + suffix.str() + "/x100", [&]()
+                                {
+                                    for (const auto &root : roots)
+                                        sink = sink + map.getInflatedArea({root}, radius).size();
+                                },
+                                generate);
+
+                    std::vector<std::vector<Position::Index>> rootAreas;
+                    for (const auto &root : roots)
+                        rootAreas.push_back({root});
+                    _runner.run(prefix + "inflated_areas_batch" + suffix.str() + "/x100", [&]()
+                                { sink = sink + map.getInflatedAreas(rootAreas, radius).size(); },
+                                generate);
+                }
+
+                // Random points across the map, as sampled by a trajectory optimizer
+                std::vector<Position::Coordinates> points;
+                std::vector<double> clearances(1000000);
+                std::vector<Position::Coordinates> gradients(clearances.size());
+                const auto generatePoints = [&]()
+                {
+                    generate();
+                    if (not(points.empty()))
+                        return;
+                    std::mt19937_64 rng(11);
+                    std::uniform_real_distribution<double> coordinate(0.0, (size - 1) * map.property_.resolution_);
+                    for (std::size_t i = 0; i < clearances.size(); ++i)
+                        points.emplace_back(coordinate(rng), coordinate(rng));
+                    map.clearanceField();
+                };
+
+                _runner.run(prefix + "clearance/x1M", [&]()
+                            { map.clearanceField().clearances(points, clearances); sink = sink + clearances.back(); },
+                            generatePoints);
+                _runner.run(prefix + "clearance_gradient/x1M", [&]()
+                            { map.clearanceField().clearances(points, clearances, gradients); sink = sink + gradients.back().x_; },
+                            generatePoints);
+            }
+        }
+    }
+
+    void benchmarkGeometry(Runner &_runner)
+    {
+        constexpr std::size_t count = 1 << 20;
+        std::mt19937_64 rng(11);
+        std::uniform_real_distribution<double> position(-100.0, 100.0);
+        std::uniform_real_distribution<double> angle(-4 * M_PI, 4 * M_PI);
+
+        std::vector<Position::Pose> poses;
+        std::vector<Position::Coordinates> coords;
+        poses.reserve(count);
+        coords.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            poses.emplace_back(position(rng), position(rng), angle(rng));
+            coords.emplace_back(position(rng), position(rng));
+        }
+
+        _runner.run("geometry/get_distance/coordinates/x1M", [&]()
+                    {
+                        double total = 0.0;
+                        for (std::size_t i = 1; i < count; ++i)
+                            total += Position::getDistance(coords[i - 1], coords[i]);
+                        sink = sink + static_cast<std::size_t>(total);
+                    });
+
+        _runner.run("geometry/get_distance/pose/x1M", [&]()
+                    {
+                        double total = 0.0;
+                        for (std::size_t i = 1; i < count; ++i)
+                            total += Position::getDistance(poses[i - 1], poses[i]);
+                        sink = sink + static_cast<std::size_t>(total);
+                    });
+
+        _runner.run("geometry/get_angle_diff/x1M", [&]()
+                    {
+                        double total = 0.0;
+                        for (std::size_t i = 1; i < count; ++i)
+                            total += Position::getAngleDiff(poses[i - 1], poses[i]);
+                        sink = sink + static_cast<std::size_t>(total);
+                    });
+
+        std::vector<double> results(count - 1);
+        const std::span<const Position::Pose> from(poses.data(), count - 1), to(poses.data() + 1, count - 1);
+        _runner.run("geometry/get_distances/pose/x1M", [&]()
+                    { Position::getDistances(from, to, results); sink = sink + static_cast<std::size_t>(results.back()); });
+
+        _runner.run("geometry/get_angle_diffs/x1M", [&]()
+                    { Position::getAngleDiffs(from, to, results); sink = sink + static_cast<std::size_t>(results.back()); });
+    }
+
+    void benchmarkTimeLine(Runner &_runner)
+    {
+        constexpr std::size_t cells = 4096;
+        constexpr int reservations = 8;
+
+        std::mt19937_64 rng(13);
+        std::uniform_real_distribution<double> start(0.0, 100.0);
+        std::uniform_real_distribution<double> duration(0.1, 3.0);
+        std::vector<std::pair<Time::TimePoint, Time::TimePoint>> intervals;
+        for (std::size_t i = 0; i < cells * reservations; ++i)
+        {
+            const double begin = start(rng);
+            intervals.emplace_back(Time::TimePoint(begin), Time::TimePoint(begin + duration(rng)));
+        }
+
+        std::vector<Time::TimeLine> timeLines(cells);
+        const auto reset = [&]()
+        {
+            for (auto &timeLine : timeLines)
+                timeLine.clear();
+        };
+        const auto fill = [&]()
+        {
+            for (std::size_t i = 0; i < cells; ++i)
+                for (int j = 0; j < reservations; ++j)
+                    timeLines[i].insertReservation(intervals[i * reservations + j].first, intervals[i * reservations + j].second);
+        };
+
+        _runner.run("timeline/insert_reservation/4096x8", fill, reset);
+
+        _runner.run("timeline/remove_reservation/4096x8", [&]()
+                    {
+                        for (std::size_t i = 0; i < cells; ++i)
+                            for (int j = 0; j < reservations; ++j)
+                                timeLines[i].removeReservation(intervals[i * reservations + j].first, intervals[i * reservations + j].second);
+                    },
+                    [&]()
+                    { reset(); fill(); });
+
+        // The last removal left every time line empty; the queries only read, so refill once
+        reset();
+        fill();
+        _runner.run("timeline/find_next_safe_interval/4096x64", [&]()
+                    {
+                        std::size_t found = 0;
+                        for (std::size_t i = 0; i < cells; ++i)
+                            for (int t = 0; t < 64; ++t)
+                                found += timeLines[i].findNextSafeInterval(Time::TimePoint(t * 1.6)) != timeLines[i].interval_list_.end();
+                        sink = sink + found;
+                    });
+
+        _runner.run("timeline/is_safe/4096x64", [&]()
+                    {
+                        std::size_t safe = 0;
+                        for (std::size_t i = 0; i < cells; ++i)
+                            for (int t = 0; t < 64; ++t)
+                                safe += timeLines[i].isSafe(Time::TimePoint(t * 1.6));
+                        sink = sink + safe;
+                    });
+    }
+
+    Traj::TrajSet makeTrajSet(std::size_t _agents, std::size_t _nodes)
+    {
+        std::mt19937_64 rng(17);
+        std::uniform_real_distribution<double> step(-0.5, 0.5);
+        std::uniform_real_distribution<double> wait(0.0, 0.5);
+
+        Traj::TrajSet trajSet;
+        for (std::size_t agent = 0; agent < _agents; ++agent)
+        {
+            Traj::SingleTraj traj;
+            traj.agentName_ = "robot_" + std::to_string(agent);
+
+            Position::Pose pose(step(rng) * 100, step(rng) * 100, 0.0);
+            double time = 0.0;
+            for (std::size_t i = 0; i < _nodes; ++i)
+            {
+                Traj::SingleTraj::Node from, to;
+                from.pose_ = pose;
+                from.arrival_time_ = Time::TimePoint(time);
+                time += wait(rng);
+                from.departure_time_ = Time::TimePoint(time);
+
+                pose = Position::Pose(pose.component_.x + step(rng), pose.component_.y + step(rng), step(rng) * 2 * M_PI);
+                time += 1.0;
+                to.pose_ = pose;
+                to.arrival_time_ = Time::TimePoint(time);
+                to.departure_time_ = Time::TimePoint(time);
+                traj.nodes_.emplace_back(from, to);
+            }
+            traj.cost_ = time;
+            trajSet.emplace(traj.agentName_, traj);
+        }
+
+        return trajSet;
+    }
+
+    void benchmarkTrajSet(Runner &_runner)
+    {
+        constexpr std::size_t agents = 500;
+        constexpr std::size_t nodes = 200;
+
+        Traj::TrajSet trajSet;
+        _runner.run("trajset/build/500x200", [&]()
+                    { trajSet = makeTrajSet(agents, nodes); sink = sink + trajSet.size(); });
+
+        _runner.run("trajset/copy/500x200", [&]()
+                    { Traj::TrajSet copy = trajSet; sink = sink + copy.size(); });
+
+        _runner.run("trajset/find/500x1000", [&]()
+                    {
+                        std::size_t found = 0;
+                        for (int i = 0; i < 1000; ++i)
+                            found += trajSet.count("robot_" + std::to_string((i * 7919) % agents));
+                        sink = sink + found;
+                    });
+
+        std::vector<Position::Pose> poses(agents);
+        _runner.run("trajset/pose_at/500x1000", [&]()
+                    {
+                        for (int t = 0; t < 1000; ++t)
+                        {
+                            std::size_t i = 0;
+                            for (const auto &[name, traj] : trajSet)
+                                poses[i++] = traj.poseAt(Time::TimePoint(t * 0.2));
+                        }
+                        sink = sink + static_cast<std::size_t>(poses.front().component_.x);
+                    });
+
+        _runner.run("trajset/sampler/500x1000", [&]()
+                    {
+                        Traj::TrajSampler sampler(trajSet);
+                        for (int t = 0; t < 1000; ++t)
+                            sampler.sample(Time::TimePoint(t * 0.2), poses);
+                        sink = sink + static_cast<std::size_t>(poses.front().component_.x);
+                    });
+
+        _runner.run("trajset/encode/500x200", [&]()
+                    { sink = sink + Traj::TrajCodec::encode(trajSet).size(); });
+    }
+
+    // One planning episode: every search branch keeps its trajectory and
+    // time lines until the episode ends, as a CBS constraint tree does
+    template <typename SingleTraj, typename TimeLine, typename Allocator>
+    std::size_t planningEpisode(const Allocator &_allocator,
+                                const std::vector<std::pair<Time::TimePoint, Time::TimePoint>> &_intervals)
+    {
+        constexpr std::size_t branches = 256;
+        constexpr std::size_t cells = 64;
+        constexpr std::size_t reservations = 8;
+
+        std::vector<SingleTraj, typename std::allocator_traits<Allocator>::template rebind_alloc<SingleTraj>> trajs(_allocator);
+        std::vector<TimeLine, typename std::allocator_traits<Allocator>::template rebind_alloc<TimeLine>> timeLines(_allocator);
+        std::size_t work = 0;
+        for (std::size_t branch = 0; branch < branches; ++branch)
+        {
+            SingleTraj &traj = trajs.emplace_back(_allocator);
+            for (std::size_t i = 0; i < cells; ++i)
+                traj.nodes_.emplace_back();
+
+            for (std::size_t i = 0; i < cells; ++i)
+            {
+                TimeLine &timeLine = timeLines.emplace_back(Position::Index(), false, _allocator);
+                for (std::size_t j = 0; j < reservations; ++j)
+                {
+                    const auto &interval = _intervals[(i * reservations + j + branch) % _intervals.size()];
+                    timeLine.insertReservation(interval.first, interval.second);
+                }
+                work += timeLine.interval_list_.size();
+            }
+            work += traj.nodes_.size();
+        }
+
+        return work;
+    }
+
+    void benchmarkEpisode(Runner &_runner)
+    {
+        std::mt19937_64 rng(19);
+        std::uniform_real_distribution<double> start(0.0, 100.0);
+        std::uniform_real_distribution<double> duration(0.1, 3.0);
+        std::vector<std::pair<Time::TimePoint, Time::TimePoint>> intervals;
+        for (int i = 0; i < 4096; ++i)
+        {
+            const double begin = start(rng);
+            intervals.emplace_back(Time::TimePoint(begin), Time::TimePoint(begin + duration(rng)));
+        }
+
+        _runner.run("episode/heap/256x64", [&]()
+                    { sink = sink + planningEpisode<Traj::SingleTraj, Time::TimeLine>(std::allocator<std::pair<Traj::Node, Traj::Node>>(), intervals); });
+
+        MAPF_Util::EpisodeArena arena;
+        _runner.run("episode/arena/256x64", [&]()
+                    {
+                        sink = sink + planningEpisode<Traj::pmr::SingleTraj, Time::pmr::TimeLine>(
+                                          std::pmr::polymorphic_allocator<std::pair<Traj::Node, Traj::Node>>(&arena), intervals);
+                        arena.reset();
+                    });
+    }
+
+    void printUsage(const char *_program)
+    {
+        std::cout << "Usage: " << _program << " [options]" << std::endl
+                  << "  --json <path>       Write results as JSON" << std::endl
+                  << "  --baseline <path>   Compare against a JSON result file; exits 1 on regression" << std::endl
+                  << "  --tolerance <ratio> Allowed slowdown against the baseline (default 0.15)" << std::endl
+                  << "  --filter <text>     Only run benchmarks whose name contains <text>" << std::endl
+                  << "  --min-time <sec>    Minimum measuring time per benchmark (default 0.2)" << std::endl
+                  << "  --max-size <cells>  Largest synthetic map side (default 8000)" << std::endl;
+    }
+} // namespace Benchmark
+
+int main(int argc, char **argv)
+{
+    Benchmark::Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--json" and hasValue)
+            options.json_path_ = argv[++i];
+        else if (arg == "--baseline" and hasValue)
+            options.baseline_path_ = argv[++i];
+        else if (arg == "--tolerance" and hasValue)
+            options.tolerance_ = std::stod(argv[++i]);
+        else if (arg == "--filter" and hasValue)
+            options.filter_ = argv[++i];
+        else if (arg == "--min-time" and hasValue)
+            options.min_time_ = std::stod(argv[++i]);
+        else if (arg == "--max-size" and hasValue)
+            options.max_size_ = std::stoi(argv[++i]);
+        else
+        {
+            Benchmark::printUsage(argv[0]);
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+
+    // Read the baseline first so a bad path fails before minutes of measuring
+    std::map<std::string, double> baseline;
+    if (not(options.baseline_path_.empty()) and not(Benchmark::Runner::readJson(options.baseline_path_, baseline)))
+        return 2;
+
+    Benchmark::Runner runner(options);
+    Benchmark::benchmarkGeometry(runner);
+    Benchmark::benchmarkTimeLine(runner);
+    Benchmark::benchmarkTrajSet(runner);
+    Benchmark::benchmarkEpisode(runner);
+    Benchmark::benchmarkMaps(runner, options);
+
+    if (not(options.json_path_.empty()) and not(runner.writeJson(options.json_path_)))
+        return 2;
+
+    if (not(options.baseline_path_.empty()))
+    {
+        const std::size_t regressions = runner.compare(baseline);
+        if (regressions > 0)
+        {
+            std::cerr << "[Error] " << regressions << " benchmark(s) regressed beyond tolerance" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <optional>
+
+#include "multibot_util/Instance.hpp"
+
+namespace Instance
+{
+    namespace AgentInstance
+    {
+        struct Conflict
+        {
+            std::string first_agent_;
+            std::string second_agent_;
+            Time::TimePoint time_;
+            Position::Coordinates first_coord_;
+            Position::Coordinates second_coord_;
+
+            friend std::ostream &operator<<(std::ostream &_os, const Conflict &_conflict)
+            {
+                _os << "[" << _conflict.first_agent_ << " x " << _conflict.second_agent_ << "] "
+                    << _conflict.time_.count() << "s: "
+                    << _conflict.first_coord_ << " / " << _conflict.second_coord_;
+
+                return _os;
+            }
+        }; // struct Conflict
+
+        // Continuous-time collision check between agents modelled as discs of
+        // Agent::size_ moving at constant velocity along their SingleTraj nodes.
+        // Runs of a few constant-velocity pieces are hashed into a uniform grid
+        // by their padded bounding boxes; only agents whose boxes overlap in a
+        // shared cell during overlapping time windows are tested exactly, in
+        // parallel.
+        class ConflictDetector
+        {
+        public:
+            void setAgents(const std::vector<Agent> &_agents);
+            void setRadius(const std::string &_agentName, const double &_radius);
+            void setParkAtGoal(bool _park_at_goal) { park_at_goal_ = _park_at_goal; }
+
+            std::optional<Conflict> findFirstConflict(const Traj::TrajSet &_trajSet) const;
+            // Earliest conflict of every colliding pair, ordered by time
+            std::vector<Conflict> findConflicts(const Traj::TrajSet &_trajSet) const;
+
+        private:
+            // Constant velocity motion over [startTime_, endTime_)
+            struct Piece
+            {
+                double startTime_, endTime_;
+                double x_, y_;
+                double vx_, vy_;
+            }; // struct Piece
+
+            struct Track
+            {
+                const std::string *agentName_;
+                double radius_;
+                std::vector<Piece> pieces_;
+            }; // struct Track
+
+            std::vector<Track> buildTracks(const Traj::TrajSet &_trajSet) const;
+            std::vector<std::pair<std::size_t, std::size_t>> candidatePairs(const std::vector<Track> &_tracks) const;
+            static std::optional<double> earliestContact(const Track &_first, const Track &_second, double _horizon);
+            static Position::Coordinates locate(const Track &_track, double _time);
+
+        private:
+            std::map<std::string, double> radii_;
+            bool park_at_goal_ = true;
+
+        public:
+            ConflictDetector() {}
+            ConflictDetector(const std::vector<Agent> &_agents, bool _park_at_goal = true)
+                : park_at_goal_(_park_at_goal)
+            {
+                setAgents(_agents);
+            }
+        }; // class ConflictDetector
+    } // namespace AgentInstance
+} // namespace Instance
\ No newline at end of file
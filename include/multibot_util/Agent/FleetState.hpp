@@ -0,0 +1,48 @@
+#pragma once
+
+#include <span>
+
+#include "multibot_util/Instance.hpp"
+
+namespace Instance
+{
+    namespace AgentInstance
+    {
+        // Kinematic state of a fleet as structure-of-arrays, one entry per
+        // agent in insertion order. The batch kernels are plain loops over
+        // contiguous arrays so the compiler can vectorize them.
+        class FleetState
+        {
+        public:
+            std::size_t add(const Agent &_agent);
+            void assign(const std::vector<Agent> &_agents);
+            // Copies pose_, linVel_ and angVel_ back into agents in the same order
+            void writeBack(std::vector<Agent> &_agents) const;
+            void clear();
+
+            // Velocities move toward the commands within the acceleration limits
+            // over _dt, then are clamped to the velocity limits
+            void applyCommands(std::span<const double> _linVel, std::span<const double> _angVel, double _dt);
+            // Unicycle integration of the current velocities over _dt
+            void integrate(double _dt);
+            void distanceToGoal(std::span<double> _distances) const;
+
+            std::size_t size() const { return x_.size(); }
+            Position::Pose pose(std::size_t _i) const { return Position::Pose(x_[_i], y_[_i], theta_[_i]); }
+
+        public:
+            std::vector<double> x_, y_, theta_;
+            std::vector<double> lin_vel_, ang_vel_;
+            std::vector<double> goal_x_, goal_y_;
+            std::vector<double> max_lin_vel_, max_lin_acc_;
+            std::vector<double> max_ang_vel_, max_ang_acc_;
+
+        public:
+            FleetState() {}
+            FleetState(const std::vector<Agent> &_agents)
+            {
+                assign(_agents);
+            }
+        }; // class FleetState
+    } // namespace AgentInstance
+} // namespace Instance
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <span>
+#include <unordered_map>
+
+#include "multibot_util/Instance.hpp"
+
+namespace Instance
+{
+    namespace AgentInstance
+    {
+        // Rest-to-rest timing for one set of velocity and acceleration limits.
+        // Moves are rotate-then-translate: turn in place towards the target,
+        // drive straight, then turn to the target heading. Each motion follows
+        // a trapezoidal profile, or a triangular one when it is too short to
+        // reach the velocity limit.
+        class MotionProfile
+        {
+        public:
+            double translationTime(double _distance) const
+            {
+                if (_distance >= lin_ramp_distance_)
+                    return _distance * inverse_lin_vel_ + lin_ramp_time_;
+                return 2.0 * std::sqrt(_distance * inverse_lin_acc_);
+            }
+
+            double rotationTime(double _angle) const
+            {
+                if (_angle >= ang_ramp_angle_)
+                    return _angle * inverse_ang_vel_ + ang_ramp_time_;
+                return 2.0 * std::sqrt(_angle * inverse_ang_acc_);
+            }
+
+            // Time spent turning in place before departing, and time from
+            // departure until the move ends at _to (drive plus final turn)
+            std::pair<double, double> moveTime(const Position::Pose &_from, const Position::Pose &_to) const;
+            double edgeTime(const Position::Pose &_from, const Position::Pose &_to) const
+            {
+                const auto [turn, drive] = moveTime(_from, _to);
+                return turn + drive;
+            }
+
+            // Precomputed 8-connected grid steps: turning by _turn * 45 degrees
+            // then moving one straight or diagonal cell
+            double gridStepTime(int _turn, bool _diagonal) const { return grid_step_time_[_diagonal][_turn & 7]; }
+            void precomputeGrid(double _resolution);
+
+            double maxLinVel() const { return max_lin_vel_; }
+            double maxLinAcc() const { return max_lin_acc_; }
+            double maxAngVel() const { return max_ang_vel_; }
+            double maxAngAcc() const { return max_ang_acc_; }
+
+        private:
+            double max_lin_vel_, max_lin_acc_;
+            double max_ang_vel_, max_ang_acc_;
+
+            // Distance (angle) needed to reach the velocity limit and back, and
+            // the extra time a trapezoid spends accelerating compared to cruising
+            double lin_ramp_distance_, lin_ramp_time_;
+            double ang_ramp_angle_, ang_ramp_time_;
+            double inverse_lin_vel_, inverse_lin_acc_;
+            double inverse_ang_vel_, inverse_ang_acc_;
+
+            double grid_step_time_[2][8] = {};
+
+        public:
+            MotionProfile(double _max_lin_vel = 1.0, double _max_lin_acc = 1.0,
+                          double _max_ang_vel = 1.0, double _max_ang_acc = 1.0);
+            MotionProfile(const Agent &_agent)
+                : MotionProfile(_agent.max_linVel_, _agent.max_linAcc_, _agent.max_angVel_, _agent.max_angAcc_) {}
+        }; // class MotionProfile
+
+        // One MotionProfile per Agent::type_, built once and looked up by type
+        // or by a dense profile ID
+        class ProfileTable
+        {
+        public:
+            std::size_t add(const Agent &_agent);
+            void assign(const std::vector<Agent> &_agents);
+            void precomputeGrid(double _resolution);
+
+            std::size_t profileId(const std::string &_type) const;
+            const MotionProfile &profile(std::size_t _id) const { return profiles_[_id]; }
+            const MotionProfile &profile(const std::string &_type) const { return profiles_[profileId(_type)]; }
+            std::size_t size() const { return profiles_.size(); }
+
+        private:
+            std::vector<MotionProfile> profiles_;
+            std::unordered_map<std::string, std::size_t> ids_;
+
+        public:
+            ProfileTable() {}
+            ProfileTable(const std::vector<Agent> &_agents)
+            {
+                assign(_agents);
+            }
+        }; // class ProfileTable
+
+        namespace MotionTiming
+        {
+            // Times a pose sequence into node pairs starting at _startTime. Each
+            // pair departs after the initial rotation and arrives after the
+            // translation and final rotation; cost_ is the total duration.
+            Traj::SingleTraj timeTrajectory(const std::string &_agentName, const std::vector<Position::Pose> &_poses,
+                                            const MotionProfile &_profile,
+                                            Time::TimePoint _startTime = Time::TimePoint(0));
+
+            // Edge times of many candidate moves at once, e.g. all successors of a search node
+            void edgeTimes(const MotionProfile &_profile, const Position::Pose &_from,
+                           std::span<const Position::Pose> _to, std::span<double> _times);
+            void edgeTimes(const MotionProfile &_profile, std::span<const Position::Pose> _from,
+                           std::span<const Position::Pose> _to, std::span<double> _times);
+        } // namespace MotionTiming
+    } // namespace AgentInstance
+} // namespace Instance
\ No newline at end of file
@@ -3,6 +3,10 @@
 #include <queue>
 
 #include "multibot_util/MAPF_Util.hpp"
+#include "multibot_util/Map/BitGrid.hpp"
+#include "multibot_util/Map/ClearanceField.hpp"
+#include "multibot_util/Map/DistanceField.hpp"
+#include "multibot_util/Map/InflatedView.hpp"
 
 using namespace MAPF_Util;
 
@@ -60,46 +64,69 @@ namespace Instance
             Position::Index idx_;
             Position::Coordinates coord_;
             bool occupied_;
-
-        private:
-            double distance_;
-            Position::Coordinates obstacle_coord_;
-            friend class BinaryOccupancyMap;
             
         public:
-            Cell &operator=(const Cell &_other)
-            {
-                coord_          = _other.coord_;
-                idx_            = _other.idx_;
-                occupied_       = _other.occupied_;
-                obstacle_coord_ = _other.obstacle_coord_;
-
-                return *this;
-            }
-
             friend std::ostream &operator<<(std::ostream &_os, const Cell &_cell)
             {
                 _os << _cell.coord_ << ": " << _cell.occupied_;
 
                 return _os;
             }
-
-            // For priority queue
-            friend bool operator<(const Cell &_first, const Cell &_second)
-            {
-                return _first.distance_ > _second.distance_;
-            }
         
         public:
-            Cell() {}
-            Cell(const Cell& _other)
+            constexpr Cell() {}
+            constexpr Cell(Position::Index _idx, Position::Coordinates _coord, bool _occupied)
+                : idx_(_idx), coord_(_coord), occupied_(_occupied) {}
+        }; // struct Cell
+        static_assert(std::is_trivially_copyable_v<Cell> and std::is_standard_layout_v<Cell>);
+
+        enum InflationMode
+        {
+            BRUSHFIRE,
+            EDT
+        }; // enum InflationMode
+
+        // Scratch state of one BinaryOccupancyMap::getInflatedArea() call.
+        // Visited marks are stamped with a per-call epoch over the query's
+        // bounding box, so a call never clears them. Reusable across calls and
+        // maps, but used by one thread at a time.
+        class InflationWorkspace
+        {
+        private:
+            struct InflationEntry
             {
-                coord_          = _other.coord_;
-                idx_            = _other.idx_;
-                occupied_       = _other.occupied_;
-                obstacle_coord_ = _other.obstacle_coord_;
+                double distance_;
+                Position::Index idx_;
+                Position::Index obstacle_idx_;
+
+                // For the min-heap
+                friend bool operator<(const InflationEntry &_first, const InflationEntry &_second)
+                {
+                    return _first.distance_ > _second.distance_;
+                }
+            }; // struct InflationEntry
+
+            void begin(int _x, int _y, int _width, int _height);
+            bool visit(const Position::Index &_idx)
+            {
+                std::uint16_t &stamp = stamps_[static_cast<std::size_t>(_idx.y_ - origin_y_) * width_ + (_idx.x_ - origin_x_)];
+                if (stamp == epoch_)
+                    return false;
+                stamp = epoch_;
+                return true;
             }
-        }; // struct Cell
+
+            std::vector<std::uint16_t> stamps_;
+            std::uint16_t epoch_ = 0;
+            int origin_x_ = 0, origin_y_ = 0;
+            int width_ = 0;
+            std::vector<InflationEntry> queue_;
+
+            friend class BinaryOccupancyMap;
+
+        public:
+            InflationWorkspace() {}
+        }; // class InflationWorkspace
 
         class BinaryOccupancyMap
         {
@@ -111,17 +138,6 @@ namespace Instance
                 double resolution_;
                 double inflation_radius_;
 
-                MapProperty &operator=(const MapProperty &_other)
-                {
-                    this->origin_           = _other.origin_;
-                    this->width_            = _other.width_;
-                    this->height_           = _other.height_;
-                    this->resolution_       = _other.resolution_;
-                    this->inflation_radius_ = _other.inflation_radius_;
-
-                    return *this;
-                }
-
                 friend std::ostream &operator<<(std::ostream &_os, const MapProperty &_mapProperty)
                 {
                     _os << "- Map Property"     << std::endl;
@@ -133,15 +149,6 @@ namespace Instance
                     return _os;
                 }
 
-                MapProperty(const MapProperty &_other)
-                {
-                    this->origin_           = _other.origin_;
-                    this->width_            = _other.width_;
-                    this->height_           = _other.height_;
-                    this->resolution_       = _other.resolution_;
-                    this->inflation_radius_ = _other.inflation_radius_;
-                }
-
                 MapProperty()
                 {
                     this->origin_           = Position::Coordinates();
@@ -154,28 +161,111 @@ namespace Instance
 
         public:
             BinaryOccupancyMap &operator=(const BinaryOccupancyMap &_other);
+            void initialize(const MapProperty &_property);
+            // Cells within _inflation_radius of the root area, nearest first.
+            // Const and reentrant: scratch state lives in _workspace, or in a
+            // thread-local workspace for the overload without one.
             std::vector<Position::Index> getInflatedArea(const std::vector<Position::Index> &_rootArea,
-                                                         const double &_inflation_radius);
-            std::vector<std::vector<Cell>> inflate(const double &_inflation_radius);
+                                                         const double &_inflation_radius) const;
+            std::vector<Position::Index> getInflatedArea(const std::vector<Position::Index> &_rootArea,
+                                                         const double &_inflation_radius,
+                                                         InflationWorkspace &_workspace) const;
+            // Same, with the result allocated from _resource (e.g. an EpisodeArena)
+            std::pmr::vector<Position::Index> getInflatedArea(const std::vector<Position::Index> &_rootArea,
+                                                              const double &_inflation_radius,
+                                                              InflationWorkspace &_workspace,
+                                                              std::pmr::memory_resource *_resource) const;
+            // Expands every root area in parallel; result i belongs to _rootAreas[i]
+            std::vector<std::vector<Position::Index>> getInflatedAreas(const std::vector<std::vector<Position::Index>> &_rootAreas,
+                                                                       const double &_inflation_radius) const;
+            const BitGrid &inflate(const double &_inflation_radius, InflationMode _mode = InflationMode::EDT);
+            const InflatedView &inflatedView(const double &_inflation_radius);
+            // Built on first use and kept up to date by markOccupied()/markFree()
+            const ClearanceField &clearanceField();
+            void computeDistanceField();
+            void setDistanceField(const DistanceField &_distance_field);
+            std::vector<Position::Index> markOccupied(const Position::Index &_idx);
+            std::vector<Position::Index> markFree(const Position::Index &_idx);
             bool isOutofMap(const Cell &_cell) const;
-        
+            bool isOutofMap(const Position::Index &_idx) const;
+
+        public:
+            Cell cell(const Position::Index &_idx) const
+            {
+                return Cell(_idx, getCoordinates(_idx), mapData_.get(_idx.x_, _idx.y_));
+            }
+
+            Cell inflatedCell(const Position::Index &_idx) const
+            {
+                return Cell(_idx, getCoordinates(_idx), inflated_mapData_.get(_idx.x_, _idx.y_));
+            }
+
+            bool hasDistanceField() const
+            {
+                return not(distance_field_dirty_) and not(distance_field_.empty());
+            }
+
+            bool isOccupied(const Position::Index &_idx) const
+            {
+                return mapData_.get(_idx.x_, _idx.y_);
+            }
+
+            bool isInflated(const Position::Index &_idx) const
+            {
+                return inflated_mapData_.get(_idx.x_, _idx.y_);
+            }
+
+            void setOccupied(const Position::Index &_idx, bool _occupied)
+            {
+                mapData_.set(_idx.x_, _idx.y_, _occupied);
+                distance_field_dirty_ = true;
+            }
+
+            Position::Coordinates getCoordinates(const Position::Index &_idx) const
+            {
+                return Position::Coordinates(property_.origin_.x_ + _idx.x_ * property_.resolution_,
+                                             property_.origin_.y_ + _idx.y_ * property_.resolution_);
+            }
+
+            Position::Index getIndex(const Position::Coordinates &_coord) const
+            {
+                return Position::Index(static_cast<int>(std::lround((_coord.x_ - property_.origin_.x_) / property_.resolution_)),
+                                       static_cast<int>(std::lround((_coord.y_ - property_.origin_.y_) / property_.resolution_)));
+            }
+
         private:
-            double distanceLookup(const Cell &_cell) const;
-            void enqueue(const Instance::MapInstance::Cell &_cell, const double &_inflation_radius);
+            template <typename IndexList>
+            void collectInflatedArea(const std::vector<Position::Index> &_rootArea, const double &_inflation_radius,
+                                     InflationWorkspace &_workspace, IndexList &_inflatedArea) const;
+            double distanceLookup(const Position::Index &_idx, const Position::Index &_obstacle_idx) const;
+            void enqueue(InflationWorkspace &_workspace, const Position::Index &_idx, const Position::Index &_obstacle_idx,
+                         const double &_inflation_radius) const;
+            std::uint32_t inflationThreshold(const double &_inflation_radius) const;
+            std::vector<Position::Index> repairInflation();
         
         public:
             MapProperty property_;
-            std::vector<std::vector<Cell>> mapData_;
-            std::vector<std::vector<Cell>> inflated_mapData_;
+            // Direct writes to mapData_ must be followed by computeDistanceField()
+            BitGrid mapData_;
+            BitGrid inflated_mapData_;
+            DistanceField distance_field_;
         
         private:
-            std::vector<std::vector<bool>> seen_;
-            std::priority_queue<Cell> inflation_queue_;
+            // Keyed on inflationThreshold(), which alone determines a view
+            std::map<std::uint32_t, InflatedView> inflated_views_;
+            bool distance_field_dirty_ = true;
+            ClearanceField clearance_field_;
+            bool clearance_field_dirty_ = true;
         
         public:
             BinaryOccupancyMap() {}
+            BinaryOccupancyMap(const BinaryOccupancyMap &_other)
+            {
+                *this = _other;
+            }
         }; // class BinaryOccupancyMap
 
         double getDistance(const Cell &_first, const Cell &_second);
+        std::uint32_t getInflationThreshold(const double &_inflation_radius, const double &_resolution);
     } // namespace MapInstance
 } // namespace Instance
\ No newline at end of file
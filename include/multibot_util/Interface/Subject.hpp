@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "multibot_util/Interface/Observer_Interface.hpp"
+#include "multibot_util/Util/Profiler.hpp"
+
+namespace Observer
+{
+    enum DispatchMode
+    {
+        SYNC,
+        ASYNC
+    }; // enum DispatchMode
+
+    // Subject that keeps its observers in an immutable list swapped in
+    // atomically on attach/detach, so notify() never waits on attach/detach
+    // or on other publishers. It is not lock-free: libstdc++ guards every
+    // atomic shared_ptr load and store with a short internal lock. SYNC
+    // observers are updated on the publishing thread. ASYNC observers get a
+    // one-slot mailbox drained by their own thread: a newer message replaces
+    // one not yet delivered, so a slow observer never stalls the publisher.
+    // detach() returns only once the observer is no longer being updated.
+    template <typename Msg>
+    class Subject : public SubjectInterface<Msg>
+    {
+    public:
+        void attach(ObserverInterface<Msg> &_observer) override
+        {
+            attach(_observer, DispatchMode::SYNC);
+        }
+
+        void attach(ObserverInterface<Msg> &_observer, DispatchMode _mode)
+        {
+            std::lock_guard<std::mutex> lock(this->mtx_);
+            const auto current = subscriptions_.load();
+            if (find(*current, _observer) != current->end())
+                return;
+
+            auto subscription = std::make_shared<Subscription>(&_observer, _mode);
+            if (_mode == DispatchMode::ASYNC)
+                subscription->worker_ = std::thread([subscription]()
+                                                    { drain(*subscription); });
+
+            auto next = std::make_shared<SubscriptionList>(*current);
+            next->push_back(std::move(subscription));
+            subscriptions_.store(std::move(next));
+        }
+
+        void detach(ObserverInterface<Msg> &_observer) override
+        {
+            std::shared_ptr<Subscription> subscription;
+            {
+                std::lock_guard<std::mutex> lock(this->mtx_);
+                const auto current = subscriptions_.load();
+                const auto found = find(*current, _observer);
+                if (found == current->end())
+                    return;
+
+                subscription = *found;
+                auto next = std::make_shared<SubscriptionList>(*current);
+                next->erase(next->begin() + (found - current->begin()));
+                subscriptions_.store(std::move(next));
+            }
+
+            release(subscription);
+        }
+
+        // Delivers the latest published message to every observer
+        void notify() override
+        {
+            const std::shared_ptr<const Msg> message = message_.load();
+            if (not(message))
+                return;
+
+            MULTIBOT_PROFILE_SCOPE("Subject::notify");
+            const auto subscriptions = subscriptions_.load();
+            MULTIBOT_PROFILE_HISTOGRAM("Subject::notify observers", subscriptions->size());
+            for (const auto &subscription : *subscriptions)
+            {
+                if (subscription->mode_ == DispatchMode::ASYNC)
+                {
+                    subscription->mailbox_.store(message);
+                    subscription->sequence_.fetch_add(1);
+                    subscription->sequence_.notify_one();
+                    continue;
+                }
+
+                // Pairs with release(): either we see detached_ or it sees active_
+                subscription->active_.fetch_add(1);
+                if (not subscription->detached_.load())
+                {
+                    const Subscription *outer = delivering_;
+                    delivering_ = subscription.get();
+                    subscription->observer_->update(*message);
+                    delivering_ = outer;
+                }
+                if (subscription->active_.fetch_sub(1) == 1)
+                    subscription->active_.notify_all();
+            }
+        }
+
+        void publish(const Msg &_msg)
+        {
+            publish(std::make_shared<const Msg>(_msg));
+        }
+
+        void publish(std::shared_ptr<const Msg> _msg)
+        {
+            message_.store(std::move(_msg));
+            notify();
+        }
+
+        std::shared_ptr<const Msg> message() const { return message_.load(); }
+        std::size_t observerCount() const { return subscriptions_.load()->size(); }
+
+    private:
+        struct Subscription
+        {
+            ObserverInterface<Msg> *observer_;
+            DispatchMode mode_;
+
+            std::atomic<int> active_{0};
+            std::atomic<bool> detached_{false};
+
+            std::atomic<std::shared_ptr<const Msg>> mailbox_;
+            std::atomic<std::uint64_t> sequence_{0};
+            std::thread worker_;
+
+            Subscription(ObserverInterface<Msg> *_observer, DispatchMode _mode)
+                : observer_(_observer), mode_(_mode) {}
+        }; // struct Subscription
+
+        typedef std::vector<std::shared_ptr<Subscription>> SubscriptionList;
+
+        static typename SubscriptionList::const_iterator find(const SubscriptionList &_subscriptions,
+                                                              const ObserverInterface<Msg> &_observer)
+        {
+            return std::find_if(_subscriptions.begin(), _subscriptions.end(),
+                                [&_observer](const std::shared_ptr<Subscription> &_subscription)
+                                { return _subscription->observer_ == &_observer; });
+        }
+
+        static void drain(Subscription &_subscription)
+        {
+            std::uint64_t seen = 0;
+            while (true)
+            {
+                _subscription.sequence_.wait(seen);
+                seen = _subscription.sequence_.load();
+                if (_subscription.detached_.load())
+                    return;
+
+                const std::shared_ptr<const Msg> message = _subscription.mailbox_.exchange(nullptr);
+                if (message)
+                    _subscription.observer_->update(*message);
+            }
+        }
+
+        static void release(const std::shared_ptr<Subscription> &_subscription)
+        {
+            _subscription->detached_.store(true);
+
+            if (_subscription->mode_ == DispatchMode::ASYNC)
+            {
+                _subscription->sequence_.fetch_add(1);
+                _subscription->sequence_.notify_one();
+
+                // An observer detaching itself from its own update cannot join its thread
+                if (_subscription->worker_.get_id() == std::this_thread::get_id())
+                    _subscription->worker_.detach();
+                else
+                    _subscription->worker_.join();
+                return;
+            }
+
+            if (delivering_ == _subscription.get())
+                return;
+
+            for (int active = _subscription->active_.load(); active != 0; active = _subscription->active_.load())
+                _subscription->active_.wait(active);
+        }
+
+    private:
+        std::atomic<std::shared_ptr<const SubscriptionList>> subscriptions_{std::make_shared<const SubscriptionList>()};
+        std::atomic<std::shared_ptr<const Msg>> message_;
+
+        static inline thread_local const Subscription *delivering_ = nullptr;
+
+    public:
+        Subject() {}
+        Subject(const Subject &) = delete;
+        Subject &operator=(const Subject &) = delete;
+
+        ~Subject()
+        {
+            std::shared_ptr<const SubscriptionList> subscriptions;
+            {
+                std::lock_guard<std::mutex> lock(this->mtx_);
+                subscriptions = subscriptions_.exchange(std::make_shared<const SubscriptionList>());
+            }
+
+            for (const auto &subscription : *subscriptions)
+                release(subscription);
+        }
+    }; // class Subject
+} // namespace Observer
\ No newline at end of file
@@ -5,8 +5,18 @@
 #include <cmath>
 #include <list>
 #include <map>
-
-#include <geometry_msgs/msg/pose2_d.hpp>
+#include <algorithm>
+#include <concepts>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "multibot_util/Util/Profiler.hpp"
+#include "multibot_util/Util/SmallVector.hpp"
 
 namespace MAPF_Util
 {
@@ -18,20 +28,12 @@ namespace MAPF_Util
         {
             int x_, y_;
 
-            Index &operator=(const Index &_other)
-            {
-                x_  = _other.x_;
-                y_  = _other.y_;
-
-                return *this;
-            }
-
-            bool operator==(const Index &_other) const
+            constexpr bool operator==(const Index &_other) const
             {
                 return (x_ == _other.x_ and y_ == _other.y_);
             }
 
-            bool operator!=(const Index &_other) const
+            constexpr bool operator!=(const Index &_other) const
             {
                 return not(*this == _other);
             }
@@ -42,13 +44,7 @@ namespace MAPF_Util
                            << "[" << _index.y_ << "]";
             }
 
-            Index(const Index &_other)
-            {
-                x_  = _other.x_;
-                y_  = _other.y_;
-            }
-
-            Index(int _x = -1, int _y = -1)
+            constexpr Index(int _x = -1, int _y = -1)
                 : x_(_x), y_(_y) {}
         }; // struct Index
 
@@ -56,7 +52,6 @@ namespace MAPF_Util
         {
             double x_, y_;
 
-            Coordinates &operator=(const Coordinates &_other);
             Coordinates &operator=(const std::vector<double> &_other);
             Coordinates &operator=(const std::pair<double, double> &_other);
 
@@ -87,33 +82,67 @@ namespace MAPF_Util
                            << ", "  << _coordinates.y_ << "m" << ")";
             }
 
-            Coordinates(const Coordinates &_other)
-            {
-                x_  = _other.x_;
-                y_  = _other.y_;
-            }
-
-            Coordinates(double _x = std::numeric_limits<double>::quiet_NaN(), double _y = std::numeric_limits<double>::quiet_NaN())
+            constexpr Coordinates(double _x = std::numeric_limits<double>::quiet_NaN(), double _y = std::numeric_limits<double>::quiet_NaN())
                 : x_(_x), y_(_y) {};
         }; // struct Coordinates
 
-        struct Pose
+        // Any message with x, y and theta fields, e.g. geometry_msgs::msg::Pose2D
+        template <typename Msg>
+        concept Pose2DMessage = requires(const Msg &_msg) {
+            { _msg.x } -> std::convertible_to<double>;
+            { _msg.y } -> std::convertible_to<double>;
+            { _msg.theta } -> std::convertible_to<double>;
+        };
+
+        // ROS-free mirror of geometry_msgs::msg::Pose2D with the same field
+        // names. Converts implicitly to and from such messages.
+        struct Pose2D
         {
-            geometry_msgs::msg::Pose2D component_;
+            double x = 0.0;
+            double y = 0.0;
+            double theta = 0.0;
 
-            Pose &operator=(const Pose &_other)
+            constexpr bool operator==(const Pose2D &_other) const
             {
-                component_  = _other.component_;
-                
-                return *this;
+                return x == _other.x and y == _other.y and theta == _other.theta;
+            }
+
+            constexpr bool operator!=(const Pose2D &_other) const
+            {
+                return not(*this == _other);
             }
 
-            bool operator==(const Pose &_other) const
+            template <Pose2DMessage Msg>
+                requires(not std::is_same_v<Msg, Pose2D>)
+            constexpr operator Msg() const
+            {
+                Msg msg;
+                msg.x = x;
+                msg.y = y;
+                msg.theta = theta;
+
+                return msg;
+            }
+
+            constexpr Pose2D() = default;
+            constexpr Pose2D(double _x, double _y, double _theta)
+                : x(_x), y(_y), theta(_theta) {}
+            template <Pose2DMessage Msg>
+                requires(not std::is_same_v<Msg, Pose2D>)
+            constexpr Pose2D(const Msg &_msg)
+                : x(_msg.x), y(_msg.y), theta(_msg.theta) {}
+        }; // struct Pose2D
+
+        struct Pose
+        {
+            Pose2D component_;
+
+            constexpr bool operator==(const Pose &_other) const
             {
                 return component_ == _other.component_;
             }
 
-            bool operator!=(const Pose &_other) const
+            constexpr bool operator!=(const Pose &_other) const
             {
                 return component_ != _other.component_;
             }
@@ -128,26 +157,34 @@ namespace MAPF_Util
                 return _os;
             }
 
-            Pose(const Pose &_other)
-            {
-                component_  = _other.component_;
-            }
-
-            Pose(geometry_msgs::msg::Pose2D _component = geometry_msgs::msg::Pose2D())
+            constexpr Pose(Pose2D _component = Pose2D())
                 : component_(_component) {}
 
-            Pose(double _x, double _y, double _theta)
-            {
-                component_.x        = _x;
-                component_.y        = _y;
-                component_.theta    = _theta;
-            }
+            constexpr Pose(double _x, double _y, double _theta)
+                : component_(_x, _y, _theta) {}
+            template <Pose2DMessage Msg>
+            constexpr Pose(const Msg &_msg)
+                : component_(_msg.x, _msg.y, _msg.theta) {}
         }; // struct Pose
 
         double getDistance(const Coordinates &_first, const Coordinates &_second);
         double crossProduct(const Coordinates &_first, const Coordinates &_second);
         double getDistance(const Pose &_first, const Pose &_second);
         double getAngleDiff(const Pose &_first, const Pose &_second);
+        // Wraps an angle into [-pi, pi] in constant time
+        double normalizeAngle(double _angle);
+
+        // Batch forms over contiguous arrays: output i is computed from input i
+        // of both arrays, or from input i and the single _target. Outputs must
+        // be at least as long as _first. Runs AVX2 kernels when the CPU has them
+        // and agrees with the scalar functions above to rounding.
+        void getDistances(std::span<const Coordinates> _first, std::span<const Coordinates> _second, std::span<double> _distances);
+        void getDistances(std::span<const Coordinates> _first, const Coordinates &_target, std::span<double> _distances);
+        void getDistances(std::span<const Pose> _first, std::span<const Pose> _second, std::span<double> _distances);
+        void getDistances(std::span<const Pose> _first, const Pose &_target, std::span<double> _distances);
+        void getAngleDiffs(std::span<const Pose> _first, std::span<const Pose> _second, std::span<double> _angleDiffs);
+        void getAngleDiffs(std::span<const Pose> _first, const Pose &_target, std::span<double> _angleDiffs);
+        void crossProducts(std::span<const Coordinates> _first, std::span<const Coordinates> _second, std::span<double> _products);
     } // namespace Position
 
     namespace Time
@@ -167,15 +204,6 @@ namespace MAPF_Util
                            << ")";
             }
 
-            TimeInterval &operator=(const TimeInterval &_other)
-            {
-                startTime_  = _other.startTime_;
-                endTime_    = _other.endTime_;
-                is_safe_    = _other.is_safe_;
-
-                return *this;
-            }
-
             bool operator==(const TimeInterval &_other) const
             {
                 if (std::fabs(startTime_.count() - _other.startTime_.count()) > 1e-8)
@@ -194,17 +222,35 @@ namespace MAPF_Util
                 return not(*this == _other);
             }
 
-            TimeInterval(TimePoint _startTime = TimePoint::max(), TimePoint _endTime = TimePoint::max(), bool _is_safe = false)
+            constexpr TimeInterval(TimePoint _startTime = TimePoint::max(), TimePoint _endTime = TimePoint::max(), bool _is_safe = false)
                 : startTime_(_startTime), endTime_(_endTime), is_safe_(_is_safe) {}
         }; // struct TimeInterval
 
-        struct TimeLine
+        // Sorted partition of [0, max) into alternating safe and collision
+        // intervals; never empty, an unreserved time line holds one safe
+        // [0, max). Intervals past the inline four come from Allocator.
+        template <typename Allocator = std::allocator<TimeInterval>>
+        struct BasicTimeLine
         {
+            typedef MAPF_Util::SmallVector<TimeInterval, 4, Allocator> IntervalList;
+
             Position::Index idx_;
-            std::list<TimeInterval> interval_list_;
+            IntervalList interval_list_;
             bool occupied_;
 
-            friend std::ostream &operator<<(std::ostream &_os, const TimeLine &_timeLine)
+            bool isSafe(const TimePoint &_time) const;
+            IntervalList::const_iterator findSafeInterval(const TimePoint &_time) const;
+            IntervalList::const_iterator findNextSafeInterval(const TimePoint &_time) const;
+            void insertReservation(const TimePoint &_startTime, const TimePoint &_endTime);
+            void removeReservation(const TimePoint &_startTime, const TimePoint &_endTime);
+            // Drops every reservation
+            void clear()
+            {
+                interval_list_.clear();
+                interval_list_.push_back(TimeInterval(TimePoint(0), TimePoint::max(), true));
+            }
+
+            friend std::ostream &operator<<(std::ostream &_os, const BasicTimeLine &_timeLine)
             {
                 _os << "TimeLine" << _timeLine.idx_ << std::endl;
                 for (const auto &TimeInterval : _timeLine.interval_list_)
@@ -219,57 +265,67 @@ namespace MAPF_Util
                 return _os;
             }
 
-            TimeLine &operator=(const TimeLine &_other)
+            BasicTimeLine(Position::Index _idx = Position::Index(), bool _occupied = false,
+                          const Allocator &_allocator = Allocator())
+                : idx_(_idx), interval_list_(_allocator), occupied_(_occupied)
             {
-                idx_            = _other.idx_;
-                interval_list_  = _other.interval_list_;
-                occupied_       = _other.occupied_;
-
-                return *this;
+                clear();
             }
 
-            TimeLine(Position::Index _idx = Position::Index(), bool _occupied = false)
-                : idx_(_idx), occupied_(_occupied)
+            // Copies across allocators, e.g. out of an episode arena
+            template <typename OtherAllocator>
+            explicit BasicTimeLine(const BasicTimeLine<OtherAllocator> &_other, const Allocator &_allocator = Allocator())
+                : idx_(_other.idx_), interval_list_(_allocator), occupied_(_other.occupied_)
             {
-                interval_list_.clear();
+                interval_list_.insert(interval_list_.end(), _other.interval_list_.begin(), _other.interval_list_.end());
             }
-        }; // struct TimeLine
+
+        private:
+            void assign(const TimePoint &_startTime, const TimePoint &_endTime, bool _is_safe);
+        }; // struct BasicTimeLine
+
+        typedef BasicTimeLine<> TimeLine;
+        extern template struct BasicTimeLine<std::allocator<TimeInterval>>;
+        extern template struct BasicTimeLine<std::pmr::polymorphic_allocator<TimeInterval>>;
+
+        namespace pmr
+        {
+            typedef BasicTimeLine<std::pmr::polymorphic_allocator<TimeInterval>> TimeLine;
+        } // namespace pmr
     } // namespace Time
 
     namespace Traj
     {
-        struct SingleTraj
+        struct Node
         {
-            struct Node
-            {
-                Position::Pose pose_;
-                Time::TimePoint arrival_time_;
-                Time::TimePoint departure_time_;
-
-                Node &operator=(const Node &_other)
-                {
-                    pose_           = _other.pose_;
-                    arrival_time_   = _other.arrival_time_;
-                    departure_time_ = _other.departure_time_;
-
-                    return *this;
-                }
-            }; // struct Node
+            Position::Pose pose_;
+            Time::TimePoint arrival_time_;
+            Time::TimePoint departure_time_;
+        }; // struct Node
+
+        // Nodes and the agent name come from Allocator. Every instantiation
+        // shares Traj::Node, so copying between them is a plain memory copy.
+        template <typename Allocator = std::allocator<std::pair<Node, Node>>>
+        struct BasicSingleTraj
+        {
+            typedef Traj::Node Node;
+            typedef std::basic_string<char, std::char_traits<char>,
+                                      typename std::allocator_traits<Allocator>::template rebind_alloc<char>> Name;
 
-            std::string agentName_;
-            std::vector<std::pair<SingleTraj::Node, SingleTraj::Node>> nodes_;
+            Name agentName_;
+            std::vector<std::pair<Node, Node>, Allocator> nodes_;
             double cost_;
 
-            SingleTraj &operator=(const SingleTraj &_other)
+            // Index of the node pair covering _time, found by binary search
+            std::size_t locate(const Time::TimePoint &_time) const;
+            // Pose at _time within nodes_[_pair], interpolating position and shortest-way heading
+            Position::Pose interpolate(std::size_t _pair, const Time::TimePoint &_time) const;
+            Position::Pose poseAt(const Time::TimePoint &_time) const
             {
-                agentName_  = _other.agentName_;
-                nodes_      = _other.nodes_;
-                cost_       = _other.cost_;
-
-                return *this;
+                return interpolate(locate(_time), _time);
             }
 
-            friend std::ostream &operator<<(std::ostream &_os, const SingleTraj &_singlePath)
+            friend std::ostream &operator<<(std::ostream &_os, const BasicSingleTraj &_singlePath)
             {
                 _os.precision(4);
                 _os << "[" << _singlePath.agentName_ << "] "
@@ -287,15 +343,33 @@ namespace MAPF_Util
                 return _os;                    
             }
 
-            SingleTraj() {}
-            SingleTraj(const SingleTraj &_other)
-            {
-                agentName_  = _other.agentName_;
-                nodes_      = _other.nodes_;
-                cost_       = _other.cost_;
-            }
-        }; // struct SingleTraj
+            BasicSingleTraj() {}
+            explicit BasicSingleTraj(const Allocator &_allocator)
+                : agentName_(_allocator), nodes_(_allocator) {}
+
+            // Copies across allocators, e.g. out of an episode arena
+            template <typename OtherAllocator>
+            explicit BasicSingleTraj(const BasicSingleTraj<OtherAllocator> &_other, const Allocator &_allocator = Allocator())
+                : agentName_(_other.agentName_.begin(), _other.agentName_.end(), _allocator),
+                  nodes_(_other.nodes_.begin(), _other.nodes_.end(), _allocator), cost_(_other.cost_) {}
+        }; // struct BasicSingleTraj
+
+        typedef BasicSingleTraj<> SingleTraj;
+        extern template struct BasicSingleTraj<std::allocator<std::pair<Node, Node>>>;
+        extern template struct BasicSingleTraj<std::pmr::polymorphic_allocator<std::pair<Node, Node>>>;
+
+        namespace pmr
+        {
+            typedef BasicSingleTraj<std::pmr::polymorphic_allocator<std::pair<Node, Node>>> SingleTraj;
+        } // namespace pmr
 
         typedef std::map<std::string, SingleTraj> TrajSet;
     } // namespace Traj
+
+    // Bulk copies, vector growth and serialization rely on these being plain memory
+    static_assert(std::is_trivially_copyable_v<Position::Index> and std::is_standard_layout_v<Position::Index>);
+    static_assert(std::is_trivially_copyable_v<Position::Coordinates> and std::is_standard_layout_v<Position::Coordinates>);
+    static_assert(std::is_trivially_copyable_v<Position::Pose> and std::is_standard_layout_v<Position::Pose>);
+    static_assert(std::is_trivially_copyable_v<Time::TimeInterval>);
+    static_assert(std::is_trivially_copyable_v<Traj::SingleTraj::Node> and std::is_standard_layout_v<Traj::SingleTraj::Node>);
 } // namespace MAPF_Util
\ No newline at end of file
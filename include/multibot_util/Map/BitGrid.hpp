@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace Instance
+{
+    namespace MapInstance
+    {
+        // Row-major, bit-packed grid. Every row starts on a word boundary and
+        // the padding bits past width_ are always kept cleared.
+        class BitGrid
+        {
+        public:
+            typedef std::uint64_t Word;
+            static constexpr int WORD_BITS = 64;
+
+        public:
+            bool get(int _x, int _y) const
+            {
+                return (words_[wordIndex(_x, _y)] >> bitOffset(_x)) & Word(1);
+            }
+
+            void set(int _x, int _y, bool _value)
+            {
+                Word &word = words_[wordIndex(_x, _y)];
+                const Word mask = Word(1) << bitOffset(_x);
+                word = _value ? (word | mask) : (word & ~mask);
+            }
+
+            void resize(int _width, int _height, bool _value = false)
+            {
+                width_          = _width;
+                height_         = _height;
+                words_per_row_  = (static_cast<std::size_t>(_width) + WORD_BITS - 1) / WORD_BITS;
+                words_.assign(words_per_row_ * static_cast<std::size_t>(_height), Word(0));
+                fill(_value);
+            }
+
+            void fill(bool _value)
+            {
+                std::fill(words_.begin(), words_.end(), _value ? ~Word(0) : Word(0));
+                if (_value)
+                    clearPadding();
+            }
+
+            std::size_t count() const
+            {
+                std::size_t count = 0;
+                for (const auto &word : words_)
+                    count += std::popcount(word);
+
+                return count;
+            }
+
+            template <typename Function>
+            void forEachSet(Function &&_function) const
+            {
+                for (int y = 0; y < height_; ++y)
+                {
+                    const Word *rowWords = row(y);
+                    for (std::size_t w = 0; w < words_per_row_; ++w)
+                    {
+                        Word word = rowWords[w];
+                        while (word)
+                        {
+                            const int x = static_cast<int>(w) * WORD_BITS + std::countr_zero(word);
+                            _function(x, y);
+                            word &= word - 1;
+                        }
+                    }
+                }
+            }
+
+            int width() const { return width_; }
+            int height() const { return height_; }
+            std::size_t wordsPerRow() const { return words_per_row_; }
+            std::size_t memoryUsage() const { return words_.size() * sizeof(Word); }
+
+            const Word *row(int _y) const { return words_.data() + static_cast<std::size_t>(_y) * words_per_row_; }
+            Word *row(int _y) { return words_.data() + static_cast<std::size_t>(_y) * words_per_row_; }
+
+            const std::vector<Word> &words() const { return words_; }
+            std::vector<Word> &words() { return words_; }
+
+            bool operator==(const BitGrid &_other) const
+            {
+                return width_ == _other.width_ and height_ == _other.height_ and words_ == _other.words_;
+            }
+
+            bool operator!=(const BitGrid &_other) const
+            {
+                return not(*this == _other);
+            }
+
+        private:
+            std::size_t wordIndex(int _x, int _y) const
+            {
+                return static_cast<std::size_t>(_y) * words_per_row_ + static_cast<std::size_t>(_x) / WORD_BITS;
+            }
+
+            static int bitOffset(int _x)
+            {
+                return _x & (WORD_BITS - 1);
+            }
+
+            void clearPadding()
+            {
+                const int tailBits = width_ % WORD_BITS;
+                if (tailBits == 0)
+                    return;
+
+                const Word tailMask = (Word(1) << tailBits) - 1;
+                for (int y = 0; y < height_; ++y)
+                    row(y)[words_per_row_ - 1] &= tailMask;
+            }
+
+        private:
+            int width_, height_;
+            std::size_t words_per_row_;
+            std::vector<Word> words_;
+
+        public:
+            BitGrid()
+                : width_(0), height_(0), words_per_row_(0) {}
+
+            BitGrid(int _width, int _height, bool _value = false)
+            {
+                resize(_width, _height, _value);
+            }
+        }; // class BitGrid
+    } // namespace MapInstance
+} // namespace Instance
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <span>
+
+#include "multibot_util/MAPF_Util.hpp"
+#include "multibot_util/Map/DistanceField.hpp"
+
+namespace Instance
+{
+    namespace MapInstance
+    {
+        // Distance in meters from every cell center to the nearest obstacle,
+        // as floats, with bilinear clearance and gradient at any coordinate.
+        // Coordinates outside the map, infinite ones included, are clamped to
+        // its border; a NaN coordinate yields a NaN clearance and gradient.
+        // Without any obstacle every cell holds maxClearance(), the map diagonal.
+        class ClearanceField
+        {
+        public:
+            void compute(const DistanceField &_field, const MAPF_Util::Position::Coordinates &_origin, double _resolution);
+            // Refreshes the cells reported by DistanceField::update()
+            void update(const DistanceField &_field, const std::vector<std::int32_t> &_changed);
+
+            float cellClearance(int _x, int _y) const
+            {
+                return clearance_[static_cast<std::size_t>(_y) * width_ + _x];
+            }
+
+            double clearance(const MAPF_Util::Position::Coordinates &_coord) const
+            {
+                const Sample sample = locate(_coord);
+                const double bottom = sample.c00_ + sample.tx_ * (sample.c10_ - sample.c00_);
+                const double top = sample.c01_ + sample.tx_ * (sample.c11_ - sample.c01_);
+
+                return bottom + sample.ty_ * (top - bottom);
+            }
+
+            // _gradient is d(clearance)/dx and d(clearance)/dy, unitless
+            double clearance(const MAPF_Util::Position::Coordinates &_coord, MAPF_Util::Position::Coordinates &_gradient) const
+            {
+                const Sample sample = locate(_coord);
+                const double bottom = sample.c00_ + sample.tx_ * (sample.c10_ - sample.c00_);
+                const double top = sample.c01_ + sample.tx_ * (sample.c11_ - sample.c01_);
+                const double left = sample.c00_ + sample.ty_ * (sample.c01_ - sample.c00_);
+                const double right = sample.c10_ + sample.ty_ * (sample.c11_ - sample.c10_);
+
+                _gradient.x_ = (right - left) * inverse_resolution_;
+                _gradient.y_ = (top - bottom) * inverse_resolution_;
+
+                return bottom + sample.ty_ * (top - bottom);
+            }
+
+            void clearances(std::span<const MAPF_Util::Position::Coordinates> _coords, std::span<double> _clearances) const;
+            void clearances(std::span<const MAPF_Util::Position::Coordinates> _coords, std::span<double> _clearances,
+                            std::span<MAPF_Util::Position::Coordinates> _gradients) const;
+
+            bool empty() const { return clearance_.empty(); }
+            int width() const { return width_; }
+            int height() const { return height_; }
+            double maxClearance() const { return max_clearance_; }
+            std::size_t memoryUsage() const { return clearance_.size() * sizeof(float); }
+
+        private:
+            // The four cells around a coordinate and its offsets between them
+            struct Sample
+            {
+                double c00_, c10_, c01_, c11_;
+                double tx_, ty_;
+            }; // struct Sample
+
+            Sample locate(const MAPF_Util::Position::Coordinates &_coord) const
+            {
+                const double gx = (_coord.x_ - origin_.x_) * inverse_resolution_;
+                const double gy = (_coord.y_ - origin_.y_) * inverse_resolution_;
+                // std::clamp passes NaN through, and casting it to int is undefined
+                if (std::isnan(gx) or std::isnan(gy))
+                {
+                    const double nan = std::numeric_limits<double>::quiet_NaN();
+                    return Sample{nan, nan, nan, nan, 0.0, 0.0};
+                }
+
+                const double fx = std::clamp(gx, 0.0, static_cast<double>(width_ - 1));
+                const double fy = std::clamp(gy, 0.0, static_cast<double>(height_ - 1));
+                const int x = std::min(static_cast<int>(fx), last_x_);
+                const int y = std::min(static_cast<int>(fy), last_y_);
+
+                const float *cell = clearance_.data() + static_cast<std::size_t>(y) * width_ + x;
+                return Sample{cell[0], cell[step_x_], cell[step_y_], cell[step_y_ + step_x_], fx - x, fy - y};
+            }
+
+            float toClearance(std::uint32_t _squared_distance) const;
+
+        private:
+            std::vector<float> clearance_;
+            int width_, height_;
+            // Lower-left corner of the last cell pair on each axis; the steps
+            // are 0 on an axis of a single cell
+            int last_x_, last_y_;
+            std::size_t step_x_, step_y_;
+            MAPF_Util::Position::Coordinates origin_;
+            double resolution_, inverse_resolution_;
+            double max_clearance_;
+
+        public:
+            ClearanceField()
+                : width_(0), height_(0), last_x_(0), last_y_(0), step_x_(0), step_y_(0),
+                  resolution_(0.0), inverse_resolution_(0.0), max_clearance_(0.0) {}
+        }; // class ClearanceField
+    } // namespace MapInstance
+} // namespace Instance
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <vector>
+
+#include "multibot_util/Map/BitGrid.hpp"
+#include "multibot_util/Util/CowBuffer.hpp"
+
+namespace Instance
+{
+    namespace MapInstance
+    {
+        // Exact squared Euclidean distance (in cells^2) from every cell to the
+        // nearest occupied cell, stored row-major together with the linear index
+        // of that obstacle. setObstacle()/removeObstacle() followed by update()
+        // repair the field locally with lower/raise waves (dynamic brushfire).
+        class DistanceField
+        {
+        public:
+            static constexpr std::uint32_t INF = std::numeric_limits<std::uint32_t>::max();
+
+        public:
+            void compute(const BitGrid &_occupancy);
+            void threshold(const std::uint32_t &_max_squared_distance, BitGrid &_result) const;
+
+            static std::uint32_t squaredThreshold(const double &_radius, const double &_resolution);
+
+            void setObstacle(int _x, int _y);
+            void removeObstacle(int _x, int _y);
+            void update(std::vector<std::int32_t> &_changed);
+
+            // Serves the field straight out of _backing until it is modified.
+            void borrow(int _width, int _height, std::shared_ptr<const void> _backing,
+                        const std::uint32_t *_squared_distance, const std::int32_t *_obstacle);
+
+            std::uint32_t squaredDistance(int _x, int _y) const
+            {
+                return squared_distance_[static_cast<std::size_t>(_y) * width_ + _x];
+            }
+
+            double distance(int _x, int _y, const double &_resolution) const;
+
+            std::int32_t obstacle(int _x, int _y) const
+            {
+                return obstacle_[static_cast<std::size_t>(_y) * width_ + _x];
+            }
+
+            bool empty() const { return squared_distance_.empty(); }
+            int width() const { return width_; }
+            int height() const { return height_; }
+            std::size_t memoryUsage() const { return squared_distance_.size() * sizeof(std::uint32_t); }
+
+            const std::uint32_t *data() const { return squared_distance_.data(); }
+            const std::int32_t *obstacleData() const { return obstacle_.data(); }
+            const std::uint32_t *row(int _y) const { return squared_distance_.data() + static_cast<std::size_t>(_y) * width_; }
+
+        private:
+            void computeRows(const BitGrid &_occupancy, int _rowBegin, int _rowEnd);
+            void computeColumns(int _columnBegin, int _columnEnd);
+
+            std::uint32_t squaredDistanceTo(std::int32_t _cell, std::int32_t _obstacle) const;
+            void lower(std::int32_t _cell, std::vector<std::int32_t> &_changed);
+            void raise(std::int32_t _cell, std::vector<std::int32_t> &_changed);
+
+        private:
+            typedef std::pair<std::uint32_t, std::int32_t> OpenEntry;
+
+            int width_, height_;
+            MAPF_Util::CowBuffer<std::uint32_t> squared_distance_;
+            MAPF_Util::CowBuffer<std::int32_t> obstacle_;
+
+            BitGrid to_raise_;
+            std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>> open_;
+
+        public:
+            DistanceField()
+                : width_(0), height_(0) {}
+        }; // class DistanceField
+    } // namespace MapInstance
+} // namespace Instance
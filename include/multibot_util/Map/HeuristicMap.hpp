@@ -0,0 +1,94 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+#include "multibot_util/Instance.hpp"
+#include "multibot_util/Util/LruCache.hpp"
+
+namespace Instance
+{
+    namespace MapInstance
+    {
+        // Shortest 8-connected path length from every cell to one goal over the
+        // inflated map, stored as 16-bit units of quantum() meters. Diagonal
+        // steps may not cut blocked corners. Values are rounded down, so the
+        // heuristic never overestimates the grid distance.
+        class HeuristicMap
+        {
+        public:
+            static constexpr std::uint16_t UNREACHABLE = UINT16_MAX;
+
+            static std::shared_ptr<HeuristicMap> compute(const BitGrid &_blocked,
+                                                         const BinaryOccupancyMap::MapProperty &_property,
+                                                         const Position::Index &_goal);
+
+            double distance(const Position::Index &_idx) const
+            {
+                if (_idx.x_ < 0 or _idx.y_ < 0 or _idx.x_ >= width_ or _idx.y_ >= height_)
+                    return std::numeric_limits<double>::infinity();
+
+                const std::uint16_t cost = cost_[static_cast<std::size_t>(_idx.y_) * width_ + _idx.x_];
+                return cost == UNREACHABLE ? std::numeric_limits<double>::infinity() : cost * quantum_;
+            }
+
+            double distance(const Position::Coordinates &_coord) const
+            {
+                return distance(Position::Index(static_cast<int>(std::lround((_coord.x_ - origin_.x_) / resolution_)),
+                                                static_cast<int>(std::lround((_coord.y_ - origin_.y_) / resolution_))));
+            }
+
+            bool isReachable(const Position::Index &_idx) const
+            {
+                return distance(_idx) != std::numeric_limits<double>::infinity();
+            }
+
+            const Position::Index &goal() const { return goal_; }
+            double quantum() const { return quantum_; }
+            int width() const { return width_; }
+            int height() const { return height_; }
+            const std::uint16_t *data() const { return cost_.data(); }
+            std::size_t memoryUsage() const { return cost_.size() * sizeof(std::uint16_t); }
+
+        private:
+            std::vector<std::uint16_t> cost_;
+            Position::Index goal_;
+            Position::Coordinates origin_;
+            int width_ = 0, height_ = 0;
+            double resolution_ = 1.0;
+            double quantum_ = 1.0;
+        }; // class HeuristicMap
+
+        // Memory-capped LRU cache of heuristic maps keyed by goal cell and
+        // inflation threshold, so radii that inflate identically share maps.
+        // Misses requested together are computed in parallel. Reads the map's
+        // distance field; call clear() after the map changes.
+        class HeuristicCache
+        {
+        public:
+            std::shared_ptr<const HeuristicMap> get(const Position::Index &_goal, const double &_inflation_radius);
+            std::vector<std::shared_ptr<const HeuristicMap>> get(const std::vector<Position::Index> &_goals,
+                                                                 const double &_inflation_radius);
+            // Maps towards every agent's goal_, in agent order
+            std::vector<std::shared_ptr<const HeuristicMap>> get(const std::vector<AgentInstance::Agent> &_agents,
+                                                                 const double &_inflation_radius);
+
+            void clear();
+            void setCapacity(std::size_t _max_bytes);
+            std::size_t memoryUsage() const;
+            std::size_t size() const;
+
+        private:
+            std::shared_ptr<const BitGrid> blockedGrid(std::uint32_t _threshold);
+
+            const BinaryOccupancyMap *map_;
+            MAPF_Util::LruCache<std::uint64_t, const HeuristicMap> maps_;
+            std::map<std::uint32_t, std::shared_ptr<const BitGrid>> blocked_grids_;
+            mutable std::mutex mtx_;
+
+        public:
+            HeuristicCache(const BinaryOccupancyMap &_map, std::size_t _max_bytes = std::size_t(256) << 20)
+                : map_(&_map), maps_(_max_bytes) {}
+        }; // class HeuristicCache
+    } // namespace MapInstance
+} // namespace Instance
\ No newline at end of file
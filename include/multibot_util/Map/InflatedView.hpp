@@ -0,0 +1,59 @@
+#pragma once
+
+#include "multibot_util/MAPF_Util.hpp"
+#include "multibot_util/Map/DistanceField.hpp"
+
+namespace Instance
+{
+    namespace MapInstance
+    {
+        // Non-owning, read-only inflation of a DistanceField at one radius.
+        // A cell is inflated when its squared distance is within threshold_.
+        class InflatedView
+        {
+        public:
+            bool isInflated(int _x, int _y) const
+            {
+                return field_->squaredDistance(_x, _y) <= threshold_;
+            }
+
+            bool isInflated(const MAPF_Util::Position::Index &_idx) const
+            {
+                return isInflated(_idx.x_, _idx.y_);
+            }
+
+            void materialize(BitGrid &_result) const
+            {
+                field_->threshold(threshold_, _result);
+            }
+
+            std::size_t count() const
+            {
+                std::size_t count = 0;
+                for (int y = 0; y < field_->height(); ++y)
+                {
+                    const std::uint32_t *distanceRow = field_->row(y);
+                    for (int x = 0; x < field_->width(); ++x)
+                        count += distanceRow[x] <= threshold_;
+                }
+
+                return count;
+            }
+
+            int width() const { return field_->width(); }
+            int height() const { return field_->height(); }
+            double radius() const { return radius_; }
+            std::uint32_t threshold() const { return threshold_; }
+            const DistanceField &field() const { return *field_; }
+
+        private:
+            const DistanceField *field_;
+            std::uint32_t threshold_;
+            double radius_;
+
+        public:
+            InflatedView(const DistanceField &_field, std::uint32_t _threshold, double _radius)
+                : field_(&_field), threshold_(_threshold), radius_(_radius) {}
+        }; // class InflatedView
+    } // namespace MapInstance
+} // namespace Instance
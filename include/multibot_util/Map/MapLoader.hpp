@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "multibot_util/Instance.hpp"
+#include "multibot_util/Util/MappedFile.hpp"
+
+namespace Instance
+{
+    namespace MapInstance
+    {
+        namespace MapLoader
+        {
+            // Contents of a ROS map_server YAML file
+            struct MapMetaData
+            {
+                std::string image_;
+                double resolution_;
+                Position::Coordinates origin_; // Lower-left corner of the image
+                double origin_yaw_;
+                bool negate_;
+                double occupied_thresh_;
+                double free_thresh_;
+
+                MapMetaData()
+                    : resolution_(std::numeric_limits<double>::quiet_NaN()), origin_(0.0, 0.0), origin_yaw_(0.0),
+                      negate_(false), occupied_thresh_(0.65), free_thresh_(0.196) {}
+            }; // struct MapMetaData
+
+            // Streams the rows of a PGM image as occupancy bits, top row first
+            class PgmReader
+            {
+            public:
+                bool open(const std::string &_pgm_path, const MapMetaData &_metaData, bool _unknown_as_occupied = true);
+                bool readRow(BitGrid::Word *_words);
+
+                int width() const { return width_; }
+                int height() const { return height_; }
+                const BinaryOccupancyMap::MapProperty &property() const { return property_; }
+
+            private:
+                std::string path_;
+                std::shared_ptr<const MAPF_Util::MappedFile> file_;
+                std::size_t pos_;
+                int width_, height_, max_value_;
+                bool binary_;
+                std::vector<bool> occupied_lookup_;
+                BinaryOccupancyMap::MapProperty property_;
+
+            public:
+                PgmReader()
+                    : pos_(0), width_(0), height_(0), max_value_(0), binary_(true) {}
+            }; // class PgmReader
+
+            bool parseYaml(const std::string &_yaml_path, MapMetaData &_metaData);
+            bool loadPgm(const std::string &_pgm_path, const MapMetaData &_metaData,
+                         BinaryOccupancyMap &_map, bool _unknown_as_occupied = true);
+            bool loadYaml(const std::string &_yaml_path, BinaryOccupancyMap &_map, bool _unknown_as_occupied = true);
+
+            // Binary cache: occupancy bits plus the distance field, read back with mmap.
+            // The stamp identifies the source files so stale caches are rejected.
+            std::uint64_t sourceStamp(const std::string &_yaml_path, bool _unknown_as_occupied = true);
+            bool writeCache(const std::string &_cache_path, const BinaryOccupancyMap &_map, const std::uint64_t &_stamp);
+            bool readCache(const std::string &_cache_path, BinaryOccupancyMap &_map, const std::uint64_t &_stamp);
+
+            // Opens _cache_path when it matches the YAML/PGM sources, otherwise parses them,
+            // computes the distance field and rewrites the cache.
+            bool load(const std::string &_yaml_path, const std::string &_cache_path,
+                      BinaryOccupancyMap &_map, bool _unknown_as_occupied = true);
+        } // namespace MapLoader
+    } // namespace MapInstance
+} // namespace Instance
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "multibot_util/Instance.hpp"
+
+namespace Instance
+{
+    namespace MapInstance
+    {
+        // Immutable version of an occupancy map and its inflation, split into
+        // square tiles held by shared pointers. Consecutive versions share
+        // every tile an update did not touch.
+        class MapSnapshot
+        {
+        public:
+            struct Tile
+            {
+                BitGrid occupancy_;
+                BitGrid inflated_;
+            }; // struct Tile
+
+        public:
+            bool isOutofMap(const Position::Index &_idx) const
+            {
+                return not(_idx.x_ >= 0 and _idx.x_ < property_.width_ and
+                           _idx.y_ >= 0 and _idx.y_ < property_.height_);
+            }
+
+            bool isOccupied(const Position::Index &_idx) const
+            {
+                return tileAt(_idx).occupancy_.get(_idx.x_ % tile_size_, _idx.y_ % tile_size_);
+            }
+
+            bool isInflated(const Position::Index &_idx) const
+            {
+                return tileAt(_idx).inflated_.get(_idx.x_ % tile_size_, _idx.y_ % tile_size_);
+            }
+
+            Cell cell(const Position::Index &_idx) const
+            {
+                return Cell(_idx, getCoordinates(_idx), isOccupied(_idx));
+            }
+
+            Cell inflatedCell(const Position::Index &_idx) const
+            {
+                return Cell(_idx, getCoordinates(_idx), isInflated(_idx));
+            }
+
+            Position::Coordinates getCoordinates(const Position::Index &_idx) const
+            {
+                return Position::Coordinates(property_.origin_.x_ + _idx.x_ * property_.resolution_,
+                                             property_.origin_.y_ + _idx.y_ * property_.resolution_);
+            }
+
+            Position::Index getIndex(const Position::Coordinates &_coord) const
+            {
+                return Position::Index(static_cast<int>(std::lround((_coord.x_ - property_.origin_.x_) / property_.resolution_)),
+                                       static_cast<int>(std::lround((_coord.y_ - property_.origin_.y_) / property_.resolution_)));
+            }
+
+            const std::shared_ptr<const Tile> &tile(int _tile_x, int _tile_y) const
+            {
+                return tiles_[static_cast<std::size_t>(_tile_y) * tiles_x_ + _tile_x];
+            }
+
+            const BinaryOccupancyMap::MapProperty &property() const { return property_; }
+            std::uint64_t version() const { return version_; }
+            int tileSize() const { return tile_size_; }
+            int tilesX() const { return tiles_x_; }
+            int tilesY() const { return tiles_y_; }
+            // Bytes of tile data reachable from this snapshot, shared or not
+            std::size_t memoryUsage() const;
+
+        private:
+            const Tile &tileAt(const Position::Index &_idx) const
+            {
+                return *tiles_[static_cast<std::size_t>(_idx.y_ / tile_size_) * tiles_x_ + _idx.x_ / tile_size_];
+            }
+
+            BinaryOccupancyMap::MapProperty property_;
+            std::uint64_t version_ = 0;
+            int tile_size_ = 0;
+            int tiles_x_ = 0, tiles_y_ = 0;
+            std::vector<std::shared_ptr<const Tile>> tiles_;
+
+            friend class VersionedMap;
+        }; // class MapSnapshot
+
+        // Live map that publishes a new MapSnapshot for every update. One
+        // writer applies occupancy changes to its own BinaryOccupancyMap,
+        // repairs the inflation incrementally and copies only the tiles whose
+        // occupancy or inflation changed. Any number of readers take the
+        // latest snapshot and keep a consistent view for as long as they hold it.
+        class VersionedMap
+        {
+        public:
+            // Keeps a per-thread snapshot and only reloads it after the
+            // version changed, so an unchanged map costs one atomic load
+            class Reader
+            {
+            public:
+                const MapSnapshot &current()
+                {
+                    if (snapshot_->version() != map_->version_.load(std::memory_order_acquire))
+                        snapshot_ = map_->latest_.load();
+                    return *snapshot_;
+                }
+
+                const std::shared_ptr<const MapSnapshot> &snapshot() const { return snapshot_; }
+
+            private:
+                const VersionedMap *map_;
+                std::shared_ptr<const MapSnapshot> snapshot_;
+
+            public:
+                Reader(const VersionedMap &_map)
+                    : map_(&_map), snapshot_(_map.snapshot()) {}
+            }; // class Reader
+
+        public:
+            std::shared_ptr<const MapSnapshot> snapshot() const { return latest_.load(); }
+            std::uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+            // Applies (cell, occupied) changes in order and publishes one new version
+            std::shared_ptr<const MapSnapshot> update(const std::vector<std::pair<Position::Index, bool>> &_changes);
+            // Re-inflates the whole map; every inflated tile is replaced
+            std::shared_ptr<const MapSnapshot> inflate(const double &_inflation_radius);
+
+        private:
+            std::shared_ptr<const MapSnapshot::Tile> makeTile(int _tile_x, int _tile_y) const;
+            void publish(std::shared_ptr<MapSnapshot> _snapshot);
+
+            BinaryOccupancyMap map_;
+            int tile_size_;
+            std::atomic<std::shared_ptr<const MapSnapshot>> latest_;
+            std::atomic<std::uint64_t> version_;
+            std::mutex writer_mtx_;
+
+        public:
+            // _tile_size must be a positive multiple of BitGrid::WORD_BITS
+            VersionedMap(const BinaryOccupancyMap &_map, int _tile_size = 256);
+        }; // class VersionedMap
+    } // namespace MapInstance
+} // namespace Instance
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "multibot_util/Instance.hpp"
+
+namespace Instance
+{
+    namespace MapInstance
+    {
+        // Per-cell time lines built from agent trajectories. Every reservation
+        // remembers the agent that made it, so one agent's trajectory can be
+        // removed or replaced by touching only the cells it swept.
+        class ReservationTable
+        {
+        public:
+            typedef std::uint32_t AgentId;
+
+            struct Reservation
+            {
+                AgentId agent_;
+                Time::TimePoint startTime_;
+                Time::TimePoint endTime_;
+            }; // struct Reservation
+
+            // Cells swept by a disc of _radius moving along _traj, with the time
+            // each cell overlaps the disc. Sorted by cell and merged per cell.
+            struct Footprint
+            {
+                std::vector<std::int32_t> cells_;
+                std::vector<std::pair<Time::TimePoint, Time::TimePoint>> intervals_;
+            }; // struct Footprint
+
+        public:
+            void initialize(const BinaryOccupancyMap::MapProperty &_property, bool _park_at_goal = true);
+            void clear();
+
+            void build(const Traj::TrajSet &_trajSet, const std::map<std::string, double> &_radii);
+            void insert(const Traj::TrajSet &_trajSet, const std::map<std::string, double> &_radii);
+            void insert(const Traj::SingleTraj &_traj, const double &_radius);
+            bool remove(const std::string &_agentName);
+
+            Footprint rasterize(const Traj::SingleTraj &_traj, const double &_radius) const;
+
+            const Time::TimeLine *timeLine(const Position::Index &_idx) const;
+            const std::vector<Reservation> *reservations(const Position::Index &_idx) const;
+            bool isSafe(const Position::Index &_idx, const Time::TimePoint &_time) const;
+            bool contains(const std::string &_agentName) const { return agents_.find(_agentName) != agents_.end(); }
+
+            std::size_t agentCount() const { return agents_.size(); }
+            std::size_t reservedCells() const { return cells_.size(); }
+
+        private:
+            struct CellEntry
+            {
+                Time::TimeLine timeLine_;
+                std::vector<Reservation> reservations_;
+            }; // struct CellEntry
+
+            struct AgentEntry
+            {
+                AgentId id_;
+                std::vector<std::int32_t> cells_;
+            }; // struct AgentEntry
+
+            void apply(const std::string &_agentName, Footprint &&_footprint);
+            void sweep(Footprint &_footprint, const Position::Coordinates &_from, const Position::Coordinates &_to,
+                       const Time::TimePoint &_startTime, const Time::TimePoint &_endTime, const double &_radius) const;
+            std::int32_t linearIndex(const Position::Index &_idx) const;
+
+        private:
+            BinaryOccupancyMap::MapProperty property_;
+            bool park_at_goal_ = true;
+
+            AgentId next_agent_id_ = 0;
+            std::unordered_map<std::string, AgentEntry> agents_;
+            std::unordered_map<std::int32_t, CellEntry> cells_;
+
+        public:
+            ReservationTable() {}
+            ReservationTable(const BinaryOccupancyMap::MapProperty &_property, bool _park_at_goal = true)
+            {
+                initialize(_property, _park_at_goal);
+            }
+        }; // class ReservationTable
+    } // namespace MapInstance
+} // namespace Instance
\ No newline at end of file
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <bit>
+#include <utility>
+
+#include "multibot_util/Instance.hpp"
+
+namespace Instance
+{
+    namespace MapInstance
+    {
+        struct SegmentCollision
+        {
+            bool collides_;
+            Position::Index idx_; // First blocking cell along the segment
+
+            SegmentCollision(bool _collides = false, Position::Index _idx = Position::Index())
+                : collides_(_collides), idx_(_idx) {}
+        }; // struct SegmentCollision
+
+        typedef std::pair<Position::Pose, Position::Pose> Segment;
+
+        // Clearance of straight segments against the inflated map. The segment is
+        // swept over its supercover one row run at a time; cells outside the map block.
+        SegmentCollision findSegmentCollision(const BinaryOccupancyMap &_map,
+                                              const Position::Coordinates &_from, const Position::Coordinates &_to);
+        SegmentCollision findSegmentCollision(const BinaryOccupancyMap &_map,
+                                              const Position::Pose &_from, const Position::Pose &_to);
+        SegmentCollision findSegmentCollision(const BinaryOccupancyMap &_map, const InflatedView &_view,
+                                              const Position::Coordinates &_from, const Position::Coordinates &_to);
+        SegmentCollision findSegmentCollision(const BinaryOccupancyMap &_map, const InflatedView &_view,
+                                              const Position::Pose &_from, const Position::Pose &_to);
+
+        std::vector<SegmentCollision> findSegmentCollisions(const BinaryOccupancyMap &_map,
+                                                            const std::vector<Segment> &_segments);
+        std::vector<SegmentCollision> findSegmentCollisions(const BinaryOccupancyMap &_map, const InflatedView &_view,
+                                                            const std::vector<Segment> &_segments);
+
+        namespace SegmentQuery
+        {
+            // First set bit of _row within [_xBegin, _xEnd], scanning towards
+            // increasing x when _forward. Returns -1 when the run is clear.
+            inline int firstSetBit(const BitGrid::Word *_row, int _xBegin, int _xEnd, bool _forward)
+            {
+                const int firstWord = _xBegin / BitGrid::WORD_BITS;
+                const int lastWord = _xEnd / BitGrid::WORD_BITS;
+                const auto maskOf = [&](int _word)
+                {
+                    BitGrid::Word mask = ~BitGrid::Word(0);
+                    if (_word == firstWord)
+                        mask &= ~BitGrid::Word(0) << (_xBegin % BitGrid::WORD_BITS);
+                    if (_word == lastWord and _xEnd % BitGrid::WORD_BITS != BitGrid::WORD_BITS - 1)
+                        mask &= (BitGrid::Word(1) << (_xEnd % BitGrid::WORD_BITS + 1)) - 1;
+                    return _row[_word] & mask;
+                };
+
+                if (_forward)
+                {
+                    for (int word = firstWord; word <= lastWord; ++word)
+                    {
+                        if (const BitGrid::Word bits = maskOf(word))
+                            return word * BitGrid::WORD_BITS + std::countr_zero(bits);
+                    }
+                }
+                else
+                {
+                    for (int word = lastWord; word >= firstWord; --word)
+                    {
+                        if (const BitGrid::Word bits = maskOf(word))
+                            return word * BitGrid::WORD_BITS + BitGrid::WORD_BITS - 1 - std::countl_zero(bits);
+                    }
+                }
+
+                return -1;
+            }
+
+            inline int floorToInt(double _value)
+            {
+                const int truncated = static_cast<int>(_value);
+                return truncated - (_value < truncated);
+            }
+
+            // Walks the rows covered by the segment in travel order and asks
+            // _rowTest(y, xBegin, xEnd, forward) for the first blocked x in each run.
+            template <typename RowTest>
+            SegmentCollision trace(const BinaryOccupancyMap::MapProperty &_property,
+                                   const Position::Coordinates &_from, const Position::Coordinates &_to,
+                                   RowTest &&_rowTest)
+            {
+                constexpr double EPSILON = 1e-9;
+
+                // Continuous cell space: cell i covers [i, i + 1)
+                const double inverseResolution = 1.0 / _property.resolution_;
+                const double u0 = (_from.x_ - _property.origin_.x_) * inverseResolution + 0.5;
+                const double v0 = (_from.y_ - _property.origin_.y_) * inverseResolution + 0.5;
+                const double u1 = (_to.x_ - _property.origin_.x_) * inverseResolution + 0.5;
+                const double v1 = (_to.y_ - _property.origin_.y_) * inverseResolution + 0.5;
+                const double du = u1 - u0;
+                const double dv = v1 - v0;
+                const bool forwardX = du >= 0;
+                const bool forwardY = dv >= 0;
+                const double uMin = std::min(u0, u1);
+                const double uMax = std::max(u0, u1);
+                const double slope = std::fabs(dv) > EPSILON ? du / dv : 0.0;
+
+                const int firstRow = floorToInt(forwardY ? v0 - EPSILON : v0 + EPSILON);
+                const int lastRow = floorToInt(forwardY ? v1 + EPSILON : v1 - EPSILON);
+                const int rowStep = forwardY ? 1 : -1;
+
+                for (int y = firstRow;; y += rowStep)
+                {
+                    // Part of the segment inside row y
+                    double uLow = uMin, uHigh = uMax;
+                    if (slope != 0.0)
+                    {
+                        const double uBottom = u0 + (y - v0) * slope;
+                        const double uTop = uBottom + slope;
+                        uLow = std::max(uMin, std::min(uBottom, uTop));
+                        uHigh = std::min(uMax, std::max(uBottom, uTop));
+                    }
+
+                    const int xBegin = floorToInt(uLow - EPSILON);
+                    const int xEnd = floorToInt(uHigh + EPSILON);
+
+                    // Cells outside the map block, in travel order like any other cell
+                    if (y < 0 or y >= _property.height_ or (forwardX ? xBegin < 0 : xEnd >= _property.width_))
+                        return SegmentCollision(true, Position::Index(forwardX ? xBegin : xEnd, y));
+
+                    const int clippedBegin = std::max(xBegin, 0);
+                    const int clippedEnd = std::min(xEnd, _property.width_ - 1);
+                    if (clippedBegin <= clippedEnd)
+                    {
+                        const int blocked = _rowTest(y, clippedBegin, clippedEnd, forwardX);
+                        if (blocked >= 0)
+                            return SegmentCollision(true, Position::Index(blocked, y));
+                    }
+
+                    if (xBegin < 0 or xEnd >= _property.width_)
+                        return SegmentCollision(true, Position::Index(forwardX ? _property.width_ : -1, y));
+
+                    if (y == lastRow)
+                        break;
+                }
+
+                return SegmentCollision();
+            }
+        } // namespace SegmentQuery
+    } // namespace MapInstance
+} // namespace Instance
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+#include "multibot_util/Instance.hpp"
+#include "multibot_util/Util/LruCache.hpp"
+
+namespace Instance
+{
+    namespace MapInstance
+    {
+        // Occupancy map split into square tiles that are read lazily from a
+        // tile store file. Occupancy and inflated tiles are each kept in an LRU
+        // cache of at most max_resident_tiles entries. Inflation is computed per
+        // tile over a halo wide enough to see every obstacle within the
+        // inflation radius, so tile borders are exact.
+        class TiledOccupancyMap
+        {
+        public:
+            static bool writeStore(const std::string &_store_path, const BinaryOccupancyMap &_map, int _tile_size = 256);
+            static bool convertYaml(const std::string &_yaml_path, const std::string &_store_path,
+                                    int _tile_size = 256, bool _unknown_as_occupied = true);
+
+            bool open(const std::string &_store_path, std::size_t _max_resident_tiles = 256);
+            void inflate(const double &_inflation_radius);
+
+            bool isOutofMap(const Cell &_cell) const;
+            bool isOutofMap(const Position::Index &_idx) const;
+            bool isOccupied(const Position::Index &_idx) const;
+            bool isInflated(const Position::Index &_idx) const;
+
+            Cell cell(const Position::Index &_idx) const
+            {
+                return Cell(_idx, getCoordinates(_idx), isOccupied(_idx));
+            }
+
+            Cell inflatedCell(const Position::Index &_idx) const
+            {
+                return Cell(_idx, getCoordinates(_idx), isInflated(_idx));
+            }
+
+            Position::Coordinates getCoordinates(const Position::Index &_idx) const
+            {
+                return Position::Coordinates(property_.origin_.x_ + _idx.x_ * property_.resolution_,
+                                             property_.origin_.y_ + _idx.y_ * property_.resolution_);
+            }
+
+            Position::Index getIndex(const Position::Coordinates &_coord) const
+            {
+                return Position::Index(static_cast<int>(std::lround((_coord.x_ - property_.origin_.x_) / property_.resolution_)),
+                                       static_cast<int>(std::lround((_coord.y_ - property_.origin_.y_) / property_.resolution_)));
+            }
+
+            std::shared_ptr<const BitGrid> tile(int _tile_x, int _tile_y) const;
+            std::shared_ptr<const BitGrid> inflatedTile(int _tile_x, int _tile_y) const;
+
+            int tileSize() const { return tile_size_; }
+            std::size_t residentTiles() const;
+            std::size_t memoryUsage() const;
+
+        private:
+            std::shared_ptr<const BitGrid> computeInflation(int _tile_x, int _tile_y) const;
+
+        public:
+            BinaryOccupancyMap::MapProperty property_;
+
+        private:
+            int tile_size_;
+            int tiles_x_, tiles_y_;
+            std::uint64_t data_offset_;
+
+            std::uint32_t inflation_threshold_;
+            int inflation_halo_;
+            std::uint64_t inflation_generation_;
+
+            mutable std::ifstream store_;
+            mutable MAPF_Util::LruCache<int, const BitGrid> occupancy_tiles_;
+            mutable MAPF_Util::LruCache<int, const BitGrid> inflated_tiles_;
+            mutable std::mutex mtx_;
+
+        public:
+            TiledOccupancyMap()
+                : tile_size_(0), tiles_x_(0), tiles_y_(0), data_offset_(0),
+                  inflation_threshold_(0), inflation_halo_(0), inflation_generation_(0) {}
+        }; // class TiledOccupancyMap
+    } // namespace MapInstance
+} // namespace Instance
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <geometry_msgs/msg/pose2_d.hpp>
+
+#include "multibot_util/MAPF_Util.hpp"
+
+namespace MAPF_Util
+{
+    // Conversions between the ROS-free core poses and geometry_msgs. Both are
+    // three plain doubles, so single conversions inline to register moves.
+    namespace Ros
+    {
+        inline geometry_msgs::msg::Pose2D toMsg(const Position::Pose &_pose)
+        {
+            return _pose.component_;
+        }
+
+        inline Position::Pose fromMsg(const geometry_msgs::msg::Pose2D &_msg)
+        {
+            return Position::Pose(_msg);
+        }
+
+        std::vector<geometry_msgs::msg::Pose2D> toMsgs(std::span<const Position::Pose> _poses);
+        std::vector<Position::Pose> fromMsgs(std::span<const geometry_msgs::msg::Pose2D> _msgs);
+    } // namespace Ros
+} // namespace MAPF_Util
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace MAPF_Util
+{
+    namespace Traj
+    {
+        typedef std::uint32_t AgentId;
+        constexpr AgentId INVALID_AGENT = UINT32_MAX;
+
+        // Interns agent names to dense, never reused IDs starting at 0.
+        // Name references stay valid for the registry's lifetime.
+        class AgentRegistry
+        {
+        public:
+            AgentId intern(std::string_view _name)
+            {
+                const auto found = ids_.find(_name);
+                if (found != ids_.end())
+                    return found->second;
+
+                const AgentId id = static_cast<AgentId>(names_.size());
+                names_.emplace_back(_name);
+                ids_.emplace(names_.back(), id);
+                return id;
+            }
+
+            AgentId find(std::string_view _name) const
+            {
+                const auto found = ids_.find(_name);
+                return found == ids_.end() ? INVALID_AGENT : found->second;
+            }
+
+            const std::string &name(AgentId _id) const { return names_[_id]; }
+            bool contains(AgentId _id) const { return _id < names_.size(); }
+            std::size_t size() const { return names_.size(); }
+
+        private:
+            std::deque<std::string> names_;
+            std::unordered_map<std::string_view, AgentId> ids_;
+
+        public:
+            AgentRegistry() {}
+            AgentRegistry(const AgentRegistry &) = delete;
+            AgentRegistry &operator=(const AgentRegistry &) = delete;
+        }; // class AgentRegistry
+    } // namespace Traj
+} // namespace MAPF_Util
\ No newline at end of file
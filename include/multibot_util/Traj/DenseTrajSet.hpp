@@ -0,0 +1,58 @@
+#pragma once
+
+#include <deque>
+
+#include "multibot_util/MAPF_Util.hpp"
+#include "multibot_util/Traj/AgentRegistry.hpp"
+
+namespace MAPF_Util
+{
+    namespace Traj
+    {
+        // Trajectories indexed directly by AgentId. Slots are never moved, so
+        // both IDs and references to stored trajectories stay valid until the
+        // slot is erased. The registry must outlive the set.
+        class DenseTrajSet
+        {
+        public:
+            static DenseTrajSet fromTrajSet(const TrajSet &_trajSet, AgentRegistry &_registry);
+            TrajSet toTrajSet() const;
+
+            SingleTraj &insert(AgentId _id, const SingleTraj &_traj);
+            SingleTraj &insert(const SingleTraj &_traj) { return insert(registry_->intern(_traj.agentName_), _traj); }
+            bool erase(AgentId _id);
+            void clear();
+
+            bool contains(AgentId _id) const { return _id < present_.size() and present_[_id]; }
+            SingleTraj *find(AgentId _id) { return contains(_id) ? &slots_[_id] : nullptr; }
+            const SingleTraj *find(AgentId _id) const { return contains(_id) ? &slots_[_id] : nullptr; }
+            SingleTraj &operator[](AgentId _id) { return slots_[_id]; }
+            const SingleTraj &operator[](AgentId _id) const { return slots_[_id]; }
+
+            // Visits stored trajectories in ID order
+            template <typename Function>
+            void forEach(Function &&_function) const
+            {
+                for (AgentId id = 0; id < present_.size(); ++id)
+                {
+                    if (present_[id])
+                        _function(id, slots_[id]);
+                }
+            }
+
+            std::size_t size() const { return size_; }
+            bool empty() const { return size_ == 0; }
+            AgentRegistry &registry() const { return *registry_; }
+
+        private:
+            AgentRegistry *registry_;
+            std::deque<SingleTraj> slots_;
+            std::vector<unsigned char> present_;
+            std::size_t size_ = 0;
+
+        public:
+            DenseTrajSet(AgentRegistry &_registry)
+                : registry_(&_registry) {}
+        }; // class DenseTrajSet
+    } // namespace Traj
+} // namespace MAPF_Util
\ No newline at end of file
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include "multibot_util/MAPF_Util.hpp"
+
+namespace MAPF_Util
+{
+    namespace Traj
+    {
+        // Versioned binary encoding of a TrajSet. Agent names are interned in a
+        // string table, every trajectory has a fixed-size record in an offset
+        // table, and node poses and times are quantized and stored as zig-zag
+        // varint deltas from the previous node. TimePoint::max() is kept exact.
+        namespace TrajCodec
+        {
+            struct Quantization
+            {
+                double position_ = 1e-4; // m
+                double angle_ = 1e-5;    // rad
+                double time_ = 1e-4;     // s
+            }; // struct Quantization
+
+            std::vector<unsigned char> encode(const TrajSet &_trajSet, const Quantization &_quantization = Quantization());
+            bool write(const std::string &_path, const TrajSet &_trajSet, const Quantization &_quantization = Quantization());
+
+            struct Header
+            {
+                char magic_[8];
+                std::uint32_t version_;
+                std::uint32_t endian_;
+                std::uint32_t traj_count_;
+                std::uint32_t string_count_;
+                double position_quantum_;
+                double angle_quantum_;
+                double time_quantum_;
+                std::uint64_t strings_offset_;
+                std::uint64_t records_offset_;
+                std::uint64_t body_offset_;
+                std::uint64_t file_bytes_;
+            }; // struct Header
+
+            struct Record
+            {
+                std::uint32_t key_string_;
+                std::uint32_t name_string_;
+                std::uint32_t pair_count_;
+                std::uint32_t reserved_;
+                std::uint64_t body_offset_;
+                double cost_;
+            }; // struct Record
+
+            // Running quantized state shared by the encoder and decoder
+            struct DeltaState
+            {
+                std::int64_t x_ = 0, y_ = 0, theta_ = 0;
+                std::int64_t time_ = 0;
+            }; // struct DeltaState
+        } // namespace TrajCodec
+
+        class TrajSetView;
+
+        // One encoded trajectory. Node pairs are decoded one at a time while
+        // iterating; nothing is allocated.
+        class TrajView
+        {
+        public:
+            class NodeIterator
+            {
+            public:
+                typedef std::pair<SingleTraj::Node, SingleTraj::Node> value_type;
+
+                const value_type &operator*() const { return pair_; }
+                const value_type *operator->() const { return &pair_; }
+                NodeIterator &operator++();
+
+                bool operator==(const NodeIterator &_other) const { return remaining_ == _other.remaining_; }
+                bool operator!=(const NodeIterator &_other) const { return remaining_ != _other.remaining_; }
+
+            private:
+                bool decode(SingleTraj::Node &_node);
+
+                const TrajSetView *set_ = nullptr;
+                const unsigned char *cursor_ = nullptr;
+                const unsigned char *end_ = nullptr;
+                std::uint32_t remaining_ = 0;
+                TrajCodec::DeltaState state_;
+                value_type pair_;
+
+                friend class TrajView;
+            }; // class NodeIterator
+
+            std::string_view key() const;
+            std::string_view agentName() const;
+            double cost() const { return record_.cost_; }
+            std::size_t size() const { return record_.pair_count_; }
+
+            NodeIterator begin() const;
+            NodeIterator end() const { return NodeIterator(); }
+
+            SingleTraj toSingleTraj() const;
+
+        private:
+            const TrajSetView *set_;
+            TrajCodec::Record record_;
+            std::uint64_t body_end_;
+
+        public:
+            TrajView(const TrajSetView *_set, const TrajCodec::Record &_record, std::uint64_t _body_end)
+                : set_(_set), record_(_record), body_end_(_body_end) {}
+        }; // class TrajView
+
+        // Reads an encoded TrajSet in place, from a caller buffer or a mapped
+        // file. Only the header and table bounds are validated up front.
+        class TrajSetView
+        {
+        public:
+            bool open(const unsigned char *_data, std::size_t _size, std::shared_ptr<const void> _backing = nullptr);
+            bool open(const std::string &_path);
+
+            std::size_t size() const { return header_.traj_count_; }
+            TrajView operator[](std::size_t _i) const;
+            // Trajectories are stored in TrajSet key order, so lookup is a binary search
+            std::optional<TrajView> find(std::string_view _key) const;
+
+            TrajSet toTrajSet() const;
+
+        private:
+            std::string_view string(std::uint32_t _id) const;
+            TrajCodec::Record record(std::size_t _i) const;
+
+            const unsigned char *data_ = nullptr;
+            std::size_t size_ = 0;
+            std::shared_ptr<const void> backing_;
+            TrajCodec::Header header_{};
+
+            friend class TrajView;
+
+        public:
+            TrajSetView() {}
+        }; // class TrajSetView
+    } // namespace Traj
+} // namespace MAPF_Util
\ No newline at end of file
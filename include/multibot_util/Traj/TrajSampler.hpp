@@ -0,0 +1,42 @@
+#pragma once
+
+#include <span>
+
+#include "multibot_util/MAPF_Util.hpp"
+
+namespace MAPF_Util
+{
+    namespace Traj
+    {
+        // Poses of every agent in a TrajSet at one time point, written in
+        // TrajSet (agent name) order. Each agent keeps a cursor into its nodes_,
+        // so sampling at non-decreasing times only walks forward and costs
+        // amortized O(1) per agent; going back in time falls back to a binary search.
+        // The TrajSet must outlive the sampler and keep its trajectories unchanged.
+        class TrajSampler
+        {
+        public:
+            void reset(const TrajSet &_trajSet);
+            void sample(const Time::TimePoint &_time, std::span<Position::Pose> _poses);
+
+            const std::vector<const std::string *> &agentNames() const { return agent_names_; }
+            std::size_t size() const { return trajs_.size(); }
+
+        private:
+            std::vector<const std::string *> agent_names_;
+            std::vector<const SingleTraj *> trajs_;
+            std::vector<std::size_t> cursors_;
+            Time::TimePoint last_time_;
+
+        public:
+            TrajSampler() {}
+            TrajSampler(const TrajSet &_trajSet)
+            {
+                reset(_trajSet);
+            }
+        }; // class TrajSampler
+
+        // One-off snapshot without cursors: a binary search per agent
+        void sample(const TrajSet &_trajSet, const Time::TimePoint &_time, std::span<Position::Pose> _poses);
+    } // namespace Traj
+} // namespace MAPF_Util
\ No newline at end of file
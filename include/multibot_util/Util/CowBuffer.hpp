@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace MAPF_Util
+{
+    // Contiguous buffer that either owns its elements or borrows them from a
+    // shared, read-only backing (e.g. a MappedFile). The first mutable access
+    // to a borrowed buffer copies it into owned storage.
+    template <typename T>
+    class CowBuffer
+    {
+    public:
+        const T &operator[](std::size_t _idx) const { return data_[_idx]; }
+        const T *data() const { return data_; }
+        std::size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        bool isBorrowed() const { return backing_ != nullptr; }
+
+        T *mutableData()
+        {
+            if (backing_)
+            {
+                owned_.assign(data_, data_ + size_);
+                backing_.reset();
+                data_ = owned_.data();
+            }
+
+            return owned_.data();
+        }
+
+        void resize(std::size_t _size)
+        {
+            if (backing_)
+                mutableData();
+
+            owned_.resize(_size);
+            data_ = owned_.data();
+            size_ = _size;
+        }
+
+        void borrow(std::shared_ptr<const void> _backing, const T *_data, std::size_t _size)
+        {
+            owned_.clear();
+            owned_.shrink_to_fit();
+            backing_ = std::move(_backing);
+            data_ = _data;
+            size_ = _size;
+        }
+
+        CowBuffer &operator=(const CowBuffer &_other)
+        {
+            if (this == &_other)
+                return *this;
+
+            backing_ = _other.backing_;
+            size_ = _other.size_;
+            if (backing_)
+            {
+                owned_.clear();
+                data_ = _other.data_;
+            }
+            else
+            {
+                owned_ = _other.owned_;
+                data_ = owned_.data();
+            }
+
+            return *this;
+        }
+
+        CowBuffer &operator=(CowBuffer &&_other) noexcept
+        {
+            backing_ = std::move(_other.backing_);
+            owned_ = std::move(_other.owned_);
+            size_ = _other.size_;
+            data_ = backing_ ? _other.data_ : owned_.data();
+
+            _other.data_ = nullptr;
+            _other.size_ = 0;
+
+            return *this;
+        }
+
+    private:
+        std::vector<T> owned_;
+        std::shared_ptr<const void> backing_;
+        const T *data_;
+        std::size_t size_;
+
+    public:
+        CowBuffer()
+            : data_(nullptr), size_(0) {}
+
+        CowBuffer(const CowBuffer &_other)
+            : CowBuffer()
+        {
+            *this = _other;
+        }
+
+        CowBuffer(CowBuffer &&_other) noexcept
+            : CowBuffer()
+        {
+            *this = std::move(_other);
+        }
+    }; // class CowBuffer
+} // namespace MAPF_Util
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace MAPF_Util
+{
+    // Bump allocator for one planning episode. Deallocation is a no-op and
+    // reset() rewinds to the first block in O(1), keeping every block for the
+    // next episode, so a warmed-up arena stops calling malloc entirely.
+    // Anything allocated before a reset() must be gone or copied out to the
+    // heap first. Not thread safe; use one arena per planner thread.
+    class EpisodeArena : public std::pmr::memory_resource
+    {
+    public:
+        void reset()
+        {
+            current_ = 0;
+            offset_ = 0;
+            allocated_ = 0;
+        }
+
+        // Bytes handed out since the last reset()
+        std::size_t bytesAllocated() const { return allocated_; }
+        // Bytes held in blocks, used or not
+        std::size_t capacity() const;
+
+    private:
+        void *do_allocate(std::size_t _bytes, std::size_t _alignment) override;
+        void do_deallocate(void *, std::size_t, std::size_t) override {}
+        bool do_is_equal(const std::pmr::memory_resource &_other) const noexcept override
+        {
+            return this == &_other;
+        }
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> data_;
+            std::size_t size_;
+        }; // struct Block
+
+        std::vector<Block> blocks_;
+        std::size_t current_ = 0;
+        std::size_t offset_ = 0;
+        std::size_t allocated_ = 0;
+        std::size_t next_block_size_;
+
+    public:
+        explicit EpisodeArena(std::size_t _initial_block_size = 64 * 1024)
+            : next_block_size_(_initial_block_size) {}
+
+        EpisodeArena(const EpisodeArena &) = delete;
+        EpisodeArena &operator=(const EpisodeArena &) = delete;
+    }; // class EpisodeArena
+} // namespace MAPF_Util
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace MAPF_Util
+{
+    // Least-recently-used cache of shared values with a total cost budget.
+    // Not synchronized; owners guard it with their own mutex.
+    template <typename Key, typename Value, typename Hash = std::hash<Key>>
+    class LruCache
+    {
+    public:
+        std::shared_ptr<Value> find(const Key &_key)
+        {
+            auto found = entries_.find(_key);
+            if (found == entries_.end())
+                return nullptr;
+
+            order_.splice(order_.begin(), order_, found->second.position_);
+            return found->second.value_;
+        }
+
+        void insert(const Key &_key, std::shared_ptr<Value> _value, std::size_t _cost = 1)
+        {
+            erase(_key);
+
+            order_.push_front(_key);
+            entries_.emplace(_key, Entry{std::move(_value), _cost, order_.begin()});
+            cost_ += _cost;
+
+            // The newest entry always stays, even if it alone exceeds the budget
+            while (cost_ > capacity_ and entries_.size() > 1)
+                erase(order_.back());
+        }
+
+        void erase(const Key &_key)
+        {
+            auto found = entries_.find(_key);
+            if (found == entries_.end())
+                return;
+
+            cost_ -= found->second.cost_;
+            order_.erase(found->second.position_);
+            entries_.erase(found);
+        }
+
+        void clear()
+        {
+            entries_.clear();
+            order_.clear();
+            cost_ = 0;
+        }
+
+        void setCapacity(std::size_t _capacity)
+        {
+            capacity_ = _capacity;
+            while (cost_ > capacity_ and not(entries_.empty()))
+                erase(order_.back());
+        }
+
+        template <typename Function>
+        void forEach(Function &&_function) const
+        {
+            for (const auto &entry : entries_)
+                _function(entry.first, *entry.second.value_);
+        }
+
+        std::size_t size() const { return entries_.size(); }
+        std::size_t cost() const { return cost_; }
+        std::size_t capacity() const { return capacity_; }
+
+    private:
+        struct Entry
+        {
+            std::shared_ptr<Value> value_;
+            std::size_t cost_;
+            typename std::list<Key>::iterator position_;
+        }; // struct Entry
+
+        std::unordered_map<Key, Entry, Hash> entries_;
+        std::list<Key> order_;
+        std::size_t cost_;
+        std::size_t capacity_;
+
+    public:
+        explicit LruCache(std::size_t _capacity = 0)
+            : cost_(0), capacity_(_capacity) {}
+    }; // class LruCache
+} // namespace MAPF_Util
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace MAPF_Util
+{
+    // Read-only memory mapping of a whole file. Shared ownership keeps the
+    // mapping alive for every buffer that points into it.
+    class MappedFile
+    {
+    public:
+        static std::shared_ptr<const MappedFile> open(const std::string &_path);
+
+        const unsigned char *data() const { return static_cast<const unsigned char *>(data_); }
+        std::size_t size() const { return size_; }
+
+    private:
+        void *data_;
+        std::size_t size_;
+
+    public:
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(void *_data, std::size_t _size)
+            : data_(_data), size_(_size) {}
+        ~MappedFile();
+    }; // class MappedFile
+} // namespace MAPF_Util
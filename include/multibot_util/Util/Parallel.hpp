@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+
+namespace MAPF_Util
+{
+    namespace Parallel
+    {
+        inline unsigned int hardwareThreads()
+        {
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        // Type-erased backend of parallelFor(). Chunks of _chunk items are
+        // handed out to the calling thread (worker 0) and to idle threads of
+        // one process-wide pool of hardwareThreads() - 1 threads, at most
+        // _workers of them. Concurrent callers share that pool, so they never
+        // run more threads than cores; a caller whose helpers are all busy
+        // simply runs every chunk itself.
+        void run(std::size_t _begin, std::size_t _end, std::size_t _chunk, unsigned int _workers,
+                 void (*_invoke)(void *, std::size_t, std::size_t, unsigned int), void *_context);
+
+        // Splits [_begin, _end) into contiguous chunks of at least _grain items and
+        // calls _function(chunkBegin, chunkEnd, worker) for each of them, with
+        // worker < hardwareThreads() unique among the threads running at once.
+        // Ranges of fewer than two grains run inline on the calling thread.
+        template <typename Function>
+        void parallelFor(std::size_t _begin, std::size_t _end, Function &&_function,
+                         std::size_t _grain = 1, unsigned int _max_workers = 0)
+        {
+            if (_end <= _begin)
+                return;
+
+            const std::size_t count = _end - _begin;
+            const std::size_t grain = std::max<std::size_t>(1, _grain);
+            const std::size_t maxWorkers = std::min(hardwareThreads(), _max_workers > 0 ? _max_workers : hardwareThreads());
+            const std::size_t workers = std::max<std::size_t>(1, std::min(maxWorkers, count / grain));
+            if (workers == 1)
+            {
+                _function(_begin, _end, 0u);
+                return;
+            }
+
+            // A few chunks per worker balance uneven items
+            const std::size_t chunk = std::max(grain, (count + 4 * workers - 1) / (4 * workers));
+            run(_begin, _end, chunk, static_cast<unsigned int>(workers),
+                [](void *_context, std::size_t _chunkBegin, std::size_t _chunkEnd, unsigned int _worker)
+                { (*static_cast<std::remove_reference_t<Function> *>(_context))(_chunkBegin, _chunkEnd, _worker); },
+                const_cast<void *>(static_cast<const void *>(&_function)));
+        }
+    } // namespace Parallel
+} // namespace MAPF_Util
\ No newline at end of file
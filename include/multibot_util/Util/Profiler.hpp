@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+// Instrumentation is compiled in only with MULTIBOT_UTIL_PROFILING defined
+// (cmake -DENABLE_PROFILING=ON). Otherwise every macro expands to nothing.
+//   MULTIBOT_PROFILE_SCOPE("name")              times the enclosing scope
+//   MULTIBOT_PROFILE_COUNT("name", delta)       adds to a counter
+//   MULTIBOT_PROFILE_HISTOGRAM("name", value)   records a value in a log2 histogram
+// Names must be string literals. Each call site resolves its thread's slot
+// once, so recording is a few relaxed stores; a scope also appends its trace
+// event with one uncontended compare-exchange. Only allocating a new block
+// of trace events takes the thread's own lock.
+#ifdef MULTIBOT_UTIL_PROFILING
+#define MULTIBOT_PROFILE_CONCAT_IMPL(_a, _b) _a##_b
+#define MULTIBOT_PROFILE_CONCAT(_a, _b) MULTIBOT_PROFILE_CONCAT_IMPL(_a, _b)
+#define MULTIBOT_PROFILE_SCOPE(_name)                                                                            \
+    static thread_local MAPF_Util::Profiler::ScopeStats &MULTIBOT_PROFILE_CONCAT(profile_scope_, __LINE__) =     \
+        MAPF_Util::Profiler::scopeSlot(_name);                                                                   \
+    MAPF_Util::Profiler::ScopedTimer MULTIBOT_PROFILE_CONCAT(profile_timer_, __LINE__)(_name, MULTIBOT_PROFILE_CONCAT(profile_scope_, __LINE__))
+#define MULTIBOT_PROFILE_COUNT(_name, _delta)                                                                    \
+    do                                                                                                           \
+    {                                                                                                            \
+        static thread_local MAPF_Util::Profiler::Counter &profile_counter_ = MAPF_Util::Profiler::counterSlot(_name); \
+        profile_counter_.add(_delta);                                                                            \
+    } while (false)
+#define MULTIBOT_PROFILE_HISTOGRAM(_name, _value)                                                                \
+    do                                                                                                           \
+    {                                                                                                            \
+        static thread_local MAPF_Util::Profiler::Histogram &profile_histogram_ = MAPF_Util::Profiler::histogramSlot(_name); \
+        profile_histogram_.record(_value);                                                                       \
+    } while (false)
+#else
+#define MULTIBOT_PROFILE_SCOPE(_name) ((void)0)
+#define MULTIBOT_PROFILE_COUNT(_name, _delta) ((void)0)
+#define MULTIBOT_PROFILE_HISTOGRAM(_name, _value) ((void)0)
+#endif
+
+namespace MAPF_Util
+{
+    namespace Profiler
+    {
+        // Slots are written only by their owning thread; relaxed atomics let
+        // the exporter read them while that thread keeps running
+        struct Counter
+        {
+            std::atomic<std::int64_t> value_{0};
+
+            void add(std::int64_t _delta)
+            {
+                value_.store(value_.load(std::memory_order_relaxed) + _delta, std::memory_order_relaxed);
+            }
+        }; // struct Counter
+
+        // Bucket 0 holds values below 1, bucket i holds [2^(i-1), 2^i)
+        struct Histogram
+        {
+            static constexpr int BUCKETS = 64;
+
+            std::atomic<std::uint64_t> buckets_[BUCKETS] = {};
+            std::atomic<std::uint64_t> count_{0};
+            std::atomic<double> sum_{0.0};
+            std::atomic<double> max_{0.0};
+
+            void record(double _value);
+        }; // struct Histogram
+
+        struct ScopeStats
+        {
+            std::atomic<std::uint64_t> calls_{0};
+            std::atomic<std::uint64_t> total_ns_{0};
+            std::atomic<std::uint64_t> max_ns_{0};
+        }; // struct ScopeStats
+
+        // Nanoseconds since the profiler's epoch (its first use)
+        std::uint64_t now();
+
+        ScopeStats &scopeSlot(const char *_name);
+        Counter &counterSlot(const char *_name);
+        Histogram &histogramSlot(const char *_name);
+        // Aggregates the scope and, while the thread's event buffer has room,
+        // keeps it as a trace event
+        void recordScope(const char *_name, ScopeStats &_stats, std::uint64_t _begin_ns, std::uint64_t _end_ns);
+
+        class ScopedTimer
+        {
+        private:
+            const char *name_;
+            ScopeStats &stats_;
+            std::uint64_t begin_ns_;
+
+        public:
+            ScopedTimer(const char *_name, ScopeStats &_stats)
+                : name_(_name), stats_(_stats), begin_ns_(now()) {}
+            ~ScopedTimer()
+            {
+                recordScope(name_, stats_, begin_ns_, now());
+            }
+
+            ScopedTimer(const ScopedTimer &) = delete;
+            ScopedTimer &operator=(const ScopedTimer &) = delete;
+        }; // class ScopedTimer
+
+        // Trace events kept per thread; later scopes are still aggregated but
+        // counted as dropped. Default 1 << 20. A new thread may adopt the
+        // buffer of one that exited, and then shares its quota and trace row.
+        void setEventCapacity(std::size_t _events_per_thread);
+        // Zeroes every slot and drops the recorded events of all threads
+        void reset();
+
+        // Chrome trace-event JSON (chrome://tracing, Perfetto): one complete
+        // event per recorded scope and the final counter values
+        bool writeChromeTrace(const std::string &_path);
+        // Per-name totals merged across threads
+        void writeSummary(std::ostream &_os = std::cout);
+    } // namespace Profiler
+} // namespace MAPF_Util
\ No newline at end of file
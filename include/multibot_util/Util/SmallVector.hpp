@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace MAPF_Util
+{
+    // Contiguous vector that keeps up to N elements inline and only allocates
+    // from Allocator once it grows past them. Like the standard containers,
+    // copies select their allocator through allocator_traits and assignment
+    // keeps the target's allocator.
+    template <typename T, std::size_t N, typename Allocator = std::allocator<T>>
+    class SmallVector
+    {
+    public:
+        typedef T value_type;
+        typedef Allocator allocator_type;
+        typedef std::size_t size_type;
+        typedef T *iterator;
+        typedef const T *const_iterator;
+        typedef T &reference;
+        typedef const T &const_reference;
+
+    public:
+        iterator begin() { return data_; }
+        iterator end() { return data_ + size_; }
+        const_iterator begin() const { return data_; }
+        const_iterator end() const { return data_ + size_; }
+        const_iterator cbegin() const { return data_; }
+        const_iterator cend() const { return data_ + size_; }
+
+        T &operator[](size_type _idx) { return data_[_idx]; }
+        const T &operator[](size_type _idx) const { return data_[_idx]; }
+        T &front() { return data_[0]; }
+        const T &front() const { return data_[0]; }
+        T &back() { return data_[size_ - 1]; }
+        const T &back() const { return data_[size_ - 1]; }
+        T *data() { return data_; }
+        const T *data() const { return data_; }
+
+        size_type size() const { return size_; }
+        size_type capacity() const { return capacity_; }
+        bool empty() const { return size_ == 0; }
+        bool isInline() const { return data_ == inlineData(); }
+        allocator_type get_allocator() const { return allocator_; }
+
+        void reserve(size_type _capacity)
+        {
+            if (_capacity <= capacity_)
+                return;
+
+            T *grown = std::allocator_traits<Allocator>::allocate(allocator_, _capacity);
+            std::uninitialized_move(data_, data_ + size_, grown);
+            std::destroy(data_, data_ + size_);
+            release();
+
+            data_ = grown;
+            capacity_ = _capacity;
+        }
+
+        template <typename... Args>
+        T &emplace_back(Args &&..._args)
+        {
+            if (size_ == capacity_)
+            {
+                // _args may alias an element, so build the value before growing
+                T value(std::forward<Args>(_args)...);
+                reserve(std::max<size_type>(1, capacity_ * 2));
+                return *::new (static_cast<void *>(data_ + size_++)) T(std::move(value));
+            }
+
+            return *::new (static_cast<void *>(data_ + size_++)) T(std::forward<Args>(_args)...);
+        }
+
+        void push_back(const T &_value) { emplace_back(_value); }
+        void push_back(T &&_value) { emplace_back(std::move(_value)); }
+
+        void pop_back()
+        {
+            std::destroy_at(data_ + --size_);
+        }
+
+        iterator insert(const_iterator _pos, const T &_value)
+        {
+            return insert(_pos, &_value, &_value + 1);
+        }
+
+        template <typename InputIt>
+        iterator insert(const_iterator _pos, InputIt _first, InputIt _last)
+        {
+            const size_type offset = static_cast<size_type>(_pos - data_);
+            const size_type oldSize = size_;
+            for (; _first != _last; ++_first)
+                emplace_back(*_first);
+
+            std::rotate(data_ + offset, data_ + oldSize, data_ + size_);
+            return data_ + offset;
+        }
+
+        iterator erase(const_iterator _pos)
+        {
+            return erase(_pos, _pos + 1);
+        }
+
+        iterator erase(const_iterator _first, const_iterator _last)
+        {
+            iterator first = data_ + (_first - data_);
+            iterator last = data_ + (_last - data_);
+            if (first == last)
+                return first;
+
+            iterator newEnd = std::move(last, end(), first);
+            std::destroy(newEnd, end());
+            size_ = static_cast<size_type>(newEnd - data_);
+
+            return first;
+        }
+
+        void clear()
+        {
+            std::destroy(data_, data_ + size_);
+            size_ = 0;
+        }
+
+        SmallVector &operator=(const SmallVector &_other)
+        {
+            if (this == &_other)
+                return *this;
+
+            clear();
+            reserve(_other.size_);
+            std::uninitialized_copy(_other.begin(), _other.end(), data_);
+            size_ = _other.size_;
+
+            return *this;
+        }
+
+        SmallVector &operator=(SmallVector &&_other) noexcept
+        {
+            if (this == &_other)
+                return *this;
+
+            clear();
+            if (_other.isInline() or not(allocator_ == _other.allocator_))
+            {
+                reserve(_other.size_);
+                std::uninitialized_move(_other.begin(), _other.end(), data_);
+                size_ = _other.size_;
+                _other.clear();
+            }
+            else
+            {
+                release();
+                data_ = _other.data_;
+                size_ = _other.size_;
+                capacity_ = _other.capacity_;
+
+                _other.data_ = _other.inlineData();
+                _other.size_ = 0;
+                _other.capacity_ = N;
+            }
+
+            return *this;
+        }
+
+        bool operator==(const SmallVector &_other) const
+        {
+            return std::equal(begin(), end(), _other.begin(), _other.end());
+        }
+
+        bool operator!=(const SmallVector &_other) const
+        {
+            return not(*this == _other);
+        }
+
+    private:
+        T *inlineData() { return std::launder(reinterpret_cast<T *>(storage_)); }
+        const T *inlineData() const { return std::launder(reinterpret_cast<const T *>(storage_)); }
+
+        void release()
+        {
+            if (not(isInline()))
+                std::allocator_traits<Allocator>::deallocate(allocator_, data_, capacity_);
+        }
+
+    private:
+        alignas(T) unsigned char storage_[N * sizeof(T)];
+        T *data_;
+        size_type size_;
+        size_type capacity_;
+        [[no_unique_address]] Allocator allocator_;
+
+    public:
+        SmallVector()
+            : SmallVector(Allocator()) {}
+
+        explicit SmallVector(const Allocator &_allocator)
+            : data_(inlineData()), size_(0), capacity_(N), allocator_(_allocator) {}
+
+        SmallVector(std::initializer_list<T> _values, const Allocator &_allocator = Allocator())
+            : SmallVector(_allocator)
+        {
+            insert(end(), _values.begin(), _values.end());
+        }
+
+        SmallVector(const SmallVector &_other)
+            : SmallVector(std::allocator_traits<Allocator>::select_on_container_copy_construction(_other.allocator_))
+        {
+            *this = _other;
+        }
+
+        SmallVector(SmallVector &&_other) noexcept
+            : SmallVector(_other.allocator_)
+        {
+            *this = std::move(_other);
+        }
+
+        ~SmallVector()
+        {
+            clear();
+            release();
+        }
+    }; // class SmallVector
+} // namespace MAPF_Util
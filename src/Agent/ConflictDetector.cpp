@@ -0,0 +1,351 @@
+#include "multibot_util/Agent/ConflictDetector.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include "multibot_util/Util/Parallel.hpp"
+
+using namespace Instance;
+
+namespace
+{
+    constexpr std::size_t PAIR_GRAIN = 16;
+    constexpr std::size_t PIECES_PER_BOX = 8;
+
+    // Radius-padded bounding box of a few consecutive pieces over their time window
+    struct PieceBox
+    {
+        std::size_t track_;
+        double startTime_, endTime_;
+        double minX_, minY_, maxX_, maxY_;
+    }; // struct PieceBox
+
+    std::int64_t cellIndex(double _coordinate, double _inverse_cell_size)
+    {
+        return static_cast<std::int64_t>(std::floor(_coordinate * _inverse_cell_size));
+    }
+
+    // Cells are hashed into a power of two buckets; cells sharing a bucket
+    // only add candidates
+    std::size_t bucketOf(std::int64_t _cell_x, std::int64_t _cell_y, unsigned int _bits)
+    {
+        const std::uint64_t key = (static_cast<std::uint64_t>(_cell_x) * 0x9E3779B97F4A7C15ull) ^
+                                  (static_cast<std::uint64_t>(_cell_y) * 0xC2B2AE3D27D4EB4Full);
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> (64 - _bits));
+    }
+} // namespace
+
+void AgentInstance::ConflictDetector::setAgents(const std::vector<Agent> &_agents)
+{
+    radii_.clear();
+    for (const auto &agent : _agents)
+        setRadius(agent.name_, agent.size_);
+}
+
+void AgentInstance::ConflictDetector::setRadius(const std::string &_agentName, const double &_radius)
+{
+    try
+    {
+        if (not(_radius >= 0))
+            throw _radius;
+    }
+    catch (const double &_invalid_radius)
+    {
+        std::cerr << "[Error] ConflictDetector::setRadius(): "
+                  << "Invalid Radius for " << _agentName << ": " << _invalid_radius << std::endl;
+        std::abort();
+    }
+
+    radii_[_agentName] = _radius;
+}
+
+std::optional<AgentInstance::Conflict> AgentInstance::ConflictDetector::findFirstConflict(const Traj::TrajSet &_trajSet) const
+{
+    const std::vector<Track> tracks = buildTracks(_trajSet);
+    const auto pairs = candidatePairs(tracks);
+
+    // Pairs only search up to the earliest contact found so far by any worker
+    std::atomic<double> horizon(std::numeric_limits<double>::infinity());
+    std::vector<double> contacts(pairs.size(), std::numeric_limits<double>::infinity());
+    MAPF_Util::Parallel::parallelFor(0, pairs.size(), [&](std::size_t _begin, std::size_t _end, unsigned int)
+    {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+            const auto contact = earliestContact(tracks[pairs[i].first], tracks[pairs[i].second],
+                                                 horizon.load(std::memory_order_relaxed));
+            if (not contact.has_value())
+                continue;
+
+            contacts[i] = contact.value();
+            double current = horizon.load(std::memory_order_relaxed);
+            while (contacts[i] < current and not horizon.compare_exchange_weak(current, contacts[i], std::memory_order_relaxed))
+                ;
+        }
+    }, PAIR_GRAIN);
+
+    const auto first = std::min_element(contacts.begin(), contacts.end());
+    if (first == contacts.end() or *first == std::numeric_limits<double>::infinity())
+        return std::nullopt;
+
+    const auto &[firstTrack, secondTrack] = pairs[first - contacts.begin()];
+    return Conflict{*tracks[firstTrack].agentName_, *tracks[secondTrack].agentName_, Time::TimePoint(*first),
+                    locate(tracks[firstTrack], *first), locate(tracks[secondTrack], *first)};
+}
+
+std::vector<AgentInstance::Conflict> AgentInstance::ConflictDetector::findConflicts(const Traj::TrajSet &_trajSet) const
+{
+    const std::vector<Track> tracks = buildTracks(_trajSet);
+    const auto pairs = candidatePairs(tracks);
+
+    std::vector<std::optional<double>> contacts(pairs.size());
+    MAPF_Util::Parallel::parallelFor(0, pairs.size(), [&](std::size_t _begin, std::size_t _end, unsigned int)
+    {
+        for (std::size_t i = _begin; i < _end; ++i)
+            contacts[i] = earliestContact(tracks[pairs[i].first], tracks[pairs[i].second],
+                                          std::numeric_limits<double>::infinity());
+    }, PAIR_GRAIN);
+
+    std::vector<Conflict> conflicts;
+    for (std::size_t i = 0; i < pairs.size(); ++i)
+    {
+        if (not contacts[i].has_value())
+            continue;
+
+        const double time = contacts[i].value();
+        const Track &first = tracks[pairs[i].first];
+        const Track &second = tracks[pairs[i].second];
+        conflicts.push_back(Conflict{*first.agentName_, *second.agentName_, Time::TimePoint(time),
+                                     locate(first, time), locate(second, time)});
+    }
+    std::stable_sort(conflicts.begin(), conflicts.end(), [](const Conflict &_first, const Conflict &_second)
+                     { return _first.time_ < _second.time_; });
+
+    return conflicts;
+}
+
+std::vector<AgentInstance::ConflictDetector::Track> AgentInstance::ConflictDetector::buildTracks(const Traj::TrajSet &_trajSet) const
+{
+    std::vector<Track> tracks;
+    tracks.reserve(_trajSet.size());
+    for (const auto &[agentName, traj] : _trajSet)
+    {
+        const auto radius = radii_.find(agentName);
+        try
+        {
+            if (radius == radii_.end())
+                throw agentName;
+        }
+        catch (const std::string &_unknown_agent)
+        {
+            std::cerr << "[Error] ConflictDetector::buildTracks(): "
+                      << "Unknown agent " << _unknown_agent << std::endl;
+            std::abort();
+        }
+
+        Track track;
+        track.agentName_ = &agentName;
+        track.radius_ = radius->second;
+        track.pieces_.reserve(traj.nodes_.size() * 2 + 1);
+
+        const auto addPiece = [&track](double _startTime, double _endTime, const Position::Pose &_from, const Position::Pose &_to)
+        {
+            if (not(_startTime < _endTime))
+                return;
+
+            const double duration = _endTime - _startTime;
+            const bool still = _from.component_.x == _to.component_.x and _from.component_.y == _to.component_.y;
+            track.pieces_.push_back(Piece{_startTime, _endTime, _from.component_.x, _from.component_.y,
+                                          still ? 0.0 : (_to.component_.x - _from.component_.x) / duration,
+                                          still ? 0.0 : (_to.component_.y - _from.component_.y) / duration});
+        };
+
+        for (std::size_t i = 0; i < traj.nodes_.size(); ++i)
+        {
+            const auto &[from, to] = traj.nodes_[i];
+            addPiece(from.arrival_time_.count(), from.departure_time_.count(), from.pose_, from.pose_);
+            addPiece(from.departure_time_.count(), to.arrival_time_.count(), from.pose_, to.pose_);
+            if (i + 1 == traj.nodes_.size())
+                addPiece(to.arrival_time_.count(),
+                         park_at_goal_ ? std::numeric_limits<double>::infinity() : to.departure_time_.count(),
+                         to.pose_, to.pose_);
+        }
+        if (track.pieces_.empty())
+            continue;
+
+        tracks.push_back(std::move(track));
+    }
+
+    return tracks;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> AgentInstance::ConflictDetector::candidatePairs(const std::vector<Track> &_tracks) const
+{
+    // Boxes over a few pieces each, so parked agents and long trajectories
+    // only meet the agents near them at the same time. A parked piece gets
+    // a box of its own, its time window never ends.
+    std::vector<PieceBox> boxes;
+    boxes.reserve(_tracks.size() * 4);
+    double side = 0.0;
+    for (std::size_t t = 0; t < _tracks.size(); ++t)
+    {
+        const auto &pieces = _tracks[t].pieces_;
+        const double radius = _tracks[t].radius_;
+        for (std::size_t begin = 0, end = 0; begin < pieces.size(); begin = end)
+        {
+            PieceBox box{t, pieces[begin].startTime_, pieces[begin].endTime_,
+                         std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+                         -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+            do
+            {
+                const Piece &piece = pieces[end];
+                double endX = piece.x_, endY = piece.y_;
+                if (piece.vx_ != 0.0 or piece.vy_ != 0.0)
+                {
+                    endX += piece.vx_ * (piece.endTime_ - piece.startTime_);
+                    endY += piece.vy_ * (piece.endTime_ - piece.startTime_);
+                }
+
+                box.endTime_ = piece.endTime_;
+                box.minX_ = std::min({box.minX_, piece.x_ - radius, endX - radius});
+                box.minY_ = std::min({box.minY_, piece.y_ - radius, endY - radius});
+                box.maxX_ = std::max({box.maxX_, piece.x_ + radius, endX + radius});
+                box.maxY_ = std::max({box.maxY_, piece.y_ + radius, endY + radius});
+            } while (++end < pieces.size() and end - begin < PIECES_PER_BOX and std::isfinite(pieces[end].endTime_));
+
+            side += std::max(box.maxX_ - box.minX_, box.maxY_ - box.minY_);
+            boxes.push_back(box);
+        }
+    }
+    if (boxes.empty())
+        return {};
+
+    // Spatial hash with cells about one box wide, filled by a counting sort
+    // on the bucket of every covered cell
+    const double inverseCellSize = 1.0 / std::max(side / boxes.size(), 1e-3);
+    unsigned int bits = 1;
+    while ((std::size_t(1) << bits) < boxes.size())
+        ++bits;
+
+    const auto forEachCell = [&](const PieceBox &_box, auto &&_function)
+    {
+        const std::int64_t minX = cellIndex(_box.minX_, inverseCellSize), maxX = cellIndex(_box.maxX_, inverseCellSize);
+        const std::int64_t minY = cellIndex(_box.minY_, inverseCellSize), maxY = cellIndex(_box.maxY_, inverseCellSize);
+        for (std::int64_t y = minY; y <= maxY; ++y)
+            for (std::int64_t x = minX; x <= maxX; ++x)
+                _function(bucketOf(x, y, bits));
+    };
+
+    std::vector<std::uint32_t> offsets((std::size_t(1) << bits) + 1, 0);
+    for (const auto &box : boxes)
+        forEachCell(box, [&offsets](std::size_t _bucket)
+                    { ++offsets[_bucket + 1]; });
+    for (std::size_t b = 1; b < offsets.size(); ++b)
+        offsets[b] += offsets[b - 1];
+
+    std::vector<std::uint32_t> entries(offsets.back());
+    {
+        std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (std::size_t i = 0; i < boxes.size(); ++i)
+            forEachCell(boxes[i], [&](std::size_t _bucket)
+                        { entries[fill[_bucket]++] = static_cast<std::uint32_t>(i); });
+    }
+
+    // Sweep each bucket along time; a box pair sharing several cells is only
+    // reported from the bucket holding the low corner of its intersection
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    for (std::size_t b = 0; b + 1 < offsets.size(); ++b)
+    {
+        const auto begin = entries.begin() + offsets[b], end = entries.begin() + offsets[b + 1];
+        if (end - begin < 2)
+            continue;
+
+        std::sort(begin, end, [&boxes](std::uint32_t _first, std::uint32_t _second)
+                  { return boxes[_first].startTime_ < boxes[_second].startTime_; });
+        for (auto i = begin; i != end; ++i)
+        {
+            const PieceBox &first = boxes[*i];
+            for (auto j = i + 1; j != end; ++j)
+            {
+                const PieceBox &second = boxes[*j];
+                if (second.startTime_ >= first.endTime_)
+                    break;
+                if (first.track_ == second.track_ or
+                    second.minX_ >= first.maxX_ or first.minX_ >= second.maxX_ or
+                    second.minY_ >= first.maxY_ or first.minY_ >= second.maxY_)
+                    continue;
+                if (bucketOf(cellIndex(std::max(first.minX_, second.minX_), inverseCellSize),
+                             cellIndex(std::max(first.minY_, second.minY_), inverseCellSize), bits) != b)
+                    continue;
+
+                pairs.emplace_back(std::min(first.track_, second.track_), std::max(first.track_, second.track_));
+            }
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    return pairs;
+}
+
+std::optional<double> AgentInstance::ConflictDetector::earliestContact(const Track &_first, const Track &_second, double _horizon)
+{
+    const double reach = _first.radius_ + _second.radius_;
+    const double reachSq = reach * reach;
+
+    auto first = _first.pieces_.begin();
+    auto second = _second.pieces_.begin();
+    while (first != _first.pieces_.end() and second != _second.pieces_.end())
+    {
+        const double startTime = std::max(first->startTime_, second->startTime_);
+        const double endTime = std::min(first->endTime_, second->endTime_);
+        if (startTime > _horizon)
+            break;
+
+        if (startTime < endTime)
+        {
+            // Relative position D + V s for s in [0, endTime - startTime)
+            const double dx = (first->x_ + first->vx_ * (startTime - first->startTime_)) -
+                              (second->x_ + second->vx_ * (startTime - second->startTime_));
+            const double dy = (first->y_ + first->vy_ * (startTime - first->startTime_)) -
+                              (second->y_ + second->vy_ * (startTime - second->startTime_));
+            const double vx = first->vx_ - second->vx_;
+            const double vy = first->vy_ - second->vy_;
+
+            const double c = dx * dx + dy * dy - reachSq;
+            if (c < 0)
+                return startTime;
+
+            const double a = vx * vx + vy * vy;
+            const double b = 2.0 * (dx * vx + dy * vy);
+            if (a > 0 and b < 0)
+            {
+                const double discriminant = b * b - 4.0 * a * c;
+                if (discriminant > 0)
+                {
+                    const double contact = startTime + (-b - std::sqrt(discriminant)) / (2.0 * a);
+                    if (contact < endTime and contact <= _horizon)
+                        return contact;
+                }
+            }
+        }
+
+        if (first->endTime_ < second->endTime_)
+            ++first;
+        else
+            ++second;
+    }
+
+    return std::nullopt;
+}
+
+Position::Coordinates AgentInstance::ConflictDetector::locate(const Track &_track, double _time)
+{
+    auto piece = std::upper_bound(_track.pieces_.begin(), _track.pieces_.end(), _time,
+                                  [](double _t, const Piece &_piece)
+                                  { return _t < _piece.startTime_; });
+    if (piece != _track.pieces_.begin())
+        --piece;
+
+    const double elapsed = std::max(0.0, std::min(_time, piece->endTime_) - piece->startTime_);
+    return Position::Coordinates(piece->x_ + piece->vx_ * elapsed, piece->y_ + piece->vy_ * elapsed);
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "multibot_util/Agent/FleetState.hpp"
+
+#include <algorithm>
+
+using namespace Instance;
+
+namespace
+{
+    void checkSize(const char *_caller, const char *_what, std::size_t _size, std::size_t _fleet)
+    {
+        try
+        {
+            if (_size < _fleet)
+                throw _size;
+        }
+        catch (const std::size_t &_invalid_size)
+        {
+            std::cerr << "[Error] FleetState::" << _caller << "(): "
+                      << _invalid_size << " " << _what << " for a fleet of " << _fleet << std::endl;
+            std::abort();
+        }
+    }
+
+    namespace FleetKernel
+    {
+        void clampVelocity(double *__restrict _velocity, const double *__restrict _command,
+                           const double *__restrict _max_velocity, const double *__restrict _max_acceleration,
+                           double _dt, std::size_t _count)
+        {
+            for (std::size_t i = 0; i < _count; ++i)
+            {
+                const double step = _max_acceleration[i] * _dt;
+                const double velocity = std::min(std::max(_command[i], _velocity[i] - step), _velocity[i] + step);
+                _velocity[i] = std::min(std::max(velocity, -_max_velocity[i]), _max_velocity[i]);
+            }
+        }
+
+        // Second order (midpoint heading) unicycle step, exact for straight motion
+        void integrate(double *__restrict _x, double *__restrict _y, double *__restrict _theta,
+                       const double *__restrict _lin_vel, const double *__restrict _ang_vel,
+                       double _dt, std::size_t _count)
+        {
+            for (std::size_t i = 0; i < _count; ++i)
+            {
+                const double heading = _theta[i] + 0.5 * _ang_vel[i] * _dt;
+                const double distance = _lin_vel[i] * _dt;
+                _x[i] += distance * std::cos(heading);
+                _y[i] += distance * std::sin(heading);
+            }
+
+            // Position::normalizeAngle() spelled out so the loop vectorizes; wraps any number of turns
+            for (std::size_t i = 0; i < _count; ++i)
+            {
+                const double theta = _theta[i] + _ang_vel[i] * _dt;
+                _theta[i] = theta - 2 * M_PI * std::nearbyint(theta / (2 * M_PI));
+            }
+        }
+
+        void distance(double *__restrict _distance, const double *__restrict _x, const double *__restrict _y,
+                      const double *__restrict _goal_x, const double *__restrict _goal_y, std::size_t _count)
+        {
+            for (std::size_t i = 0; i < _count; ++i)
+            {
+                const double dx = _goal_x[i] - _x[i];
+                const double dy = _goal_y[i] - _y[i];
+                _distance[i] = std::sqrt(dx * dx + dy * dy);
+            }
+        }
+    } // namespace FleetKernel
+} // namespace
+
+std::size_t AgentInstance::FleetState::add(const Agent &_agent)
+{
+    x_.push_back(_agent.pose_.component_.x);
+    y_.push_back(_agent.pose_.component_.y);
+    theta_.push_back(Position::normalizeAngle(_agent.pose_.component_.theta));
+    lin_vel_.push_back(_agent.linVel_);
+    ang_vel_.push_back(_agent.angVel_);
+    goal_x_.push_back(_agent.goal_.component_.x);
+    goal_y_.push_back(_agent.goal_.component_.y);
+    max_lin_vel_.push_back(_agent.max_linVel_);
+    max_lin_acc_.push_back(_agent.max_linAcc_);
+    max_ang_vel_.push_back(_agent.max_angVel_);
+    max_ang_acc_.push_back(_agent.max_angAcc_);
+
+    return x_.size() - 1;
+}
+
+void AgentInstance::FleetState::assign(const std::vector<Agent> &_agents)
+{
+    clear();
+    for (auto *array : {&x_, &y_, &theta_, &lin_vel_, &ang_vel_, &goal_x_, &goal_y_,
+                        &max_lin_vel_, &max_lin_acc_, &max_ang_vel_, &max_ang_acc_})
+        array->reserve(_agents.size());
+
+    for (const auto &agent : _agents)
+        add(agent);
+}
+
+void AgentInstance::FleetState::writeBack(std::vector<Agent> &_agents) const
+{
+    checkSize("writeBack", "agents", _agents.size(), size());
+
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        _agents[i].pose_ = pose(i);
+        _agents[i].linVel_ = lin_vel_[i];
+        _agents[i].angVel_ = ang_vel_[i];
+    }
+}
+
+void AgentInstance::FleetState::clear()
+{
+    for (auto *array : {&x_, &y_, &theta_, &lin_vel_, &ang_vel_, &goal_x_, &goal_y_,
+                        &max_lin_vel_, &max_lin_acc_, &max_ang_vel_, &max_ang_acc_})
+        array->clear();
+}
+
+void AgentInstance::FleetState::applyCommands(std::span<const double> _linVel, std::span<const double> _angVel, double _dt)
+{
+    checkSize("applyCommands", "commands", std::min(_linVel.size(), _angVel.size()), size());
+
+    FleetKernel::clampVelocity(lin_vel_.data(), _linVel.data(), max_lin_vel_.data(), max_lin_acc_.data(), _dt, size());
+    FleetKernel::clampVelocity(ang_vel_.data(), _angVel.data(), max_ang_vel_.data(), max_ang_acc_.data(), _dt, size());
+}
+
+void AgentInstance::FleetState::integrate(double _dt)
+{
+    FleetKernel::integrate(x_.data(), y_.data(), theta_.data(), lin_vel_.data(), ang_vel_.data(), _dt, size());
+}
+
+void AgentInstance::FleetState::distanceToGoal(std::span<double> _distances) const
+{
+    checkSize("distanceToGoal", "distances", _distances.size(), size());
+
+    FleetKernel::distance(_distances.data(), x_.data(), y_.data(), goal_x_.data(), goal_y_.data(), size());
+}
\ No newline at end of file
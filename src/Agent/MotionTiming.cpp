@@ -0,0 +1,181 @@
+#include "multibot_util/Agent/MotionTiming.hpp"
+
+using namespace Instance;
+
+namespace
+{
+    constexpr double POSITION_EPSILON = 1e-9;
+
+    double turnAngle(double _from, double _to)
+    {
+        return std::fabs(std::remainder(_to - _from, 2 * M_PI));
+    }
+
+    void checkSize(const char *_caller, std::size_t _size, std::size_t _required)
+    {
+        try
+        {
+            if (_size < _required)
+                throw _size;
+        }
+        catch (const std::size_t &_invalid_size)
+        {
+            std::cerr << "[Error] MotionTiming::" << _caller << "(): "
+                      << "Array of " << _invalid_size << " elements for " << _required << " inputs" << std::endl;
+            std::abort();
+        }
+    }
+} // namespace
+
+AgentInstance::MotionProfile::MotionProfile(double _max_lin_vel, double _max_lin_acc,
+                                            double _max_ang_vel, double _max_ang_acc)
+    : max_lin_vel_(_max_lin_vel), max_lin_acc_(_max_lin_acc),
+      max_ang_vel_(_max_ang_vel), max_ang_acc_(_max_ang_acc)
+{
+    try
+    {
+        if (not(_max_lin_vel > 0 and _max_lin_acc > 0 and _max_ang_vel > 0 and _max_ang_acc > 0))
+            throw *this;
+    }
+    catch (const MotionProfile &_invalid_profile)
+    {
+        std::cerr << "[Error] MotionProfile::MotionProfile(): "
+                  << "Invalid Limits: " << _invalid_profile.max_lin_vel_ << "m/s, " << _invalid_profile.max_lin_acc_ << "m/s^2, "
+                  << _invalid_profile.max_ang_vel_ << "rad/s, " << _invalid_profile.max_ang_acc_ << "rad/s^2" << std::endl;
+        std::abort();
+    }
+
+    lin_ramp_distance_ = max_lin_vel_ * max_lin_vel_ / max_lin_acc_;
+    lin_ramp_time_ = max_lin_vel_ / max_lin_acc_;
+    ang_ramp_angle_ = max_ang_vel_ * max_ang_vel_ / max_ang_acc_;
+    ang_ramp_time_ = max_ang_vel_ / max_ang_acc_;
+    inverse_lin_vel_ = 1.0 / max_lin_vel_;
+    inverse_lin_acc_ = 1.0 / max_lin_acc_;
+    inverse_ang_vel_ = 1.0 / max_ang_vel_;
+    inverse_ang_acc_ = 1.0 / max_ang_acc_;
+}
+
+std::pair<double, double> AgentInstance::MotionProfile::moveTime(const Position::Pose &_from, const Position::Pose &_to) const
+{
+    const double dx = _to.component_.x - _from.component_.x;
+    const double dy = _to.component_.y - _from.component_.y;
+    const double distance = std::sqrt(dx * dx + dy * dy);
+    if (distance < POSITION_EPSILON)
+        return std::make_pair(rotationTime(turnAngle(_from.component_.theta, _to.component_.theta)), 0.0);
+
+    const double heading = std::atan2(dy, dx);
+    return std::make_pair(rotationTime(turnAngle(_from.component_.theta, heading)),
+                          translationTime(distance) + rotationTime(turnAngle(heading, _to.component_.theta)));
+}
+
+void AgentInstance::MotionProfile::precomputeGrid(double _resolution)
+{
+    for (int diagonal = 0; diagonal < 2; ++diagonal)
+    {
+        const double translation = translationTime(diagonal ? _resolution * M_SQRT2 : _resolution);
+        for (int turn = 0; turn < 8; ++turn)
+            grid_step_time_[diagonal][turn] = rotationTime(turnAngle(0.0, turn * M_PI_4)) + translation;
+    }
+}
+
+std::size_t AgentInstance::ProfileTable::add(const Agent &_agent)
+{
+    const auto found = ids_.find(_agent.type_);
+    if (found != ids_.end())
+    {
+        const MotionProfile &profile = profiles_[found->second];
+        if (profile.maxLinVel() != _agent.max_linVel_ or profile.maxLinAcc() != _agent.max_linAcc_ or
+            profile.maxAngVel() != _agent.max_angVel_ or profile.maxAngAcc() != _agent.max_angAcc_)
+            std::cerr << "[Warn] ProfileTable::add(): "
+                      << _agent.name_ << " has different limits than other agents of type " << _agent.type_ << std::endl;
+        return found->second;
+    }
+
+    profiles_.emplace_back(_agent);
+    ids_.emplace(_agent.type_, profiles_.size() - 1);
+    return profiles_.size() - 1;
+}
+
+void AgentInstance::ProfileTable::assign(const std::vector<Agent> &_agents)
+{
+    profiles_.clear();
+    ids_.clear();
+    for (const auto &agent : _agents)
+        add(agent);
+}
+
+void AgentInstance::ProfileTable::precomputeGrid(double _resolution)
+{
+    for (auto &profile : profiles_)
+        profile.precomputeGrid(_resolution);
+}
+
+std::size_t AgentInstance::ProfileTable::profileId(const std::string &_type) const
+{
+    const auto found = ids_.find(_type);
+    try
+    {
+        if (found == ids_.end())
+            throw _type;
+    }
+    catch (const std::string &_unknown_type)
+    {
+        std::cerr << "[Error] ProfileTable::profileId(): "
+                  << "Unknown agent type " << _unknown_type << std::endl;
+        std::abort();
+    }
+
+    return found->second;
+}
+
+Traj::SingleTraj AgentInstance::MotionTiming::timeTrajectory(const std::string &_agentName,
+                                                             const std::vector<Position::Pose> &_poses,
+                                                             const MotionProfile &_profile,
+                                                             Time::TimePoint _startTime)
+{
+    Traj::SingleTraj traj;
+    traj.agentName_ = _agentName;
+    traj.cost_ = 0.0;
+    if (_poses.size() < 2)
+        return traj;
+
+    traj.nodes_.reserve(_poses.size() - 1);
+    Time::TimePoint time = _startTime;
+    for (std::size_t i = 0; i + 1 < _poses.size(); ++i)
+    {
+        const auto [turn, drive] = _profile.moveTime(_poses[i], _poses[i + 1]);
+
+        Traj::SingleTraj::Node from, to;
+        from.pose_ = _poses[i];
+        from.arrival_time_ = time;
+        from.departure_time_ = time + Time::TimePoint(turn);
+        to.pose_ = _poses[i + 1];
+        to.arrival_time_ = from.departure_time_ + Time::TimePoint(drive);
+        to.departure_time_ = to.arrival_time_;
+
+        time = to.arrival_time_;
+        traj.nodes_.emplace_back(from, to);
+    }
+    traj.cost_ = (time - _startTime).count();
+
+    return traj;
+}
+
+void AgentInstance::MotionTiming::edgeTimes(const MotionProfile &_profile, const Position::Pose &_from,
+                                            std::span<const Position::Pose> _to, std::span<double> _times)
+{
+    checkSize("edgeTimes", _times.size(), _to.size());
+
+    for (std::size_t i = 0; i < _to.size(); ++i)
+        _times[i] = _profile.edgeTime(_from, _to[i]);
+}
+
+void AgentInstance::MotionTiming::edgeTimes(const MotionProfile &_profile, std::span<const Position::Pose> _from,
+                                            std::span<const Position::Pose> _to, std::span<double> _times)
+{
+    checkSize("edgeTimes", _to.size(), _from.size());
+    checkSize("edgeTimes", _times.size(), _from.size());
+
+    for (std::size_t i = 0; i < _from.size(); ++i)
+        _times[i] = _profile.edgeTime(_from[i], _to[i]);
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "multibot_util/Instance.hpp"
 
+#include "multibot_util/Util/Parallel.hpp"
+
 using namespace Instance;
 
 MapInstance::BinaryOccupancyMap &MapInstance::BinaryOccupancyMap::operator=(const MapInstance::BinaryOccupancyMap &_other)
@@ -7,12 +9,68 @@ MapInstance::BinaryOccupancyMap &MapInstance::BinaryOccupancyMap::operator=(cons
     property_ = _other.property_;
     mapData_ = _other.mapData_;
     inflated_mapData_ = _other.inflated_mapData_;
+    distance_field_ = _other.distance_field_;
+    distance_field_dirty_ = _other.distance_field_dirty_;
+    inflated_views_.clear();
+    clearance_field_ = _other.clearance_field_;
+    clearance_field_dirty_ = _other.clearance_field_dirty_;
 
     return *this;
 }
 
+void MapInstance::BinaryOccupancyMap::initialize(const MapProperty &_property)
+{
+    try
+    {
+        if (_property.width_ <= 0 or _property.height_ <= 0)
+            throw _property;
+    }
+    catch (const MapProperty &_invalid_property)
+    {
+        std::cerr << "[Error] BinaryOccupancyMap::initialize(): "
+                  << "Invalid Map Size: " << _invalid_property.width_ << " x " << _invalid_property.height_ << std::endl;
+        std::abort();
+    }
+
+    property_ = _property;
+    mapData_.resize(property_.width_, property_.height_);
+    inflated_mapData_.resize(property_.width_, property_.height_);
+    distance_field_dirty_ = true;
+}
+
+std::vector<Position::Index> MapInstance::BinaryOccupancyMap::getInflatedArea(const std::vector<Position::Index> &_rootArea,
+                                                                              const double &_inflation_radius) const
+{
+    thread_local InflationWorkspace workspace;
+    return getInflatedArea(_rootArea, _inflation_radius, workspace);
+}
+
 std::vector<Position::Index> MapInstance::BinaryOccupancyMap::getInflatedArea(const std::vector<Position::Index> &_rootArea,
-                                                                              const double &_inflation_radius)
+                                                                              const double &_inflation_radius,
+                                                                              InflationWorkspace &_workspace) const
+{
+    std::vector<Position::Index> inflatedArea;
+    collectInflatedArea(_rootArea, _inflation_radius, _workspace, inflatedArea);
+
+    return inflatedArea;
+}
+
+std::pmr::vector<Position::Index> MapInstance::BinaryOccupancyMap::getInflatedArea(const std::vector<Position::Index> &_rootArea,
+                                                                                   const double &_inflation_radius,
+                                                                                   InflationWorkspace &_workspace,
+                                                                                   std::pmr::memory_resource *_resource) const
+{
+    std::pmr::vector<Position::Index> inflatedArea(_resource);
+    collectInflatedArea(_rootArea, _inflation_radius, _workspace, inflatedArea);
+
+    return inflatedArea;
+}
+
+template <typename IndexList>
+void MapInstance::BinaryOccupancyMap::collectInflatedArea(const std::vector<Position::Index> &_rootArea,
+                                                          const double &_inflation_radius,
+                                                          InflationWorkspace &_workspace,
+                                                          IndexList &_inflatedArea) const
 {
     try
     {
@@ -26,115 +84,289 @@ std::vector<Position::Index> MapInstance::BinaryOccupancyMap::getInflatedArea(co
         std::abort();
     }
 
-    seen_.clear();
-    seen_.resize(property_.width_, std::vector<bool>(property_.height_, false));
-    while (not(inflation_queue_.empty()))
-        inflation_queue_.pop();
-
-    for (const auto &idx : _rootArea)
+    MULTIBOT_PROFILE_SCOPE("BinaryOccupancyMap::getInflatedArea");
     {
-        MapInstance::Cell rootCell = mapData_[idx.x_][idx.y_];
-        rootCell.obstacle_coord_ = mapData_[idx.x_][idx.y_].coord_;
+        MULTIBOT_PROFILE_SCOPE("BinaryOccupancyMap::getInflatedArea/reset");
 
-        enqueue(rootCell, _inflation_radius);
+        // Only cells within the enqueue() margin of a root can be reached
+        const int reach = static_cast<int>((_inflation_radius + std::sqrt(2) * property_.resolution_ + 1e-8) / property_.resolution_) + 1;
+        int minX = property_.width_, minY = property_.height_, maxX = -1, maxY = -1;
+        for (const auto &idx : _rootArea)
+        {
+            if (isOutofMap(idx))
+                continue;
+            minX = std::min(minX, idx.x_);
+            minY = std::min(minY, idx.y_);
+            maxX = std::max(maxX, idx.x_);
+            maxY = std::max(maxY, idx.y_);
+        }
+        if (maxX < 0)
+            return;
+
+        minX = std::max(0, minX - reach);
+        minY = std::max(0, minY - reach);
+        maxX = std::min(property_.width_ - 1, maxX + reach);
+        maxY = std::min(property_.height_ - 1, maxY + reach);
+        _workspace.begin(minX, minY, maxX - minX + 1, maxY - minY + 1);
     }
 
-    std::vector<Position::Index> inflatedArea;
-    inflatedArea.clear();
-    while (not(inflation_queue_.empty()))
+    auto &queue = _workspace.queue_;
+    for (const auto &idx : _rootArea)
     {
-        const MapInstance::Cell &current_cell = inflation_queue_.top();
-        inflatedArea.push_back(current_cell.idx_);
+        if (not(isOutofMap(idx)))
+            enqueue(_workspace, idx, idx, _inflation_radius);
+    }
 
-        if (current_cell.idx_.x_ > 0)
-        {
-            MapInstance::Cell neighbor_cell = current_cell;
-            neighbor_cell.idx_.x_ = current_cell.idx_.x_ - 1;
-            neighbor_cell.coord_.x_ = property_.origin_.x_ + neighbor_cell.idx_.x_ * property_.resolution_;
-            neighbor_cell.coord_.y_ = property_.origin_.y_ + neighbor_cell.idx_.y_ * property_.resolution_;
-            enqueue(neighbor_cell, _inflation_radius);
-        }
-        if (current_cell.idx_.y_ > 0)
-        {
-            MapInstance::Cell neighbor_cell = current_cell;
-            neighbor_cell.idx_.y_ = current_cell.idx_.y_ - 1;
-            neighbor_cell.coord_.x_ = property_.origin_.x_ + neighbor_cell.idx_.x_ * property_.resolution_;
-            neighbor_cell.coord_.y_ = property_.origin_.y_ + neighbor_cell.idx_.y_ * property_.resolution_;
-            enqueue(neighbor_cell, _inflation_radius);
-        }
-        if (current_cell.idx_.x_ < property_.width_ - 1)
-        {
-            MapInstance::Cell neighbor_cell = current_cell;
-            neighbor_cell.idx_.x_ = current_cell.idx_.x_ + 1;
-            neighbor_cell.coord_.x_ = property_.origin_.x_ + neighbor_cell.idx_.x_ * property_.resolution_;
-            neighbor_cell.coord_.y_ = property_.origin_.y_ + neighbor_cell.idx_.y_ * property_.resolution_;
-            enqueue(neighbor_cell, _inflation_radius);
-        }
-        if (current_cell.idx_.y_ < property_.height_ - 1)
-        {
-            MapInstance::Cell neighbor_cell = current_cell;
-            neighbor_cell.idx_.y_ = current_cell.idx_.y_ + 1;
-            neighbor_cell.coord_.x_ = property_.origin_.x_ + neighbor_cell.idx_.x_ * property_.resolution_;
-            neighbor_cell.coord_.y_ = property_.origin_.y_ + neighbor_cell.idx_.y_ * property_.resolution_;
-            enqueue(neighbor_cell, _inflation_radius);
-        }
+    while (not(queue.empty()))
+    {
+        std::pop_heap(queue.begin(), queue.end());
+        const InflationWorkspace::InflationEntry current = queue.back();
+        queue.pop_back();
+        _inflatedArea.push_back(current.idx_);
 
-        inflation_queue_.pop();
+        const Position::Index &idx = current.idx_;
+        if (idx.x_ > 0)
+            enqueue(_workspace, Position::Index(idx.x_ - 1, idx.y_), current.obstacle_idx_, _inflation_radius);
+        if (idx.y_ > 0)
+            enqueue(_workspace, Position::Index(idx.x_, idx.y_ - 1), current.obstacle_idx_, _inflation_radius);
+        if (idx.x_ < property_.width_ - 1)
+            enqueue(_workspace, Position::Index(idx.x_ + 1, idx.y_), current.obstacle_idx_, _inflation_radius);
+        if (idx.y_ < property_.height_ - 1)
+            enqueue(_workspace, Position::Index(idx.x_, idx.y_ + 1), current.obstacle_idx_, _inflation_radius);
     }
+    MULTIBOT_PROFILE_HISTOGRAM("BinaryOccupancyMap::getInflatedArea cells", _inflatedArea.size());
+}
 
-    return inflatedArea;
+std::vector<std::vector<Position::Index>> MapInstance::BinaryOccupancyMap::getInflatedAreas(const std::vector<std::vector<Position::Index>> &_rootAreas,
+                                                                                            const double &_inflation_radius) const
+{
+    // Each pool thread expands with its own thread-local workspace
+    std::vector<std::vector<Position::Index>> inflatedAreas(_rootAreas.size());
+    MAPF_Util::Parallel::parallelFor(0, _rootAreas.size(), [&](std::size_t _begin, std::size_t _end, unsigned int)
+    {
+        for (std::size_t i = _begin; i < _end; ++i)
+            inflatedAreas[i] = getInflatedArea(_rootAreas[i], _inflation_radius);
+    });
+
+    return inflatedAreas;
 }
 
-std::vector<std::vector<MapInstance::Cell>> MapInstance::BinaryOccupancyMap::inflate(const double &_inflation_radius)
+const MapInstance::BitGrid &MapInstance::BinaryOccupancyMap::inflate(const double &_inflation_radius, InflationMode _mode)
 {
+    MULTIBOT_PROFILE_SCOPE("BinaryOccupancyMap::inflate");
     property_.inflation_radius_ = _inflation_radius;
+
+    if (_mode == InflationMode::EDT)
+    {
+        if (distance_field_dirty_ or distance_field_.empty())
+            computeDistanceField();
+        distance_field_.threshold(inflationThreshold(_inflation_radius), inflated_mapData_);
+
+        return inflated_mapData_;
+    }
+
     inflated_mapData_ = mapData_;
 
+    // A whole-map expansion; a local workspace frees its stamps afterwards
+    InflationWorkspace workspace;
     std::vector<Position::Index> occupiedCell_Indexes;
     occupiedCell_Indexes.clear();
-    for (const auto &row : mapData_)
+    mapData_.forEachSet([&occupiedCell_Indexes](int _x, int _y)
+                        { occupiedCell_Indexes.emplace_back(_x, _y); });
+    occupiedCell_Indexes = getInflatedArea(occupiedCell_Indexes, _inflation_radius, workspace);
+
+    for (const auto &idx : occupiedCell_Indexes)
+        inflated_mapData_.set(idx.x_, idx.y_, true);
+
+    return inflated_mapData_;
+}
+
+const MapInstance::InflatedView &MapInstance::BinaryOccupancyMap::inflatedView(const double &_inflation_radius)
+{
+    if (distance_field_dirty_ or distance_field_.empty())
+        computeDistanceField();
+
+    const std::uint32_t threshold = inflationThreshold(_inflation_radius);
+    auto view = inflated_views_.find(threshold);
+    if (view == inflated_views_.end())
+        view = inflated_views_.emplace(threshold, InflatedView(distance_field_, threshold, _inflation_radius)).first;
+
+    return view->second;
+}
+
+const MapInstance::ClearanceField &MapInstance::BinaryOccupancyMap::clearanceField()
+{
+    if (distance_field_dirty_ or distance_field_.empty())
+        computeDistanceField();
+
+    if (clearance_field_dirty_)
+    {
+        clearance_field_.compute(distance_field_, property_.origin_, property_.resolution_);
+        clearance_field_dirty_ = false;
+    }
+
+    return clearance_field_;
+}
+
+void MapInstance::BinaryOccupancyMap::computeDistanceField()
+{
+    MULTIBOT_PROFILE_SCOPE("BinaryOccupancyMap::computeDistanceField");
+    distance_field_.compute(mapData_);
+    distance_field_dirty_ = false;
+    clearance_field_dirty_ = true;
+}
+
+void MapInstance::BinaryOccupancyMap::setDistanceField(const DistanceField &_distance_field)
+{
+    try
+    {
+        if (_distance_field.width() != property_.width_ or _distance_field.height() != property_.height_)
+            throw _distance_field.width();
+    }
+    catch (const int &_invalid_width)
+    {
+        std::cerr << "[Error] BinaryOccupancyMap::setDistanceField(): "
+                  << "Distance field size " << _invalid_width << " x " << _distance_field.height()
+                  << " does not match the map" << std::endl;
+        std::abort();
+    }
+
+    distance_field_ = _distance_field;
+    distance_field_dirty_ = false;
+    clearance_field_dirty_ = true;
+}
+
+std::vector<Position::Index> MapInstance::BinaryOccupancyMap::markOccupied(const Position::Index &_idx)
+{
+    if (mapData_.get(_idx.x_, _idx.y_))
+        return std::vector<Position::Index>();
+
+    mapData_.set(_idx.x_, _idx.y_, true);
+    if (distance_field_dirty_ or distance_field_.empty())
+        return std::vector<Position::Index>();
+
+    distance_field_.setObstacle(_idx.x_, _idx.y_);
+
+    return repairInflation();
+}
+
+std::vector<Position::Index> MapInstance::BinaryOccupancyMap::markFree(const Position::Index &_idx)
+{
+    if (not(mapData_.get(_idx.x_, _idx.y_)))
+        return std::vector<Position::Index>();
+
+    mapData_.set(_idx.x_, _idx.y_, false);
+    if (distance_field_dirty_ or distance_field_.empty())
+        return std::vector<Position::Index>();
+
+    distance_field_.removeObstacle(_idx.x_, _idx.y_);
+
+    return repairInflation();
+}
+
+std::vector<Position::Index> MapInstance::BinaryOccupancyMap::repairInflation()
+{
+    MULTIBOT_PROFILE_SCOPE("BinaryOccupancyMap::repairInflation");
+    std::vector<std::int32_t> changedCells;
+    distance_field_.update(changedCells);
+    MULTIBOT_PROFILE_HISTOGRAM("BinaryOccupancyMap::repairInflation cells", changedCells.size());
+    if (not(clearance_field_dirty_))
+        clearance_field_.update(distance_field_, changedCells);
+
+    std::vector<Position::Index> flippedCells;
+    if (std::isnan(property_.inflation_radius_))
+        return flippedCells;
+
+    const std::uint32_t threshold = inflationThreshold(property_.inflation_radius_);
+    for (const auto &cell : changedCells)
     {
-        for (const auto &cell : row)
+        const int x = cell % property_.width_;
+        const int y = cell / property_.width_;
+        const bool inflated = distance_field_.squaredDistance(x, y) <= threshold;
+        if (inflated != inflated_mapData_.get(x, y))
         {
-            if (cell.occupied_)
-                occupiedCell_Indexes.push_back(cell.idx_);
+            inflated_mapData_.set(x, y, inflated);
+            flippedCells.emplace_back(x, y);
         }
     }
-    occupiedCell_Indexes = getInflatedArea(occupiedCell_Indexes, _inflation_radius);
-
-    for (const auto &idx : occupiedCell_Indexes)
-        inflated_mapData_[idx.x_][idx.y_].occupied_ = true;
 
-    return inflated_mapData_;
+    return flippedCells;
 }
 
 bool MapInstance::BinaryOccupancyMap::isOutofMap(const MapInstance::Cell &_cell) const
 {
-    return not(_cell.idx_.x_ >= 0 and _cell.idx_.x_ < property_.width_ and
-               _cell.idx_.y_ >= 0 and _cell.idx_.y_ < property_.height_);
+    return isOutofMap(_cell.idx_);
+}
+
+bool MapInstance::BinaryOccupancyMap::isOutofMap(const Position::Index &_idx) const
+{
+    return not(_idx.x_ >= 0 and _idx.x_ < property_.width_ and
+               _idx.y_ >= 0 and _idx.y_ < property_.height_);
+}
+
+double MapInstance::BinaryOccupancyMap::distanceLookup(const Position::Index &_idx, const Position::Index &_obstacle_idx) const
+{
+    const double deltaX = (_idx.x_ - _obstacle_idx.x_) * property_.resolution_;
+    const double deltaY = (_idx.y_ - _obstacle_idx.y_) * property_.resolution_;
+
+    return std::sqrt(deltaX * deltaX + deltaY * deltaY);
 }
 
-double MapInstance::BinaryOccupancyMap::distanceLookup(const MapInstance::Cell &_cell) const
+void MapInstance::BinaryOccupancyMap::enqueue(InflationWorkspace &_workspace, const Position::Index &_idx,
+                                              const Position::Index &_obstacle_idx, const double &_inflation_ratdius) const
 {
-    return (Position::getDistance(_cell.coord_, _cell.obstacle_coord_));
+    const double distance = distanceLookup(_idx, _obstacle_idx);
+    if (not(distance > _inflation_ratdius + std::sqrt(2) * property_.resolution_ + 1e-8) and _workspace.visit(_idx))
+    {
+        MULTIBOT_PROFILE_COUNT("BinaryOccupancyMap inflation queue pushes", 1);
+        _workspace.queue_.push_back(InflationWorkspace::InflationEntry{distance, _idx, _obstacle_idx});
+        std::push_heap(_workspace.queue_.begin(), _workspace.queue_.end());
+    }
 }
 
-void MapInstance::BinaryOccupancyMap::enqueue(const MapInstance::Cell &_cell, const double &_inflation_ratdius)
+void MapInstance::InflationWorkspace::begin(int _x, int _y, int _width, int _height)
 {
-    if (not(seen_[_cell.idx_.x_][_cell.idx_.y_]) and
-        not(distanceLookup(_cell) > _inflation_ratdius  + std::sqrt(2) * property_.resolution_ + 1e-8))
+    const std::size_t cells = static_cast<std::size_t>(_width) * _height;
+    if (stamps_.size() < cells)
+        stamps_.resize(cells, 0);
+
+    // Stale stamps from earlier boxes never equal a fresh epoch, until it wraps
+    if (++epoch_ == 0)
     {
-        seen_[_cell.idx_.x_][_cell.idx_.y_] = true;
+        std::fill(stamps_.begin(), stamps_.end(), 0);
+        epoch_ = 1;
+    }
 
-        MapInstance::Cell newCell = _cell;
+    origin_x_ = _x;
+    origin_y_ = _y;
+    width_ = _width;
+    queue_.clear();
+}
 
-        newCell.distance_ = distanceLookup(_cell);
-        newCell.obstacle_coord_ = _cell.obstacle_coord_;
-        inflation_queue_.push(newCell);
+std::uint32_t MapInstance::BinaryOccupancyMap::inflationThreshold(const double &_inflation_radius) const
+{
+    try
+    {
+        if (std::isnan(_inflation_radius) or _inflation_radius < 0)
+            throw _inflation_radius;
+    }
+    catch (const double &_invalid_inflation_radius)
+    {
+        std::cerr << "[Error] BinaryOccupancyMap::inflationThreshold(): "
+                  << "Invalid Inflation Radius: " << _invalid_inflation_radius << std::endl;
+        std::abort();
     }
+
+    return getInflationThreshold(_inflation_radius, property_.resolution_);
 }
 
 double MapInstance::getDistance(const Cell &_first, const Cell &_second)
 {
     return Position::getDistance(_first.coord_, _second.coord_);
+}
+
+std::uint32_t MapInstance::getInflationThreshold(const double &_inflation_radius, const double &_resolution)
+{
+    // Same margin as the brushfire expansion in BinaryOccupancyMap::enqueue()
+    return DistanceField::squaredThreshold(_inflation_radius + std::sqrt(2) * _resolution + 1e-8, _resolution);
 }
\ No newline at end of file
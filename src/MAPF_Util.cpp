@@ -2,14 +2,6 @@
 
 using namespace MAPF_Util;
 
-Position::Coordinates &Position::Coordinates::operator=(const Position::Coordinates &_other)
-{
-    this->x_    = _other.x_;
-    this->y_    = _other.y_;
-
-    return *this;
-}
-
 Position::Coordinates &Position::Coordinates::operator=(const std::vector<double> &_other)
 {
     this->x_    = _other[CARTESIAN::x];
@@ -103,6 +95,8 @@ double Position::Coordinates::norm()
 double Position::getDistance(const Position::Coordinates &_first,
                              const Position::Coordinates &_second)
 {
+    MULTIBOT_PROFILE_COUNT("Position::getDistance", 1);
+
     double deltaX   = _first.x_ - _second.x_;
     double deltaY   = _first.y_ - _second.y_;
 
@@ -118,6 +112,8 @@ double Position::crossProduct(const Position::Coordinates &_first,
 double Position::getDistance(const Position::Pose &_first,
                              const Position::Pose &_second)
 {
+    MULTIBOT_PROFILE_COUNT("Position::getDistance", 1);
+
     double deltaX   = _first.component_.x - _second.component_.x;
     double deltaY   = _first.component_.y - _second.component_.y;
 
@@ -127,9 +123,143 @@ double Position::getDistance(const Position::Pose &_first,
 double Position::getAngleDiff(const Position::Pose &_first,
                                     const Position::Pose &_second)
 {
-    double angleDiff    = std::fabs(_first.component_.theta - _second.component_.theta);
-    while(angleDiff - M_PI > 1e-8)
-        angleDiff   = std::fabs(angleDiff - 2 * M_PI);
-    
-    return angleDiff;
-}
\ No newline at end of file
+    MULTIBOT_PROFILE_COUNT("Position::getAngleDiff", 1);
+
+    return std::fabs(normalizeAngle(_first.component_.theta - _second.component_.theta));
+}
+
+double Position::normalizeAngle(double _angle)
+{
+    // Round-half-even, as in std::remainder, so the batch kernels match bit for bit
+    return _angle - 2 * M_PI * std::nearbyint(_angle / (2 * M_PI));
+}
+
+template <typename Allocator>
+bool Time::BasicTimeLine<Allocator>::isSafe(const Time::TimePoint &_time) const
+{
+    return findSafeInterval(_time) != interval_list_.end();
+}
+
+template <typename Allocator>
+typename Time::BasicTimeLine<Allocator>::IntervalList::const_iterator Time::BasicTimeLine<Allocator>::findSafeInterval(const Time::TimePoint &_time) const
+{
+    // First interval ending after _time contains it
+    auto interval = std::upper_bound(interval_list_.begin(), interval_list_.end(), _time,
+                                     [](const TimePoint &_t, const TimeInterval &_interval)
+                                     { return _t < _interval.endTime_; });
+    if (interval == interval_list_.end() or interval->startTime_ > _time or not(interval->is_safe_))
+        return interval_list_.end();
+
+    return interval;
+}
+
+template <typename Allocator>
+typename Time::BasicTimeLine<Allocator>::IntervalList::const_iterator Time::BasicTimeLine<Allocator>::findNextSafeInterval(const Time::TimePoint &_time) const
+{
+    auto interval = std::upper_bound(interval_list_.begin(), interval_list_.end(), _time,
+                                     [](const TimePoint &_t, const TimeInterval &_interval)
+                                     { return _t < _interval.startTime_; });
+    while (interval != interval_list_.end() and not(interval->is_safe_))
+        ++interval;
+
+    return interval;
+}
+
+template <typename Allocator>
+void Time::BasicTimeLine<Allocator>::insertReservation(const Time::TimePoint &_startTime, const Time::TimePoint &_endTime)
+{
+    assign(_startTime, _endTime, false);
+}
+
+template <typename Allocator>
+void Time::BasicTimeLine<Allocator>::removeReservation(const Time::TimePoint &_startTime, const Time::TimePoint &_endTime)
+{
+    assign(_startTime, _endTime, true);
+}
+
+template <typename Allocator>
+void Time::BasicTimeLine<Allocator>::assign(const Time::TimePoint &_startTime, const Time::TimePoint &_endTime, bool _is_safe)
+{
+    if (not(_startTime < _endTime))
+        return;
+
+    // [first, last) are the intervals overlapping [_startTime, _endTime)
+    auto first = std::upper_bound(interval_list_.begin(), interval_list_.end(), _startTime,
+                                  [](const TimePoint &_t, const TimeInterval &_interval)
+                                  { return _t < _interval.endTime_; });
+    auto last = std::lower_bound(first, interval_list_.end(), _endTime,
+                                 [](const TimeInterval &_interval, const TimePoint &_t)
+                                 { return _interval.startTime_ < _t; });
+    if (first == last)
+        return;
+
+    TimeInterval replacement[3];
+    int count = 0;
+    if (first->startTime_ < _startTime)
+        replacement[count++] = TimeInterval(first->startTime_, _startTime, first->is_safe_);
+    replacement[count++] = TimeInterval(std::max(_startTime, first->startTime_),
+                                        std::min(_endTime, (last - 1)->endTime_), _is_safe);
+    if ((last - 1)->endTime_ > _endTime)
+        replacement[count++] = TimeInterval(_endTime, (last - 1)->endTime_, (last - 1)->is_safe_);
+
+    // Merge with neighbours of the same kind so intervals keep alternating
+    if (first != interval_list_.begin() and (first - 1)->is_safe_ == replacement[0].is_safe_)
+    {
+        --first;
+        replacement[0].startTime_ = first->startTime_;
+    }
+    if (last != interval_list_.end() and last->is_safe_ == replacement[count - 1].is_safe_)
+    {
+        replacement[count - 1].endTime_ = last->endTime_;
+        ++last;
+    }
+
+    int merged = 0;
+    for (int i = 1; i < count; ++i)
+    {
+        if (replacement[merged].is_safe_ == replacement[i].is_safe_)
+            replacement[merged].endTime_ = replacement[i].endTime_;
+        else
+            replacement[++merged] = replacement[i];
+    }
+    count = merged + 1;
+
+    auto position = interval_list_.erase(first, last);
+    interval_list_.insert(position, replacement, replacement + count);
+}
+
+template struct Time::BasicTimeLine<std::allocator<Time::TimeInterval>>;
+template struct Time::BasicTimeLine<std::pmr::polymorphic_allocator<Time::TimeInterval>>;
+
+template <typename Allocator>
+std::size_t Traj::BasicSingleTraj<Allocator>::locate(const Time::TimePoint &_time) const
+{
+    // Last pair whose first node has been reached by _time
+    auto pair = std::upper_bound(nodes_.begin(), nodes_.end(), _time,
+                                 [](const Time::TimePoint &_t, const std::pair<Node, Node> &_nodePair)
+                                 { return _t < _nodePair.first.arrival_time_; });
+    return pair == nodes_.begin() ? 0 : pair - nodes_.begin() - 1;
+}
+
+template <typename Allocator>
+Position::Pose Traj::BasicSingleTraj<Allocator>::interpolate(std::size_t _pair, const Time::TimePoint &_time) const
+{
+    if (nodes_.empty())
+        return Position::Pose();
+
+    const auto &[from, to] = nodes_[_pair];
+    if (_time <= from.departure_time_)
+        return from.pose_;
+    if (_time >= to.arrival_time_)
+        return to.pose_;
+
+    const double ratio = (_time - from.departure_time_) / (to.arrival_time_ - from.departure_time_);
+    const double turn = std::remainder(to.pose_.component_.theta - from.pose_.component_.theta, 2 * M_PI);
+
+    return Position::Pose(from.pose_.component_.x + ratio * (to.pose_.component_.x - from.pose_.component_.x),
+                          from.pose_.component_.y + ratio * (to.pose_.component_.y - from.pose_.component_.y),
+                          std::remainder(from.pose_.component_.theta + ratio * turn, 2 * M_PI));
+}
+
+template struct Traj::BasicSingleTraj<std::allocator<std::pair<Traj::Node, Traj::Node>>>;
+template struct Traj::BasicSingleTraj<std::pmr::polymorphic_allocator<std::pair<Traj::Node, Traj::Node>>>;
\ No newline at end of file
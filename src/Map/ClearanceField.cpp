@@ -0,0 +1,77 @@
+#include "multibot_util/Map/ClearanceField.hpp"
+
+using namespace Instance;
+
+namespace
+{
+    void checkSize(const char *_caller, std::size_t _size, std::size_t _required)
+    {
+        try
+        {
+            if (_size < _required)
+                throw _size;
+        }
+        catch (const std::size_t &_invalid_size)
+        {
+            std::cerr << "[Error] ClearanceField::" << _caller << "(): "
+                      << "Array of " << _invalid_size << " elements for " << _required << " inputs" << std::endl;
+            std::abort();
+        }
+    }
+} // namespace
+
+void MapInstance::ClearanceField::compute(const DistanceField &_field, const MAPF_Util::Position::Coordinates &_origin,
+                                          double _resolution)
+{
+    MULTIBOT_PROFILE_SCOPE("ClearanceField::compute");
+    width_ = _field.width();
+    height_ = _field.height();
+    last_x_ = std::max(0, width_ - 2);
+    last_y_ = std::max(0, height_ - 2);
+    step_x_ = width_ > 1 ? 1 : 0;
+    step_y_ = height_ > 1 ? static_cast<std::size_t>(width_) : 0;
+    origin_ = _origin;
+    resolution_ = _resolution;
+    inverse_resolution_ = 1.0 / _resolution;
+    max_clearance_ = std::hypot(width_, height_) * _resolution;
+
+    clearance_.resize(static_cast<std::size_t>(width_) * height_);
+    const std::uint32_t *squaredDistance = _field.data();
+    for (std::size_t i = 0; i < clearance_.size(); ++i)
+        clearance_[i] = toClearance(squaredDistance[i]);
+}
+
+void MapInstance::ClearanceField::update(const DistanceField &_field, const std::vector<std::int32_t> &_changed)
+{
+    const std::uint32_t *squaredDistance = _field.data();
+    for (const auto &cell : _changed)
+        clearance_[cell] = toClearance(squaredDistance[cell]);
+}
+
+void MapInstance::ClearanceField::clearances(std::span<const MAPF_Util::Position::Coordinates> _coords,
+                                             std::span<double> _clearances) const
+{
+    checkSize("clearances", _clearances.size(), _coords.size());
+
+    for (std::size_t i = 0; i < _coords.size(); ++i)
+        _clearances[i] = clearance(_coords[i]);
+}
+
+void MapInstance::ClearanceField::clearances(std::span<const MAPF_Util::Position::Coordinates> _coords,
+                                             std::span<double> _clearances,
+                                             std::span<MAPF_Util::Position::Coordinates> _gradients) const
+{
+    checkSize("clearances", _clearances.size(), _coords.size());
+    checkSize("clearances", _gradients.size(), _coords.size());
+
+    for (std::size_t i = 0; i < _coords.size(); ++i)
+        _clearances[i] = clearance(_coords[i], _gradients[i]);
+}
+
+float MapInstance::ClearanceField::toClearance(std::uint32_t _squared_distance) const
+{
+    if (_squared_distance == DistanceField::INF)
+        return static_cast<float>(max_clearance_);
+
+    return static_cast<float>(std::sqrt(static_cast<double>(_squared_distance)) * resolution_);
+}
\ No newline at end of file
@@ -0,0 +1,344 @@
+#include "multibot_util/Map/DistanceField.hpp"
+
+#include <cmath>
+
+#include "multibot_util/Util/Parallel.hpp"
+
+using namespace Instance;
+
+namespace
+{
+    // Columns are transformed in blocks so that the gather/scatter between the
+    // row-major field and the per-column scratch reads whole cache lines.
+    constexpr int COLUMN_BLOCK = 16;
+
+    // Lower envelope of parabolas (Felzenszwalb & Huttenlocher). Infinite
+    // samples contribute no parabola. _a receives the sample owning each output.
+    void transform1D(const std::uint32_t *_f, std::uint32_t *_d, int *_a, int _n,
+                     std::vector<int> &_v, std::vector<double> &_z)
+    {
+        constexpr std::uint32_t INF = MapInstance::DistanceField::INF;
+
+        int k = -1;
+        for (int q = 0; q < _n; ++q)
+        {
+            if (_f[q] == INF)
+                continue;
+
+            if (k < 0)
+            {
+                k = 0;
+                _v[0] = q;
+                _z[0] = -std::numeric_limits<double>::infinity();
+                _z[1] = std::numeric_limits<double>::infinity();
+                continue;
+            }
+
+            const double fq = static_cast<double>(_f[q]) + static_cast<double>(q) * q;
+            double s = 0.0;
+            while (true)
+            {
+                const int vk = _v[k];
+                s = (fq - (static_cast<double>(_f[vk]) + static_cast<double>(vk) * vk)) / (2.0 * (q - vk));
+                if (s > _z[k])
+                    break;
+                --k;
+            }
+
+            ++k;
+            _v[k] = q;
+            _z[k] = s;
+            _z[k + 1] = std::numeric_limits<double>::infinity();
+        }
+
+        if (k < 0)
+        {
+            std::fill(_d, _d + _n, INF);
+            std::fill(_a, _a + _n, -1);
+            return;
+        }
+
+        k = 0;
+        for (int q = 0; q < _n; ++q)
+        {
+            while (_z[k + 1] < q)
+                ++k;
+
+            const std::int64_t delta = q - _v[k];
+            _d[q] = static_cast<std::uint32_t>(delta * delta + _f[_v[k]]);
+            _a[q] = _v[k];
+        }
+    }
+} // namespace
+
+void MapInstance::DistanceField::compute(const BitGrid &_occupancy)
+{
+    width_  = _occupancy.width();
+    height_ = _occupancy.height();
+    squared_distance_.resize(static_cast<std::size_t>(width_) * height_);
+    obstacle_.resize(squared_distance_.size());
+
+    MAPF_Util::Parallel::parallelFor(0, height_, [this, &_occupancy](std::size_t _begin, std::size_t _end, unsigned int)
+                                     { computeRows(_occupancy, static_cast<int>(_begin), static_cast<int>(_end)); }, 64);
+
+    const int blocks = (width_ + COLUMN_BLOCK - 1) / COLUMN_BLOCK;
+    MAPF_Util::Parallel::parallelFor(0, blocks, [this](std::size_t _begin, std::size_t _end, unsigned int)
+                                     { computeColumns(static_cast<int>(_begin) * COLUMN_BLOCK,
+                                                      std::min(width_, static_cast<int>(_end) * COLUMN_BLOCK)); }, 4);
+}
+
+void MapInstance::DistanceField::computeRows(const BitGrid &_occupancy, int _rowBegin, int _rowEnd)
+{
+    for (int y = _rowBegin; y < _rowEnd; ++y)
+    {
+        std::uint32_t *distanceRow = squared_distance_.mutableData() + static_cast<std::size_t>(y) * width_;
+        std::int32_t *obstacleRow = obstacle_.mutableData() + static_cast<std::size_t>(y) * width_;
+
+        // Forward and backward sweeps give the nearest obstacle column in this row.
+        std::int32_t last = -1;
+        for (int x = 0; x < width_; ++x)
+        {
+            if (_occupancy.get(x, y))
+                last = x;
+            distanceRow[x] = last < 0 ? INF : static_cast<std::uint32_t>(x - last);
+            obstacleRow[x] = last;
+        }
+
+        last = -1;
+        for (int x = width_ - 1; x >= 0; --x)
+        {
+            if (_occupancy.get(x, y))
+                last = x;
+            if (last >= 0 and static_cast<std::uint32_t>(last - x) < distanceRow[x])
+            {
+                distanceRow[x] = static_cast<std::uint32_t>(last - x);
+                obstacleRow[x] = last;
+            }
+            if (distanceRow[x] != INF)
+                distanceRow[x] = distanceRow[x] * distanceRow[x];
+        }
+    }
+}
+
+void MapInstance::DistanceField::computeColumns(int _columnBegin, int _columnEnd)
+{
+    std::uint32_t *distance = squared_distance_.mutableData();
+    std::int32_t *obstacle = obstacle_.mutableData();
+
+    std::vector<std::uint32_t> f(static_cast<std::size_t>(COLUMN_BLOCK) * height_);
+    std::vector<std::int32_t> columnObstacle(static_cast<std::size_t>(COLUMN_BLOCK) * height_);
+    std::vector<std::uint32_t> d(height_);
+    std::vector<int> a(height_);
+    std::vector<int> v(height_);
+    std::vector<double> z(height_ + 1);
+
+    for (int blockBegin = _columnBegin; blockBegin < _columnEnd; blockBegin += COLUMN_BLOCK)
+    {
+        const int blockWidth = std::min(COLUMN_BLOCK, _columnEnd - blockBegin);
+
+        for (int y = 0; y < height_; ++y)
+        {
+            const std::size_t offset = static_cast<std::size_t>(y) * width_ + blockBegin;
+            for (int c = 0; c < blockWidth; ++c)
+            {
+                f[static_cast<std::size_t>(c) * height_ + y] = distance[offset + c];
+                columnObstacle[static_cast<std::size_t>(c) * height_ + y] = obstacle[offset + c];
+            }
+        }
+
+        for (int c = 0; c < blockWidth; ++c)
+        {
+            std::uint32_t *column = f.data() + static_cast<std::size_t>(c) * height_;
+            std::int32_t *obstacleColumn = columnObstacle.data() + static_cast<std::size_t>(c) * height_;
+            transform1D(column, d.data(), a.data(), height_, v, z);
+
+            // Row pass stored the obstacle column; combine it with the winning row.
+            for (int y = 0; y < height_; ++y)
+                a[y] = a[y] < 0 ? -1 : a[y] * width_ + obstacleColumn[a[y]];
+            std::copy(d.begin(), d.end(), column);
+            std::copy(a.begin(), a.end(), obstacleColumn);
+        }
+
+        for (int y = 0; y < height_; ++y)
+        {
+            const std::size_t offset = static_cast<std::size_t>(y) * width_ + blockBegin;
+            for (int c = 0; c < blockWidth; ++c)
+            {
+                distance[offset + c] = f[static_cast<std::size_t>(c) * height_ + y];
+                obstacle[offset + c] = columnObstacle[static_cast<std::size_t>(c) * height_ + y];
+            }
+        }
+    }
+}
+
+void MapInstance::DistanceField::threshold(const std::uint32_t &_max_squared_distance, BitGrid &_result) const
+{
+    if (_result.width() != width_ or _result.height() != height_)
+        _result.resize(width_, height_);
+
+    MAPF_Util::Parallel::parallelFor(0, height_, [this, &_result, &_max_squared_distance](std::size_t _begin, std::size_t _end, unsigned int)
+    {
+        for (int y = static_cast<int>(_begin); y < static_cast<int>(_end); ++y)
+        {
+            const std::uint32_t *distanceRow = row(y);
+            BitGrid::Word *resultRow = _result.row(y);
+            for (std::size_t w = 0; w < _result.wordsPerRow(); ++w)
+            {
+                const int xBegin = static_cast<int>(w) * BitGrid::WORD_BITS;
+                const int xEnd = std::min(width_, xBegin + BitGrid::WORD_BITS);
+
+                BitGrid::Word word = 0;
+                for (int x = xBegin; x < xEnd; ++x)
+                    word |= BitGrid::Word(distanceRow[x] <= _max_squared_distance) << (x - xBegin);
+                resultRow[w] = word;
+            }
+        }
+    }, 64);
+}
+
+std::uint32_t MapInstance::DistanceField::squaredThreshold(const double &_radius, const double &_resolution)
+{
+    const double radiusInCells = _radius / _resolution;
+    const double squared = radiusInCells * radiusInCells;
+    if (squared >= static_cast<double>(INF))
+        return INF - 1;
+
+    return static_cast<std::uint32_t>(std::floor(squared + 1e-9));
+}
+
+double MapInstance::DistanceField::distance(int _x, int _y, const double &_resolution) const
+{
+    const std::uint32_t squared = squaredDistance(_x, _y);
+    if (squared == INF)
+        return std::numeric_limits<double>::infinity();
+
+    return std::sqrt(static_cast<double>(squared)) * _resolution;
+}
+
+void MapInstance::DistanceField::setObstacle(int _x, int _y)
+{
+    const std::int32_t cell = _y * width_ + _x;
+    if (obstacle_[cell] == cell)
+        return;
+
+    obstacle_.mutableData()[cell] = cell;
+    squared_distance_.mutableData()[cell] = 0;
+    open_.emplace(0, cell);
+}
+
+void MapInstance::DistanceField::removeObstacle(int _x, int _y)
+{
+    const std::int32_t cell = _y * width_ + _x;
+    if (obstacle_[cell] != cell)
+        return;
+
+    if (to_raise_.width() != width_ or to_raise_.height() != height_)
+        to_raise_.resize(width_, height_);
+
+    obstacle_.mutableData()[cell] = -1;
+    squared_distance_.mutableData()[cell] = INF;
+    to_raise_.set(_x, _y, true);
+    open_.emplace(0, cell);
+}
+
+void MapInstance::DistanceField::update(std::vector<std::int32_t> &_changed)
+{
+    if (to_raise_.width() != width_ or to_raise_.height() != height_)
+        to_raise_.resize(width_, height_);
+
+    while (not(open_.empty()))
+    {
+        const OpenEntry current = open_.top();
+        open_.pop();
+
+        const std::int32_t cell = current.second;
+        _changed.push_back(cell);
+
+        if (to_raise_.get(cell % width_, cell / width_))
+            raise(cell, _changed);
+        else if (obstacle_[cell] >= 0 and obstacle_[obstacle_[cell]] == obstacle_[cell] and
+                 current.first == squared_distance_[cell])
+            lower(cell, _changed);
+    }
+}
+
+std::uint32_t MapInstance::DistanceField::squaredDistanceTo(std::int32_t _cell, std::int32_t _obstacle) const
+{
+    const std::int64_t deltaX = _cell % width_ - _obstacle % width_;
+    const std::int64_t deltaY = _cell / width_ - _obstacle / width_;
+
+    return static_cast<std::uint32_t>(deltaX * deltaX + deltaY * deltaY);
+}
+
+void MapInstance::DistanceField::lower(std::int32_t _cell, std::vector<std::int32_t> &_changed)
+{
+    const int x = _cell % width_;
+    const int y = _cell / width_;
+    std::uint32_t *distance = squared_distance_.mutableData();
+    std::int32_t *obstacle = obstacle_.mutableData();
+    const std::int32_t source = obstacle[_cell];
+
+    for (int neighborY = std::max(0, y - 1); neighborY <= std::min(height_ - 1, y + 1); ++neighborY)
+    {
+        for (int neighborX = std::max(0, x - 1); neighborX <= std::min(width_ - 1, x + 1); ++neighborX)
+        {
+            const std::int32_t neighbor = neighborY * width_ + neighborX;
+            if (neighbor == _cell or to_raise_.get(neighborX, neighborY))
+                continue;
+
+            const std::uint32_t squared = squaredDistanceTo(neighbor, source);
+            if (squared < distance[neighbor])
+            {
+                distance[neighbor] = squared;
+                obstacle[neighbor] = source;
+                open_.emplace(squared, neighbor);
+                _changed.push_back(neighbor);
+            }
+        }
+    }
+}
+
+void MapInstance::DistanceField::raise(std::int32_t _cell, std::vector<std::int32_t> &_changed)
+{
+    std::uint32_t *distance = squared_distance_.mutableData();
+    std::int32_t *obstacle = obstacle_.mutableData();
+    const int x = _cell % width_;
+    const int y = _cell / width_;
+
+    for (int neighborY = std::max(0, y - 1); neighborY <= std::min(height_ - 1, y + 1); ++neighborY)
+    {
+        for (int neighborX = std::max(0, x - 1); neighborX <= std::min(width_ - 1, x + 1); ++neighborX)
+        {
+            const std::int32_t neighbor = neighborY * width_ + neighborX;
+            const std::int32_t neighborObstacle = obstacle[neighbor];
+            if (neighbor == _cell or neighborObstacle < 0 or to_raise_.get(neighborX, neighborY))
+                continue;
+
+            const std::uint32_t squared = distance[neighbor];
+            if (obstacle[neighborObstacle] != neighborObstacle)
+            {
+                obstacle[neighbor] = -1;
+                distance[neighbor] = INF;
+                to_raise_.set(neighborX, neighborY, true);
+                _changed.push_back(neighbor);
+            }
+            open_.emplace(squared, neighbor);
+        }
+    }
+
+    to_raise_.set(x, y, false);
+}
+
+void MapInstance::DistanceField::borrow(int _width, int _height, std::shared_ptr<const void> _backing,
+                                        const std::uint32_t *_squared_distance, const std::int32_t *_obstacle)
+{
+    width_  = _width;
+    height_ = _height;
+
+    const std::size_t cells = static_cast<std::size_t>(_width) * _height;
+    squared_distance_.borrow(_backing, _squared_distance, cells);
+    obstacle_.borrow(_backing, _obstacle, cells);
+
+    while (not(open_.empty()))
+        open_.pop();
+}
@@ -0,0 +1,232 @@
+#include "multibot_util/Map/HeuristicMap.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "multibot_util/Util/Parallel.hpp"
+
+using namespace Instance;
+
+namespace
+{
+    // Integer step costs for Dial's algorithm; 41 / 29 is just below sqrt(2),
+    // so grid distances are never overestimated
+    constexpr std::uint32_t STRAIGHT_COST = 29;
+    constexpr std::uint32_t DIAGONAL_COST = 41;
+    constexpr std::uint32_t BUCKETS = DIAGONAL_COST + 1;
+    constexpr std::uint32_t UNVISITED = UINT32_MAX;
+
+    // Goals outside the map all share one key; their maps are entirely unreachable
+    std::uint64_t cacheKey(const Position::Index &_goal, std::uint32_t _threshold,
+                           const MapInstance::BinaryOccupancyMap::MapProperty &_property)
+    {
+        const bool inside = _goal.x_ >= 0 and _goal.y_ >= 0 and _goal.x_ < _property.width_ and _goal.y_ < _property.height_;
+        return (static_cast<std::uint64_t>(_threshold) << 32) |
+               (inside ? static_cast<std::uint32_t>(_goal.y_ * _property.width_ + _goal.x_) : UINT32_MAX);
+    }
+} // namespace
+
+std::shared_ptr<MapInstance::HeuristicMap> MapInstance::HeuristicMap::compute(const BitGrid &_blocked,
+                                                                              const BinaryOccupancyMap::MapProperty &_property,
+                                                                              const Position::Index &_goal)
+{
+    auto heuristic = std::make_shared<HeuristicMap>();
+    heuristic->goal_ = _goal;
+    heuristic->origin_ = _property.origin_;
+    heuristic->width_ = _blocked.width();
+    heuristic->height_ = _blocked.height();
+    heuristic->resolution_ = _property.resolution_;
+
+    const int width = heuristic->width_;
+    const int height = heuristic->height_;
+    const std::size_t cells = static_cast<std::size_t>(width) * height;
+    heuristic->cost_.assign(cells, UNREACHABLE);
+    if (_goal.x_ < 0 or _goal.y_ < 0 or _goal.x_ >= width or _goal.y_ >= height)
+        return heuristic;
+
+    // Dial's algorithm: a ring of buckets indexed by path cost
+    std::vector<std::uint32_t> cost(cells, UNVISITED);
+    std::vector<std::int32_t> buckets[BUCKETS];
+    const std::int32_t goalCell = _goal.y_ * width + _goal.x_;
+    cost[goalCell] = 0;
+    buckets[0].push_back(goalCell);
+
+    std::size_t pending = 1;
+    std::uint32_t maxCost = 0;
+    for (std::uint32_t current = 0; pending > 0; ++current)
+    {
+        auto &bucket = buckets[current % BUCKETS];
+        while (not bucket.empty())
+        {
+            const std::int32_t cell = bucket.back();
+            bucket.pop_back();
+            --pending;
+            if (cost[cell] != current)
+                continue;
+            maxCost = current;
+
+            const int x = cell % width;
+            const int y = cell / width;
+            const bool left = x > 0 and not _blocked.get(x - 1, y);
+            const bool right = x + 1 < width and not _blocked.get(x + 1, y);
+            const bool down = y > 0 and not _blocked.get(x, y - 1);
+            const bool up = y + 1 < height and not _blocked.get(x, y + 1);
+
+            const auto relax = [&](std::int32_t _next, std::uint32_t _step)
+            {
+                const std::uint32_t next = current + _step;
+                if (next < cost[_next])
+                {
+                    cost[_next] = next;
+                    buckets[next % BUCKETS].push_back(_next);
+                    ++pending;
+                }
+            };
+
+            if (left)
+                relax(cell - 1, STRAIGHT_COST);
+            if (right)
+                relax(cell + 1, STRAIGHT_COST);
+            if (down)
+                relax(cell - width, STRAIGHT_COST);
+            if (up)
+                relax(cell + width, STRAIGHT_COST);
+            if (left and down and not _blocked.get(x - 1, y - 1))
+                relax(cell - width - 1, DIAGONAL_COST);
+            if (right and down and not _blocked.get(x + 1, y - 1))
+                relax(cell - width + 1, DIAGONAL_COST);
+            if (left and up and not _blocked.get(x - 1, y + 1))
+                relax(cell + width - 1, DIAGONAL_COST);
+            if (right and up and not _blocked.get(x + 1, y + 1))
+                relax(cell + width + 1, DIAGONAL_COST);
+        }
+    }
+
+    // Coarsen the unit only when the longest path does not fit in 16 bits
+    const std::uint32_t scale = std::max<std::uint32_t>(1, (maxCost + UNREACHABLE - 2) / (UNREACHABLE - 1));
+    heuristic->quantum_ = scale * _property.resolution_ / STRAIGHT_COST;
+    for (std::size_t i = 0; i < cells; ++i)
+    {
+        if (cost[i] != UNVISITED)
+            heuristic->cost_[i] = static_cast<std::uint16_t>(cost[i] / scale);
+    }
+
+    return heuristic;
+}
+
+std::shared_ptr<const MapInstance::HeuristicMap> MapInstance::HeuristicCache::get(const Position::Index &_goal,
+                                                                                   const double &_inflation_radius)
+{
+    return get(std::vector<Position::Index>{_goal}, _inflation_radius).front();
+}
+
+std::vector<std::shared_ptr<const MapInstance::HeuristicMap>> MapInstance::HeuristicCache::get(const std::vector<Position::Index> &_goals,
+                                                                                                const double &_inflation_radius)
+{
+    try
+    {
+        if (not map_->hasDistanceField())
+            throw false;
+    }
+    catch (const bool &)
+    {
+        std::cerr << "[Error] HeuristicCache::get(): "
+                  << "The map has no up-to-date distance field; call computeDistanceField() first" << std::endl;
+        std::abort();
+    }
+
+    const std::uint32_t threshold = getInflationThreshold(_inflation_radius, map_->property_.resolution_);
+
+    std::vector<std::shared_ptr<const HeuristicMap>> heuristics(_goals.size());
+    std::vector<std::size_t> missing;
+    std::shared_ptr<const BitGrid> blocked;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        blocked = blockedGrid(threshold);
+
+        std::unordered_set<std::uint64_t> queued;
+        for (std::size_t i = 0; i < _goals.size(); ++i)
+        {
+            const std::uint64_t key = cacheKey(_goals[i], threshold, map_->property_);
+            heuristics[i] = maps_.find(key);
+            if (not(heuristics[i]) and queued.insert(key).second)
+                missing.push_back(i);
+        }
+    }
+
+    // Repeated goals are computed once
+    std::vector<std::shared_ptr<const HeuristicMap>> computed(missing.size());
+    MAPF_Util::Parallel::parallelFor(0, missing.size(), [&](std::size_t _begin, std::size_t _end, unsigned int)
+    {
+        for (std::size_t i = _begin; i < _end; ++i)
+            computed[i] = HeuristicMap::compute(*blocked, map_->property_, _goals[missing[i]]);
+    });
+
+    std::unordered_map<std::uint64_t, std::shared_ptr<const HeuristicMap>> fresh;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (std::size_t i = 0; i < missing.size(); ++i)
+        {
+            const std::uint64_t key = cacheKey(_goals[missing[i]], threshold, map_->property_);
+            maps_.insert(key, computed[i], computed[i]->memoryUsage());
+            fresh.emplace(key, computed[i]);
+        }
+    }
+
+    for (std::size_t i = 0; i < _goals.size(); ++i)
+    {
+        if (not(heuristics[i]))
+            heuristics[i] = fresh.at(cacheKey(_goals[i], threshold, map_->property_));
+    }
+
+    return heuristics;
+}
+
+std::vector<std::shared_ptr<const MapInstance::HeuristicMap>> MapInstance::HeuristicCache::get(const std::vector<AgentInstance::Agent> &_agents,
+                                                                                                const double &_inflation_radius)
+{
+    std::vector<Position::Index> goals;
+    goals.reserve(_agents.size());
+    for (const auto &agent : _agents)
+        goals.push_back(map_->getIndex(Position::Coordinates(agent.goal_.component_.x, agent.goal_.component_.y)));
+
+    return get(goals, _inflation_radius);
+}
+
+void MapInstance::HeuristicCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    maps_.clear();
+    blocked_grids_.clear();
+}
+
+void MapInstance::HeuristicCache::setCapacity(std::size_t _max_bytes)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    maps_.setCapacity(_max_bytes);
+}
+
+std::size_t MapInstance::HeuristicCache::memoryUsage() const
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    return maps_.cost();
+}
+
+std::size_t MapInstance::HeuristicCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    return maps_.size();
+}
+
+std::shared_ptr<const MapInstance::BitGrid> MapInstance::HeuristicCache::blockedGrid(std::uint32_t _threshold)
+{
+    auto &blocked = blocked_grids_[_threshold];
+    if (not(blocked))
+    {
+        auto grid = std::make_shared<BitGrid>();
+        map_->distance_field_.threshold(_threshold, *grid);
+        blocked = std::move(grid);
+    }
+
+    return blocked;
+}
\ No newline at end of file
@@ -0,0 +1,477 @@
+#include "multibot_util/Map/MapLoader.hpp"
+
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "multibot_util/Util/MappedFile.hpp"
+
+using namespace Instance;
+
+namespace
+{
+    constexpr char CACHE_MAGIC[8] = {'M', 'B', 'O', 'C', 'C', 'M', 'A', 'P'};
+    constexpr std::uint32_t CACHE_VERSION = 1;
+    constexpr std::uint32_t CACHE_ENDIAN = 0x01020304;
+    constexpr std::uint64_t CACHE_ALIGNMENT = 64;
+
+    struct CacheHeader
+    {
+        char magic_[8];
+        std::uint32_t version_;
+        std::uint32_t endian_;
+        std::uint64_t stamp_;
+        std::int32_t width_, height_;
+        double resolution_;
+        double origin_x_, origin_y_;
+        std::uint64_t words_per_row_;
+        std::uint64_t occupancy_offset_;
+        std::uint64_t distance_offset_;
+        std::uint64_t obstacle_offset_;
+        std::uint64_t file_bytes_;
+    }; // struct CacheHeader
+
+    std::uint64_t align(std::uint64_t _offset)
+    {
+        return (_offset + CACHE_ALIGNMENT - 1) / CACHE_ALIGNMENT * CACHE_ALIGNMENT;
+    }
+
+    std::string trim(const std::string &_text)
+    {
+        const auto begin = _text.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos)
+            return std::string();
+
+        const auto end = _text.find_last_not_of(" \t\r\n");
+        return _text.substr(begin, end - begin + 1);
+    }
+
+    std::string unquote(const std::string &_text)
+    {
+        if (_text.size() >= 2 and (_text.front() == '"' or _text.front() == '\'') and _text.back() == _text.front())
+            return _text.substr(1, _text.size() - 2);
+
+        return _text;
+    }
+
+    // Parses the whole of _text; malformed or out-of-range numbers fail
+    // instead of throwing
+    template <typename Number>
+    bool parseNumber(const std::string &_text, Number &_value)
+    {
+        const char *end = _text.data() + _text.size();
+        const auto [parsed, error] = std::from_chars(_text.data(), end, _value);
+
+        return error == std::errc() and parsed == end;
+    }
+
+    // Reads the next header token of a PGM file, skipping '#' comments.
+    bool nextToken(const unsigned char *_data, std::size_t _size, std::size_t &_pos, std::string &_token)
+    {
+        _token.clear();
+        while (_pos < _size)
+        {
+            if (_data[_pos] == '#')
+            {
+                while (_pos < _size and _data[_pos] != '\n')
+                    ++_pos;
+            }
+            else if (std::isspace(_data[_pos]))
+                ++_pos;
+            else
+                break;
+        }
+
+        while (_pos < _size and not(std::isspace(_data[_pos])) and _data[_pos] != '#')
+            _token.push_back(static_cast<char>(_data[_pos++]));
+
+        return not(_token.empty());
+    }
+
+    void hashCombine(std::uint64_t &_hash, std::uint64_t _value)
+    {
+        // FNV-1a over the bytes of _value
+        for (int i = 0; i < 8; ++i)
+        {
+            _hash ^= (_value >> (8 * i)) & 0xff;
+            _hash *= 0x100000001b3ULL;
+        }
+    }
+
+    void hashFile(std::uint64_t &_hash, const std::filesystem::path &_path)
+    {
+        std::error_code error;
+        const auto size = std::filesystem::file_size(_path, error);
+        hashCombine(_hash, error ? 0 : static_cast<std::uint64_t>(size));
+
+        const auto time = std::filesystem::last_write_time(_path, error);
+        hashCombine(_hash, error ? 0 : static_cast<std::uint64_t>(time.time_since_epoch().count()));
+    }
+
+    std::filesystem::path imagePath(const std::string &_yaml_path, const std::string &_image)
+    {
+        std::filesystem::path image(_image);
+        if (image.is_relative())
+            image = std::filesystem::path(_yaml_path).parent_path() / image;
+
+        return image;
+    }
+} // namespace
+
+bool MapInstance::MapLoader::parseYaml(const std::string &_yaml_path, MapMetaData &_metaData)
+{
+    std::ifstream file(_yaml_path);
+    if (not(file.is_open()))
+    {
+        std::cerr << "[Error] MapLoader::parseYaml(): Cannot open " << _yaml_path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        const auto comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+
+        const auto separator = line.find(':');
+        if (separator == std::string::npos)
+            continue;
+
+        const std::string key = trim(line.substr(0, separator));
+        const std::string value = unquote(trim(line.substr(separator + 1)));
+
+        bool valid = true;
+        if (key == "image")
+            _metaData.image_ = value;
+        else if (key == "resolution")
+            valid = parseNumber(value, _metaData.resolution_);
+        else if (key == "negate")
+            _metaData.negate_ = (value == "1" or value == "true" or value == "True");
+        else if (key == "occupied_thresh")
+            valid = parseNumber(value, _metaData.occupied_thresh_);
+        else if (key == "free_thresh")
+            valid = parseNumber(value, _metaData.free_thresh_);
+        else if (key == "origin")
+        {
+            std::string list = value;
+            for (auto &character : list)
+            {
+                if (character == '[' or character == ']' or character == ',')
+                    character = ' ';
+            }
+
+            std::istringstream stream(list);
+            valid = static_cast<bool>(stream >> _metaData.origin_.x_ >> _metaData.origin_.y_);
+            double yaw;
+            if (stream >> yaw)
+                _metaData.origin_yaw_ = yaw;
+        }
+
+        if (not(valid))
+        {
+            std::cerr << "[Error] MapLoader::parseYaml(): "
+                      << "Invalid " << key << " '" << value << "' in " << _yaml_path << std::endl;
+            return false;
+        }
+    }
+
+    if (_metaData.image_.empty() or std::isnan(_metaData.resolution_) or _metaData.resolution_ <= 0)
+    {
+        std::cerr << "[Error] MapLoader::parseYaml(): "
+                  << "Missing image or resolution in " << _yaml_path << std::endl;
+        return false;
+    }
+
+    _metaData.image_ = imagePath(_yaml_path, _metaData.image_).string();
+
+    return true;
+}
+
+bool MapInstance::MapLoader::PgmReader::open(const std::string &_pgm_path, const MapMetaData &_metaData,
+                                             bool _unknown_as_occupied)
+{
+    path_ = _pgm_path;
+    file_ = MAPF_Util::MappedFile::open(_pgm_path);
+    if (not(file_))
+    {
+        std::cerr << "[Error] MapLoader::PgmReader::open(): Cannot open " << _pgm_path << std::endl;
+        return false;
+    }
+
+    const unsigned char *data = file_->data();
+    pos_ = 0;
+    std::string magic, widthToken, heightToken, maxToken;
+    if (not(nextToken(data, file_->size(), pos_, magic) and nextToken(data, file_->size(), pos_, widthToken) and
+            nextToken(data, file_->size(), pos_, heightToken) and nextToken(data, file_->size(), pos_, maxToken)) or
+        (magic != "P5" and magic != "P2") or
+        not(parseNumber(widthToken, width_) and parseNumber(heightToken, height_) and parseNumber(maxToken, max_value_)))
+    {
+        std::cerr << "[Error] MapLoader::PgmReader::open(): " << _pgm_path << " is not a PGM image" << std::endl;
+        return false;
+    }
+
+    binary_ = (magic == "P5");
+    ++pos_; // Single whitespace after the header
+
+    const std::size_t bytesPerPixel = max_value_ > 255 ? 2 : 1;
+    if (width_ <= 0 or height_ <= 0 or max_value_ <= 0 or max_value_ > 65535 or
+        (binary_ and pos_ + static_cast<std::size_t>(width_) * height_ * bytesPerPixel > file_->size()))
+    {
+        std::cerr << "[Error] MapLoader::PgmReader::open(): Truncated or invalid PGM " << _pgm_path << std::endl;
+        return false;
+    }
+
+    if (std::fabs(_metaData.origin_yaw_) > 1e-8)
+        std::cerr << "[Warn] MapLoader::PgmReader::open(): Rotated map origins are not supported, ignoring yaw" << std::endl;
+
+    // Occupancy of every possible pixel value, following map_server's trinary mode
+    occupied_lookup_.assign(max_value_ + 1, false);
+    for (int value = 0; value <= max_value_; ++value)
+    {
+        const double occupancy = _metaData.negate_ ? static_cast<double>(value) / max_value_
+                                                   : static_cast<double>(max_value_ - value) / max_value_;
+        if (occupancy > _metaData.occupied_thresh_)
+            occupied_lookup_[value] = true;
+        else if (occupancy < _metaData.free_thresh_)
+            occupied_lookup_[value] = false;
+        else
+            occupied_lookup_[value] = _unknown_as_occupied;
+    }
+
+    property_.width_ = width_;
+    property_.height_ = height_;
+    property_.resolution_ = _metaData.resolution_;
+    // Cell coordinates refer to cell centers
+    property_.origin_ = Position::Coordinates(_metaData.origin_.x_ + 0.5 * _metaData.resolution_,
+                                              _metaData.origin_.y_ + 0.5 * _metaData.resolution_);
+
+    return true;
+}
+
+bool MapInstance::MapLoader::PgmReader::readRow(BitGrid::Word *_words)
+{
+    const std::size_t wordsPerRow = (static_cast<std::size_t>(width_) + BitGrid::WORD_BITS - 1) / BitGrid::WORD_BITS;
+    std::fill(_words, _words + wordsPerRow, BitGrid::Word(0));
+
+    const unsigned char *data = file_->data();
+    const std::size_t bytesPerPixel = max_value_ > 255 ? 2 : 1;
+    std::string token;
+    for (int x = 0; x < width_; ++x)
+    {
+        int value = 0;
+        if (binary_)
+        {
+            const unsigned char *pixel = data + pos_;
+            value = bytesPerPixel == 2 ? (pixel[0] << 8 | pixel[1]) : pixel[0];
+            pos_ += bytesPerPixel;
+        }
+        else if (not(nextToken(data, file_->size(), pos_, token)))
+        {
+            std::cerr << "[Error] MapLoader::PgmReader::readRow(): Truncated PGM " << path_ << std::endl;
+            return false;
+        }
+        else if (not(parseNumber(token, value)))
+            value = -1;
+
+        if (value < 0 or value > max_value_)
+        {
+            std::cerr << "[Error] MapLoader::PgmReader::readRow(): "
+                      << "Pixel value outside [0, " << max_value_ << "] in " << path_ << std::endl;
+            return false;
+        }
+
+        if (occupied_lookup_[value])
+            _words[x / BitGrid::WORD_BITS] |= BitGrid::Word(1) << (x % BitGrid::WORD_BITS);
+    }
+
+    return true;
+}
+
+bool MapInstance::MapLoader::loadPgm(const std::string &_pgm_path, const MapMetaData &_metaData,
+                                     BinaryOccupancyMap &_map, bool _unknown_as_occupied)
+{
+    PgmReader reader;
+    if (not(reader.open(_pgm_path, _metaData, _unknown_as_occupied)))
+        return false;
+
+    _map.initialize(reader.property());
+
+    // Image rows run top to bottom
+    for (int row = 0; row < reader.height(); ++row)
+    {
+        if (not(reader.readRow(_map.mapData_.row(reader.height() - 1 - row))))
+            return false;
+    }
+
+    return true;
+}
+
+bool MapInstance::MapLoader::loadYaml(const std::string &_yaml_path, BinaryOccupancyMap &_map, bool _unknown_as_occupied)
+{
+    MapMetaData metaData;
+    if (not(parseYaml(_yaml_path, metaData)))
+        return false;
+
+    return loadPgm(metaData.image_, metaData, _map, _unknown_as_occupied);
+}
+
+std::uint64_t MapInstance::MapLoader::sourceStamp(const std::string &_yaml_path, bool _unknown_as_occupied)
+{
+    std::uint64_t stamp = 0xcbf29ce484222325ULL;
+    hashCombine(stamp, CACHE_VERSION);
+    hashCombine(stamp, _unknown_as_occupied);
+    hashFile(stamp, _yaml_path);
+
+    MapMetaData metaData;
+    std::ifstream probe(_yaml_path);
+    if (probe.is_open() and parseYaml(_yaml_path, metaData))
+        hashFile(stamp, metaData.image_);
+
+    return stamp;
+}
+
+bool MapInstance::MapLoader::writeCache(const std::string &_cache_path, const BinaryOccupancyMap &_map, const std::uint64_t &_stamp)
+{
+    const BitGrid &occupancy = _map.mapData_;
+    const bool withDistance = _map.hasDistanceField();
+    const std::size_t cells = static_cast<std::size_t>(occupancy.width()) * occupancy.height();
+
+    CacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic_, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version_             = CACHE_VERSION;
+    header.endian_              = CACHE_ENDIAN;
+    header.stamp_               = _stamp;
+    header.width_               = occupancy.width();
+    header.height_              = occupancy.height();
+    header.resolution_          = _map.property_.resolution_;
+    header.origin_x_            = _map.property_.origin_.x_;
+    header.origin_y_            = _map.property_.origin_.y_;
+    header.words_per_row_       = occupancy.wordsPerRow();
+    header.occupancy_offset_    = align(sizeof(CacheHeader));
+
+    std::uint64_t end = header.occupancy_offset_ + occupancy.memoryUsage();
+    if (withDistance)
+    {
+        header.distance_offset_ = align(end);
+        header.obstacle_offset_ = align(header.distance_offset_ + cells * sizeof(std::uint32_t));
+        end = header.obstacle_offset_ + cells * sizeof(std::int32_t);
+    }
+    header.file_bytes_ = end;
+
+    // Write next to the target and rename, so readers never map a partial file
+    const std::string temporaryPath = _cache_path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (not(file.is_open()))
+        {
+            std::cerr << "[Error] MapLoader::writeCache(): Cannot write " << temporaryPath << std::endl;
+            return false;
+        }
+
+        const auto writeAt = [&file](std::uint64_t _offset, const void *_data, std::size_t _bytes)
+        {
+            const std::uint64_t position = static_cast<std::uint64_t>(file.tellp());
+            if (_offset > position)
+            {
+                const std::vector<char> padding(_offset - position, 0);
+                file.write(padding.data(), padding.size());
+            }
+            file.write(static_cast<const char *>(_data), _bytes);
+        };
+
+        writeAt(0, &header, sizeof(header));
+        writeAt(header.occupancy_offset_, occupancy.words().data(), occupancy.memoryUsage());
+        if (withDistance)
+        {
+            writeAt(header.distance_offset_, _map.distance_field_.data(), cells * sizeof(std::uint32_t));
+            writeAt(header.obstacle_offset_, _map.distance_field_.obstacleData(), cells * sizeof(std::int32_t));
+        }
+
+        if (not(file.good()))
+        {
+            std::cerr << "[Error] MapLoader::writeCache(): Failed writing " << temporaryPath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, _cache_path, error);
+    if (error)
+    {
+        std::cerr << "[Error] MapLoader::writeCache(): " << error.message() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool MapInstance::MapLoader::readCache(const std::string &_cache_path, BinaryOccupancyMap &_map, const std::uint64_t &_stamp)
+{
+    const auto file = MAPF_Util::MappedFile::open(_cache_path);
+    if (not(file) or file->size() < sizeof(CacheHeader))
+        return false;
+
+    CacheHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic_, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 or header.version_ != CACHE_VERSION or
+        header.endian_ != CACHE_ENDIAN or header.stamp_ != _stamp or header.file_bytes_ != file->size() or
+        header.width_ <= 0 or header.height_ <= 0 or not(header.resolution_ > 0) or not(std::isfinite(header.resolution_)))
+        return false;
+
+    // The whole layout is checked before _map is touched, so a rejected cache leaves it as it was
+    const auto fits = [&file](std::uint64_t _offset, std::uint64_t _bytes, std::size_t _alignment)
+    {
+        return _offset % _alignment == 0 and _offset <= file->size() and _bytes <= file->size() - _offset;
+    };
+    const std::uint64_t wordsPerRow = (static_cast<std::uint64_t>(header.width_) + BitGrid::WORD_BITS - 1) / BitGrid::WORD_BITS;
+    const std::uint64_t occupancyBytes = wordsPerRow * header.height_ * sizeof(BitGrid::Word);
+    if (header.words_per_row_ != wordsPerRow or not(fits(header.occupancy_offset_, occupancyBytes, alignof(BitGrid::Word))))
+        return false;
+
+    const std::uint64_t fieldBytes = static_cast<std::uint64_t>(header.width_) * header.height_ * sizeof(std::uint32_t);
+    const bool withDistance = header.distance_offset_ != 0;
+    if (withDistance and not(fits(header.distance_offset_, fieldBytes, alignof(std::uint32_t)) and
+                             fits(header.obstacle_offset_, fieldBytes, alignof(std::int32_t))))
+        return false;
+
+    BinaryOccupancyMap::MapProperty property;
+    property.width_ = header.width_;
+    property.height_ = header.height_;
+    property.resolution_ = header.resolution_;
+    property.origin_ = Position::Coordinates(header.origin_x_, header.origin_y_);
+    _map.initialize(property);
+    std::memcpy(_map.mapData_.words().data(), file->data() + header.occupancy_offset_, occupancyBytes);
+
+    if (withDistance)
+    {
+        DistanceField distanceField;
+        distanceField.borrow(header.width_, header.height_, file,
+                             reinterpret_cast<const std::uint32_t *>(file->data() + header.distance_offset_),
+                             reinterpret_cast<const std::int32_t *>(file->data() + header.obstacle_offset_));
+        _map.setDistanceField(distanceField);
+    }
+
+    return true;
+}
+
+bool MapInstance::MapLoader::load(const std::string &_yaml_path, const std::string &_cache_path,
+                                  BinaryOccupancyMap &_map, bool _unknown_as_occupied)
+{
+    const std::uint64_t stamp = sourceStamp(_yaml_path, _unknown_as_occupied);
+    if (readCache(_cache_path, _map, stamp))
+        return true;
+
+    if (not(loadYaml(_yaml_path, _map, _unknown_as_occupied)))
+        return false;
+
+    _map.computeDistanceField();
+    writeCache(_cache_path, _map, stamp);
+
+    return true;
+}
@@ -0,0 +1,161 @@
+#include "multibot_util/Map/MapSnapshot.hpp"
+
+#include "multibot_util/Util/Profiler.hpp"
+
+using namespace Instance;
+
+namespace
+{
+    // Copies the _tile_size square at tile (_tile_x, _tile_y) out of _source.
+    // Tiles past the map border keep their outside cells cleared.
+    void copyTile(const MapInstance::BitGrid &_source, int _tile_x, int _tile_y, int _tile_size,
+                  MapInstance::BitGrid &_tile)
+    {
+        _tile.resize(_tile_size, _tile_size);
+        if (_source.width() == 0)
+            return;
+
+        const std::size_t tileWords = _tile.wordsPerRow();
+        const std::size_t firstWord = static_cast<std::size_t>(_tile_x) * tileWords;
+        const std::size_t words = std::min(tileWords, _source.wordsPerRow() - firstWord);
+        for (int row = 0; row < _tile_size; ++row)
+        {
+            const int y = _tile_y * _tile_size + row;
+            if (y >= _source.height())
+                break;
+            std::copy(_source.row(y) + firstWord, _source.row(y) + firstWord + words, _tile.row(row));
+        }
+    }
+} // namespace
+
+std::size_t MapInstance::MapSnapshot::memoryUsage() const
+{
+    std::size_t usage = 0;
+    for (const auto &tile : tiles_)
+        usage += tile->occupancy_.memoryUsage() + tile->inflated_.memoryUsage();
+
+    return usage;
+}
+
+MapInstance::VersionedMap::VersionedMap(const BinaryOccupancyMap &_map, int _tile_size)
+    : map_(_map), tile_size_(_tile_size), version_(0)
+{
+    try
+    {
+        if (_tile_size <= 0 or _tile_size % BitGrid::WORD_BITS != 0)
+            throw _tile_size;
+    }
+    catch (const int &_invalid_tile_size)
+    {
+        std::cerr << "[Error] VersionedMap::VersionedMap(): "
+                  << "Tile size must be a positive multiple of " << BitGrid::WORD_BITS
+                  << ", got " << _invalid_tile_size << std::endl;
+        std::abort();
+    }
+
+    // Incremental updates need the distance field to repair the inflation
+    if (not(map_.hasDistanceField()))
+    {
+        map_.computeDistanceField();
+        if (not(std::isnan(map_.property_.inflation_radius_)))
+            map_.inflate(map_.property_.inflation_radius_);
+    }
+
+    auto snapshot = std::make_shared<MapSnapshot>();
+    snapshot->property_ = map_.property_;
+    snapshot->tile_size_ = tile_size_;
+    snapshot->tiles_x_ = (map_.property_.width_ + tile_size_ - 1) / tile_size_;
+    snapshot->tiles_y_ = (map_.property_.height_ + tile_size_ - 1) / tile_size_;
+    snapshot->tiles_.resize(static_cast<std::size_t>(snapshot->tiles_x_) * snapshot->tiles_y_);
+    for (int tileY = 0; tileY < snapshot->tiles_y_; ++tileY)
+        for (int tileX = 0; tileX < snapshot->tiles_x_; ++tileX)
+            snapshot->tiles_[static_cast<std::size_t>(tileY) * snapshot->tiles_x_ + tileX] = makeTile(tileX, tileY);
+
+    latest_.store(std::move(snapshot));
+}
+
+std::shared_ptr<const MapInstance::MapSnapshot>
+MapInstance::VersionedMap::update(const std::vector<std::pair<Position::Index, bool>> &_changes)
+{
+    MULTIBOT_PROFILE_SCOPE("VersionedMap::update");
+    std::lock_guard<std::mutex> lock(writer_mtx_);
+
+    const std::shared_ptr<const MapSnapshot> previous = latest_.load();
+    std::vector<bool> touched(previous->tiles_.size(), false);
+    const auto touch = [&](const Position::Index &_idx)
+    {
+        touched[static_cast<std::size_t>(_idx.y_ / tile_size_) * previous->tiles_x_ + _idx.x_ / tile_size_] = true;
+    };
+
+    for (const auto &[idx, occupied] : _changes)
+    {
+        if (map_.isOutofMap(idx))
+        {
+            std::cerr << "[Warn] VersionedMap::update(): Skipping out-of-map cell " << idx << std::endl;
+            continue;
+        }
+        if (map_.isOccupied(idx) == occupied)
+            continue;
+
+        touch(idx);
+        for (const auto &flipped : occupied ? map_.markOccupied(idx) : map_.markFree(idx))
+            touch(flipped);
+    }
+
+    auto snapshot = std::make_shared<MapSnapshot>(*previous);
+    std::size_t copiedTiles = 0;
+    for (int tileY = 0; tileY < snapshot->tiles_y_; ++tileY)
+    {
+        for (int tileX = 0; tileX < snapshot->tiles_x_; ++tileX)
+        {
+            const std::size_t tileIdx = static_cast<std::size_t>(tileY) * snapshot->tiles_x_ + tileX;
+            if (not(touched[tileIdx]))
+                continue;
+            snapshot->tiles_[tileIdx] = makeTile(tileX, tileY);
+            ++copiedTiles;
+        }
+    }
+    MULTIBOT_PROFILE_HISTOGRAM("VersionedMap::update copied tiles", copiedTiles);
+    (void)copiedTiles;
+
+    publish(std::move(snapshot));
+
+    return latest_.load();
+}
+
+std::shared_ptr<const MapInstance::MapSnapshot> MapInstance::VersionedMap::inflate(const double &_inflation_radius)
+{
+    MULTIBOT_PROFILE_SCOPE("VersionedMap::inflate");
+    std::lock_guard<std::mutex> lock(writer_mtx_);
+
+    map_.inflate(_inflation_radius);
+
+    auto snapshot = std::make_shared<MapSnapshot>(*latest_.load());
+    snapshot->property_ = map_.property_;
+    for (int tileY = 0; tileY < snapshot->tiles_y_; ++tileY)
+        for (int tileX = 0; tileX < snapshot->tiles_x_; ++tileX)
+            snapshot->tiles_[static_cast<std::size_t>(tileY) * snapshot->tiles_x_ + tileX] = makeTile(tileX, tileY);
+
+    publish(std::move(snapshot));
+
+    return latest_.load();
+}
+
+std::shared_ptr<const MapInstance::MapSnapshot::Tile> MapInstance::VersionedMap::makeTile(int _tile_x, int _tile_y) const
+{
+    auto tile = std::make_shared<MapSnapshot::Tile>();
+    copyTile(map_.mapData_, _tile_x, _tile_y, tile_size_, tile->occupancy_);
+    copyTile(map_.inflated_mapData_, _tile_x, _tile_y, tile_size_, tile->inflated_);
+
+    return tile;
+}
+
+// The snapshot goes out before the version, so a Reader that sees the new
+// version always loads a snapshot at least that new
+void MapInstance::VersionedMap::publish(std::shared_ptr<MapSnapshot> _snapshot)
+{
+    const std::uint64_t version = version_.load(std::memory_order_relaxed) + 1;
+    _snapshot->version_ = version;
+    latest_.store(std::move(_snapshot));
+    version_.store(version, std::memory_order_release);
+}
\ No newline at end of file
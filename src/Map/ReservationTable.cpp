@@ -0,0 +1,299 @@
+#include "multibot_util/Map/ReservationTable.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+#include "multibot_util/Util/Parallel.hpp"
+
+using namespace Instance;
+
+namespace
+{
+    struct RawReservation
+    {
+        std::int32_t cell_;
+        Time::TimePoint startTime_;
+        Time::TimePoint endTime_;
+
+        bool operator<(const RawReservation &_other) const
+        {
+            return std::tie(cell_, startTime_) < std::tie(_other.cell_, _other.startTime_);
+        }
+    }; // struct RawReservation
+
+    Position::Coordinates toCoordinates(const Position::Pose &_pose)
+    {
+        return Position::Coordinates(_pose.component_.x, _pose.component_.y);
+    }
+} // namespace
+
+void MapInstance::ReservationTable::initialize(const BinaryOccupancyMap::MapProperty &_property, bool _park_at_goal)
+{
+    try
+    {
+        if (_property.width_ <= 0 or _property.height_ <= 0 or not(_property.resolution_ > 0))
+            throw _property;
+    }
+    catch (const BinaryOccupancyMap::MapProperty &_invalid_property)
+    {
+        std::cerr << "[Error] ReservationTable::initialize(): "
+                  << "Invalid Map: " << _invalid_property.width_ << " x " << _invalid_property.height_
+                  << " at " << _invalid_property.resolution_ << "m" << std::endl;
+        std::abort();
+    }
+
+    property_ = _property;
+    park_at_goal_ = _park_at_goal;
+    clear();
+}
+
+void MapInstance::ReservationTable::clear()
+{
+    agents_.clear();
+    cells_.clear();
+    next_agent_id_ = 0;
+}
+
+void MapInstance::ReservationTable::build(const Traj::TrajSet &_trajSet, const std::map<std::string, double> &_radii)
+{
+    clear();
+    insert(_trajSet, _radii);
+}
+
+void MapInstance::ReservationTable::insert(const Traj::TrajSet &_trajSet, const std::map<std::string, double> &_radii)
+{
+    std::vector<std::pair<const Traj::SingleTraj *, double>> jobs;
+    jobs.reserve(_trajSet.size());
+    for (const auto &[agentName, traj] : _trajSet)
+    {
+        try
+        {
+            if (_radii.find(agentName) == _radii.end())
+                throw agentName;
+        }
+        catch (const std::string &_unknown_agent)
+        {
+            std::cerr << "[Error] ReservationTable::insert(): "
+                      << "No radius for agent " << _unknown_agent << std::endl;
+            std::abort();
+        }
+        jobs.emplace_back(&traj, _radii.at(agentName));
+    }
+
+    // Rasterizing is independent per agent; only the table update is serial
+    std::vector<Footprint> footprints(jobs.size());
+    MAPF_Util::Parallel::parallelFor(0, jobs.size(), [&](std::size_t _begin, std::size_t _end, unsigned int)
+    {
+        for (std::size_t i = _begin; i < _end; ++i)
+            footprints[i] = rasterize(*jobs[i].first, jobs[i].second);
+    });
+
+    auto trajPair = _trajSet.begin();
+    for (std::size_t i = 0; i < footprints.size(); ++i, ++trajPair)
+        apply(trajPair->first, std::move(footprints[i]));
+}
+
+void MapInstance::ReservationTable::insert(const Traj::SingleTraj &_traj, const double &_radius)
+{
+    apply(_traj.agentName_, rasterize(_traj, _radius));
+}
+
+bool MapInstance::ReservationTable::remove(const std::string &_agentName)
+{
+    auto agent = agents_.find(_agentName);
+    if (agent == agents_.end())
+        return false;
+
+    const AgentId id = agent->second.id_;
+    for (const auto cell : agent->second.cells_)
+    {
+        auto entry = cells_.find(cell);
+        if (entry == cells_.end())
+            continue;
+
+        auto &reservations = entry->second.reservations_;
+        reservations.erase(std::remove_if(reservations.begin(), reservations.end(),
+                                          [id](const Reservation &_reservation)
+                                          { return _reservation.agent_ == id; }),
+                           reservations.end());
+        if (reservations.empty())
+        {
+            cells_.erase(entry);
+            continue;
+        }
+
+        // Other agents' reservations may overlap, so the time line is rebuilt from them
+        auto &timeLine = entry->second.timeLine_;
+        timeLine.clear();
+        for (const auto &reservation : reservations)
+            timeLine.insertReservation(reservation.startTime_, reservation.endTime_);
+    }
+
+    agents_.erase(agent);
+    return true;
+}
+
+MapInstance::ReservationTable::Footprint MapInstance::ReservationTable::rasterize(const Traj::SingleTraj &_traj,
+                                                                                  const double &_radius) const
+{
+    try
+    {
+        if (not(_radius >= 0))
+            throw _radius;
+    }
+    catch (const double &_invalid_radius)
+    {
+        std::cerr << "[Error] ReservationTable::rasterize(): "
+                  << "Invalid Radius: " << _invalid_radius << std::endl;
+        std::abort();
+    }
+
+    Footprint raw;
+    for (std::size_t i = 0; i < _traj.nodes_.size(); ++i)
+    {
+        const auto &[from, to] = _traj.nodes_[i];
+        const Position::Coordinates fromCoord = toCoordinates(from.pose_);
+        const Position::Coordinates toCoord = toCoordinates(to.pose_);
+
+        sweep(raw, fromCoord, fromCoord, from.arrival_time_, from.departure_time_, _radius);
+        sweep(raw, fromCoord, toCoord, from.departure_time_, to.arrival_time_, _radius);
+        if (i + 1 == _traj.nodes_.size())
+            sweep(raw, toCoord, toCoord, to.arrival_time_,
+                  park_at_goal_ ? Time::TimePoint::max() : to.departure_time_, _radius);
+    }
+
+    std::vector<RawReservation> sorted(raw.cells_.size());
+    for (std::size_t i = 0; i < sorted.size(); ++i)
+        sorted[i] = RawReservation{raw.cells_[i], raw.intervals_[i].first, raw.intervals_[i].second};
+    std::sort(sorted.begin(), sorted.end());
+
+    Footprint footprint;
+    for (const auto &reservation : sorted)
+    {
+        if (not footprint.cells_.empty() and footprint.cells_.back() == reservation.cell_ and
+            reservation.startTime_ <= footprint.intervals_.back().second)
+        {
+            footprint.intervals_.back().second = std::max(footprint.intervals_.back().second, reservation.endTime_);
+            continue;
+        }
+        footprint.cells_.push_back(reservation.cell_);
+        footprint.intervals_.emplace_back(reservation.startTime_, reservation.endTime_);
+    }
+
+    return footprint;
+}
+
+const Time::TimeLine *MapInstance::ReservationTable::timeLine(const Position::Index &_idx) const
+{
+    const auto entry = cells_.find(linearIndex(_idx));
+    return entry == cells_.end() ? nullptr : &entry->second.timeLine_;
+}
+
+const std::vector<MapInstance::ReservationTable::Reservation> *
+MapInstance::ReservationTable::reservations(const Position::Index &_idx) const
+{
+    const auto entry = cells_.find(linearIndex(_idx));
+    return entry == cells_.end() ? nullptr : &entry->second.reservations_;
+}
+
+bool MapInstance::ReservationTable::isSafe(const Position::Index &_idx, const Time::TimePoint &_time) const
+{
+    const Time::TimeLine *line = timeLine(_idx);
+    return line == nullptr or line->isSafe(_time);
+}
+
+void MapInstance::ReservationTable::apply(const std::string &_agentName, Footprint &&_footprint)
+{
+    remove(_agentName);
+
+    AgentEntry &agent = agents_[_agentName];
+    agent.id_ = next_agent_id_++;
+    agent.cells_.reserve(_footprint.cells_.size());
+
+    for (std::size_t i = 0; i < _footprint.cells_.size(); ++i)
+    {
+        const std::int32_t cell = _footprint.cells_[i];
+        const auto &[startTime, endTime] = _footprint.intervals_[i];
+
+        auto [entry, inserted] = cells_.try_emplace(cell);
+        if (inserted)
+            entry->second.timeLine_.idx_ = Position::Index(cell % property_.width_, cell / property_.width_);
+        entry->second.reservations_.push_back(Reservation{agent.id_, startTime, endTime});
+        entry->second.timeLine_.insertReservation(startTime, endTime);
+
+        if (agent.cells_.empty() or agent.cells_.back() != cell)
+            agent.cells_.push_back(cell);
+    }
+}
+
+void MapInstance::ReservationTable::sweep(Footprint &_footprint,
+                                          const Position::Coordinates &_from, const Position::Coordinates &_to,
+                                          const Time::TimePoint &_startTime, const Time::TimePoint &_endTime,
+                                          const double &_radius) const
+{
+    if (not(_startTime < _endTime))
+        return;
+
+    // A cell is reserved while the disc overlaps its square, conservatively
+    // tested as the cell center lying within radius + half diagonal
+    const double reach = _radius + property_.resolution_ * M_SQRT1_2;
+    const double reachSq = reach * reach;
+    const double inverseResolution = 1.0 / property_.resolution_;
+
+    const int xMin = std::max(0, static_cast<int>(std::ceil((std::min(_from.x_, _to.x_) - reach - property_.origin_.x_) * inverseResolution)));
+    const int xMax = std::min(property_.width_ - 1, static_cast<int>(std::floor((std::max(_from.x_, _to.x_) + reach - property_.origin_.x_) * inverseResolution)));
+    const int yMin = std::max(0, static_cast<int>(std::ceil((std::min(_from.y_, _to.y_) - reach - property_.origin_.y_) * inverseResolution)));
+    const int yMax = std::min(property_.height_ - 1, static_cast<int>(std::floor((std::max(_from.y_, _to.y_) + reach - property_.origin_.y_) * inverseResolution)));
+
+    // Disc center at s in [0, 1] is _from + s * delta; |center - cell|^2 <= reachSq is quadratic in s
+    const double deltaX = _to.x_ - _from.x_;
+    const double deltaY = _to.y_ - _from.y_;
+    const double a = deltaX * deltaX + deltaY * deltaY;
+    const bool open = _endTime == Time::TimePoint::max();
+    const double duration = open ? 0.0 : (_endTime - _startTime).count();
+
+    for (int y = yMin; y <= yMax; ++y)
+    {
+        const double offsetY = _from.y_ - (property_.origin_.y_ + y * property_.resolution_);
+        for (int x = xMin; x <= xMax; ++x)
+        {
+            const double offsetX = _from.x_ - (property_.origin_.x_ + x * property_.resolution_);
+            const double c = offsetX * offsetX + offsetY * offsetY - reachSq;
+
+            double sBegin = 0.0, sEnd = 1.0;
+            if (a < 1e-12)
+            {
+                if (c > 0)
+                    continue;
+            }
+            else
+            {
+                const double b = 2.0 * (offsetX * deltaX + offsetY * deltaY);
+                const double discriminant = b * b - 4.0 * a * c;
+                if (discriminant < 0)
+                    continue;
+
+                const double root = std::sqrt(discriminant);
+                sBegin = std::max(0.0, (-b - root) / (2.0 * a));
+                sEnd = std::min(1.0, (-b + root) / (2.0 * a));
+                if (sBegin >= sEnd)
+                    continue;
+            }
+
+            _footprint.cells_.push_back(y * property_.width_ + x);
+            if (open)
+                _footprint.intervals_.emplace_back(_startTime, _endTime);
+            else
+                _footprint.intervals_.emplace_back(_startTime + Time::TimePoint(sBegin * duration),
+                                                   _startTime + Time::TimePoint(sEnd * duration));
+        }
+    }
+}
+
+std::int32_t MapInstance::ReservationTable::linearIndex(const Position::Index &_idx) const
+{
+    if (_idx.x_ < 0 or _idx.y_ < 0 or _idx.x_ >= property_.width_ or _idx.y_ >= property_.height_)
+        return -1;
+
+    return _idx.y_ * property_.width_ + _idx.x_;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "multibot_util/Map/SegmentQuery.hpp"
+
+#include "multibot_util/Util/Parallel.hpp"
+
+using namespace Instance;
+
+namespace
+{
+    constexpr std::size_t BATCH_GRAIN = 256;
+
+    Position::Coordinates toCoordinates(const Position::Pose &_pose)
+    {
+        return Position::Coordinates(_pose.component_.x, _pose.component_.y);
+    }
+} // namespace
+
+MapInstance::SegmentCollision MapInstance::findSegmentCollision(const BinaryOccupancyMap &_map,
+                                                                const Position::Coordinates &_from,
+                                                                const Position::Coordinates &_to)
+{
+    const BitGrid &inflated = _map.inflated_mapData_;
+
+    return SegmentQuery::trace(_map.property_, _from, _to, [&inflated](int _y, int _xBegin, int _xEnd, bool _forward)
+                               { return SegmentQuery::firstSetBit(inflated.row(_y), _xBegin, _xEnd, _forward); });
+}
+
+MapInstance::SegmentCollision MapInstance::findSegmentCollision(const BinaryOccupancyMap &_map,
+                                                                const Position::Pose &_from, const Position::Pose &_to)
+{
+    return findSegmentCollision(_map, toCoordinates(_from), toCoordinates(_to));
+}
+
+MapInstance::SegmentCollision MapInstance::findSegmentCollision(const BinaryOccupancyMap &_map, const InflatedView &_view,
+                                                                const Position::Coordinates &_from,
+                                                                const Position::Coordinates &_to)
+{
+    const std::uint32_t threshold = _view.threshold();
+    const DistanceField &field = _view.field();
+
+    return SegmentQuery::trace(_map.property_, _from, _to, [&field, threshold](int _y, int _xBegin, int _xEnd, bool _forward)
+    {
+        const std::uint32_t *distanceRow = field.row(_y);
+        if (_forward)
+        {
+            for (int x = _xBegin; x <= _xEnd; ++x)
+            {
+                if (distanceRow[x] <= threshold)
+                    return x;
+            }
+        }
+        else
+        {
+            for (int x = _xEnd; x >= _xBegin; --x)
+            {
+                if (distanceRow[x] <= threshold)
+                    return x;
+            }
+        }
+
+        return -1;
+    });
+}
+
+MapInstance::SegmentCollision MapInstance::findSegmentCollision(const BinaryOccupancyMap &_map, const InflatedView &_view,
+                                                                const Position::Pose &_from, const Position::Pose &_to)
+{
+    return findSegmentCollision(_map, _view, toCoordinates(_from), toCoordinates(_to));
+}
+
+std::vector<MapInstance::SegmentCollision> MapInstance::findSegmentCollisions(const BinaryOccupancyMap &_map,
+                                                                              const std::vector<Segment> &_segments)
+{
+    std::vector<SegmentCollision> collisions(_segments.size());
+    MAPF_Util::Parallel::parallelFor(0, _segments.size(), [&](std::size_t _begin, std::size_t _end, unsigned int)
+    {
+        for (std::size_t i = _begin; i < _end; ++i)
+            collisions[i] = findSegmentCollision(_map, _segments[i].first, _segments[i].second);
+    }, BATCH_GRAIN);
+
+    return collisions;
+}
+
+std::vector<MapInstance::SegmentCollision> MapInstance::findSegmentCollisions(const BinaryOccupancyMap &_map, const InflatedView &_view,
+                                                                              const std::vector<Segment> &_segments)
+{
+    std::vector<SegmentCollision> collisions(_segments.size());
+    MAPF_Util::Parallel::parallelFor(0, _segments.size(), [&](std::size_t _begin, std::size_t _end, unsigned int)
+    {
+        for (std::size_t i = _begin; i < _end; ++i)
+            collisions[i] = findSegmentCollision(_map, _view, _segments[i].first, _segments[i].second);
+    }, BATCH_GRAIN);
+
+    return collisions;
+}
@@ -0,0 +1,419 @@
+#include "multibot_util/Map/TiledOccupancyMap.hpp"
+
+#include <cstring>
+
+#include "multibot_util/Map/MapLoader.hpp"
+
+using namespace Instance;
+
+namespace
+{
+    constexpr char STORE_MAGIC[8] = {'M', 'B', 'T', 'I', 'L', 'E', 'S', '\0'};
+    constexpr std::uint32_t STORE_VERSION = 1;
+    constexpr std::uint32_t STORE_ENDIAN = 0x01020304;
+
+    struct StoreHeader
+    {
+        char magic_[8];
+        std::uint32_t version_;
+        std::uint32_t endian_;
+        std::int32_t width_, height_;
+        std::int32_t tile_size_;
+        std::int32_t tiles_x_, tiles_y_;
+        std::int32_t reserved_;
+        double resolution_;
+        double origin_x_, origin_y_;
+        std::uint64_t data_offset_;
+        std::uint64_t tile_bytes_;
+    }; // struct StoreHeader
+
+    std::uint64_t tileBytes(int _tile_size)
+    {
+        return static_cast<std::uint64_t>(_tile_size) * (_tile_size / MapInstance::BitGrid::WORD_BITS) *
+               sizeof(MapInstance::BitGrid::Word);
+    }
+
+    StoreHeader makeHeader(const MapInstance::BinaryOccupancyMap::MapProperty &_property, int _tile_size)
+    {
+        StoreHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic_, STORE_MAGIC, sizeof(STORE_MAGIC));
+        header.version_     = STORE_VERSION;
+        header.endian_      = STORE_ENDIAN;
+        header.width_       = _property.width_;
+        header.height_      = _property.height_;
+        header.tile_size_   = _tile_size;
+        header.tiles_x_     = (_property.width_ + _tile_size - 1) / _tile_size;
+        header.tiles_y_     = (_property.height_ + _tile_size - 1) / _tile_size;
+        header.resolution_  = _property.resolution_;
+        header.origin_x_    = _property.origin_.x_;
+        header.origin_y_    = _property.origin_.y_;
+        header.data_offset_ = (sizeof(StoreHeader) + 63) / 64 * 64;
+        header.tile_bytes_  = tileBytes(_tile_size);
+
+        return header;
+    }
+
+    bool validTileSize(int _tile_size)
+    {
+        if (_tile_size <= 0 or _tile_size % MapInstance::BitGrid::WORD_BITS != 0)
+        {
+            std::cerr << "[Error] TiledOccupancyMap: Tile size must be a positive multiple of "
+                      << MapInstance::BitGrid::WORD_BITS << ", got " << _tile_size << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    // Writes every tile of tile row _tile_y. _band holds _tile_size map rows of
+    // _words_per_row words, starting at map row _tile_y * _tile_size.
+    void writeBand(std::ofstream &_store, const StoreHeader &_header, int _tile_y,
+                   const std::vector<MapInstance::BitGrid::Word> &_band, std::size_t _words_per_row)
+    {
+        const std::size_t tileWords = _header.tile_size_ / MapInstance::BitGrid::WORD_BITS;
+        std::vector<MapInstance::BitGrid::Word> tileData(tileWords * _header.tile_size_);
+
+        for (int tileX = 0; tileX < _header.tiles_x_; ++tileX)
+        {
+            std::fill(tileData.begin(), tileData.end(), 0);
+            const std::size_t firstWord = static_cast<std::size_t>(tileX) * tileWords;
+            const std::size_t wordCount = std::min(tileWords, _words_per_row - firstWord);
+            for (int row = 0; row < _header.tile_size_; ++row)
+            {
+                const auto source = _band.begin() + row * _words_per_row + firstWord;
+                std::copy(source, source + wordCount, tileData.begin() + row * tileWords);
+            }
+
+            const std::uint64_t offset = _header.data_offset_ +
+                                         (static_cast<std::uint64_t>(_tile_y) * _header.tiles_x_ + tileX) * _header.tile_bytes_;
+            _store.seekp(offset);
+            _store.write(reinterpret_cast<const char *>(tileData.data()), _header.tile_bytes_);
+        }
+    }
+
+    bool openStore(const std::string &_store_path, const StoreHeader &_header, std::ofstream &_store)
+    {
+        _store.open(_store_path, std::ios::binary | std::ios::trunc);
+        if (not(_store.is_open()))
+        {
+            std::cerr << "[Error] TiledOccupancyMap: Cannot write " << _store_path << std::endl;
+            return false;
+        }
+
+        _store.write(reinterpret_cast<const char *>(&_header), sizeof(_header));
+
+        return true;
+    }
+} // namespace
+
+bool MapInstance::TiledOccupancyMap::writeStore(const std::string &_store_path, const BinaryOccupancyMap &_map, int _tile_size)
+{
+    if (not(validTileSize(_tile_size)))
+        return false;
+
+    const StoreHeader header = makeHeader(_map.property_, _tile_size);
+    std::ofstream store;
+    if (not(openStore(_store_path, header, store)))
+        return false;
+
+    const std::size_t wordsPerRow = _map.mapData_.wordsPerRow();
+    std::vector<BitGrid::Word> band(wordsPerRow * _tile_size);
+    for (int tileY = 0; tileY < header.tiles_y_; ++tileY)
+    {
+        std::fill(band.begin(), band.end(), 0);
+        for (int row = 0; row < _tile_size; ++row)
+        {
+            const int y = tileY * _tile_size + row;
+            if (y >= header.height_)
+                break;
+            std::copy(_map.mapData_.row(y), _map.mapData_.row(y) + wordsPerRow, band.begin() + row * wordsPerRow);
+        }
+        writeBand(store, header, tileY, band, wordsPerRow);
+    }
+
+    return store.good();
+}
+
+bool MapInstance::TiledOccupancyMap::convertYaml(const std::string &_yaml_path, const std::string &_store_path,
+                                                 int _tile_size, bool _unknown_as_occupied)
+{
+    if (not(validTileSize(_tile_size)))
+        return false;
+
+    MapLoader::MapMetaData metaData;
+    MapLoader::PgmReader reader;
+    if (not(MapLoader::parseYaml(_yaml_path, metaData)) or
+        not(reader.open(metaData.image_, metaData, _unknown_as_occupied)))
+        return false;
+
+    const StoreHeader header = makeHeader(reader.property(), _tile_size);
+    std::ofstream store;
+    if (not(openStore(_store_path, header, store)))
+        return false;
+
+    // Only one band of tile rows is held in memory at a time. Image rows run
+    // top to bottom, so bands are filled from the highest tile row down.
+    const std::size_t wordsPerRow = (static_cast<std::size_t>(header.width_) + BitGrid::WORD_BITS - 1) / BitGrid::WORD_BITS;
+    std::vector<BitGrid::Word> band(wordsPerRow * _tile_size, 0);
+    int currentTileY = (header.height_ - 1) / _tile_size;
+    for (int row = 0; row < header.height_; ++row)
+    {
+        const int y = header.height_ - 1 - row;
+        if (y / _tile_size != currentTileY)
+        {
+            writeBand(store, header, currentTileY, band, wordsPerRow);
+            std::fill(band.begin(), band.end(), 0);
+            currentTileY = y / _tile_size;
+        }
+
+        if (not(reader.readRow(band.data() + (y - currentTileY * _tile_size) * wordsPerRow)))
+            return false;
+    }
+    writeBand(store, header, currentTileY, band, wordsPerRow);
+
+    return store.good();
+}
+
+bool MapInstance::TiledOccupancyMap::open(const std::string &_store_path, std::size_t _max_resident_tiles)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    store_.close();
+    store_.clear();
+    store_.open(_store_path, std::ios::binary);
+    if (not(store_.is_open()))
+    {
+        std::cerr << "[Error] TiledOccupancyMap::open(): Cannot open " << _store_path << std::endl;
+        return false;
+    }
+
+    StoreHeader header;
+    store_.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (not(store_.good()) or std::memcmp(header.magic_, STORE_MAGIC, sizeof(STORE_MAGIC)) != 0 or
+        header.version_ != STORE_VERSION or header.endian_ != STORE_ENDIAN)
+    {
+        std::cerr << "[Error] TiledOccupancyMap::open(): " << _store_path << " is not a tile store" << std::endl;
+        return false;
+    }
+
+    // Tile lookups divide by the tile size and seek by tile index, so the
+    // geometry must be exactly what writeStore() produces and fit in the file
+    store_.seekg(0, std::ios::end);
+    const std::streamoff end = store_.tellg();
+    const std::uint64_t fileBytes = end > 0 ? static_cast<std::uint64_t>(end) : 0;
+    const bool validTiling = header.tile_size_ > 0 and header.tile_size_ % BitGrid::WORD_BITS == 0 and
+                             header.width_ > 0 and header.height_ > 0 and
+                             header.tiles_x_ == (static_cast<std::int64_t>(header.width_) + header.tile_size_ - 1) / header.tile_size_ and
+                             header.tiles_y_ == (static_cast<std::int64_t>(header.height_) + header.tile_size_ - 1) / header.tile_size_ and
+                             header.tile_bytes_ == tileBytes(header.tile_size_) and
+                             header.resolution_ > 0 and
+                             header.data_offset_ >= sizeof(StoreHeader) and header.data_offset_ <= fileBytes and
+                             static_cast<std::uint64_t>(header.tiles_x_) * header.tiles_y_ <=
+                                 (fileBytes - header.data_offset_) / header.tile_bytes_;
+    if (not(validTiling))
+    {
+        std::cerr << "[Error] TiledOccupancyMap::open(): " << _store_path << " has a corrupt tile layout" << std::endl;
+        return false;
+    }
+
+    property_.width_ = header.width_;
+    property_.height_ = header.height_;
+    property_.resolution_ = header.resolution_;
+    property_.origin_ = Position::Coordinates(header.origin_x_, header.origin_y_);
+    property_.inflation_radius_ = std::numeric_limits<double>::quiet_NaN();
+
+    tile_size_ = header.tile_size_;
+    tiles_x_ = header.tiles_x_;
+    tiles_y_ = header.tiles_y_;
+    data_offset_ = header.data_offset_;
+
+    occupancy_tiles_.clear();
+    inflated_tiles_.clear();
+    occupancy_tiles_.setCapacity(std::max<std::size_t>(1, _max_resident_tiles));
+    inflated_tiles_.setCapacity(std::max<std::size_t>(1, _max_resident_tiles));
+    inflation_generation_ = 0;
+
+    return true;
+}
+
+void MapInstance::TiledOccupancyMap::inflate(const double &_inflation_radius)
+{
+    try
+    {
+        if (std::isnan(_inflation_radius) or _inflation_radius < 0)
+            throw _inflation_radius;
+    }
+    catch (const double &_invalid_inflation_radius)
+    {
+        std::cerr << "[Error] TiledOccupancyMap::inflate(): "
+                  << "Invalid Inflation Radius: " << _invalid_inflation_radius << std::endl;
+        std::abort();
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    property_.inflation_radius_ = _inflation_radius;
+    inflation_threshold_ = getInflationThreshold(_inflation_radius, property_.resolution_);
+    inflation_halo_ = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(inflation_threshold_))));
+
+    // Inflated tiles are recomputed lazily on their next lookup
+    inflated_tiles_.clear();
+    ++inflation_generation_;
+}
+
+bool MapInstance::TiledOccupancyMap::isOutofMap(const Cell &_cell) const
+{
+    return isOutofMap(_cell.idx_);
+}
+
+bool MapInstance::TiledOccupancyMap::isOutofMap(const Position::Index &_idx) const
+{
+    return not(_idx.x_ >= 0 and _idx.x_ < property_.width_ and
+               _idx.y_ >= 0 and _idx.y_ < property_.height_);
+}
+
+bool MapInstance::TiledOccupancyMap::isOccupied(const Position::Index &_idx) const
+{
+    if (isOutofMap(_idx))
+        return false;
+
+    return tile(_idx.x_ / tile_size_, _idx.y_ / tile_size_)->get(_idx.x_ % tile_size_, _idx.y_ % tile_size_);
+}
+
+bool MapInstance::TiledOccupancyMap::isInflated(const Position::Index &_idx) const
+{
+    if (isOutofMap(_idx))
+        return false;
+
+    return inflatedTile(_idx.x_ / tile_size_, _idx.y_ / tile_size_)->get(_idx.x_ % tile_size_, _idx.y_ % tile_size_);
+}
+
+std::shared_ptr<const MapInstance::BitGrid> MapInstance::TiledOccupancyMap::tile(int _tile_x, int _tile_y) const
+{
+    const int key = _tile_y * tiles_x_ + _tile_x;
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (auto resident = occupancy_tiles_.find(key))
+        return resident;
+
+    auto loaded = std::make_shared<BitGrid>(tile_size_, tile_size_);
+    const std::uint64_t offset = data_offset_ + static_cast<std::uint64_t>(key) * loaded->memoryUsage();
+    store_.clear();
+    store_.seekg(offset);
+    store_.read(reinterpret_cast<char *>(loaded->words().data()), loaded->memoryUsage());
+    if (not(store_.good()))
+    {
+        std::cerr << "[Error] TiledOccupancyMap::tile(): "
+                  << "Failed reading tile (" << _tile_x << ", " << _tile_y << ")" << std::endl;
+        std::abort();
+    }
+
+    occupancy_tiles_.insert(key, loaded);
+
+    return loaded;
+}
+
+std::shared_ptr<const MapInstance::BitGrid> MapInstance::TiledOccupancyMap::inflatedTile(int _tile_x, int _tile_y) const
+{
+    const int key = _tile_y * tiles_x_ + _tile_x;
+    std::uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (auto resident = inflated_tiles_.find(key))
+            return resident;
+
+        generation = inflation_generation_;
+    }
+
+    try
+    {
+        if (generation == 0)
+            throw generation;
+    }
+    catch (const std::uint64_t &)
+    {
+        std::cerr << "[Error] TiledOccupancyMap::inflatedTile(): "
+                  << "inflate() has not been called" << std::endl;
+        std::abort();
+    }
+
+    // Computed without holding the lock; a concurrent inflate() discards the result
+    auto inflated = computeInflation(_tile_x, _tile_y);
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (generation == inflation_generation_)
+        inflated_tiles_.insert(key, inflated);
+
+    return inflated;
+}
+
+std::size_t MapInstance::TiledOccupancyMap::residentTiles() const
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    return occupancy_tiles_.size() + inflated_tiles_.size();
+}
+
+std::size_t MapInstance::TiledOccupancyMap::memoryUsage() const
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    std::size_t bytes = 0;
+    const auto accumulate = [&bytes](int, const BitGrid &_tile)
+    { bytes += _tile.memoryUsage(); };
+    occupancy_tiles_.forEach(accumulate);
+    inflated_tiles_.forEach(accumulate);
+
+    return bytes;
+}
+
+std::shared_ptr<const MapInstance::BitGrid> MapInstance::TiledOccupancyMap::computeInflation(int _tile_x, int _tile_y) const
+{
+    std::uint32_t threshold = 0;
+    int halo = 0;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        threshold = inflation_threshold_;
+        halo = inflation_halo_;
+    }
+
+    // Window covering the tile plus a halo of every cell within the inflation radius
+    const int windowSize = tile_size_ + 2 * halo;
+    const int windowX = _tile_x * tile_size_ - halo;
+    const int windowY = _tile_y * tile_size_ - halo;
+
+    BitGrid window(windowSize, windowSize);
+    const int firstTileX = std::max(0, static_cast<int>(std::floor(static_cast<double>(windowX) / tile_size_)));
+    const int firstTileY = std::max(0, static_cast<int>(std::floor(static_cast<double>(windowY) / tile_size_)));
+    const int lastTileX = std::min(tiles_x_ - 1, (windowX + windowSize - 1) / tile_size_);
+    const int lastTileY = std::min(tiles_y_ - 1, (windowY + windowSize - 1) / tile_size_);
+
+    for (int tileY = firstTileY; tileY <= lastTileY; ++tileY)
+    {
+        for (int tileX = firstTileX; tileX <= lastTileX; ++tileX)
+        {
+            const int offsetX = tileX * tile_size_ - windowX;
+            const int offsetY = tileY * tile_size_ - windowY;
+            tile(tileX, tileY)->forEachSet([&window, offsetX, offsetY, windowSize](int _x, int _y)
+            {
+                const int x = _x + offsetX;
+                const int y = _y + offsetY;
+                if (x >= 0 and x < windowSize and y >= 0 and y < windowSize)
+                    window.set(x, y, true);
+            });
+        }
+    }
+
+    DistanceField field;
+    field.compute(window);
+
+    auto inflated = std::make_shared<BitGrid>(tile_size_, tile_size_);
+    for (int y = 0; y < tile_size_; ++y)
+    {
+        const std::uint32_t *distanceRow = field.row(y + halo) + halo;
+        BitGrid::Word *inflatedRow = inflated->row(y);
+        for (int x = 0; x < tile_size_; ++x)
+            inflatedRow[x / BitGrid::WORD_BITS] |= BitGrid::Word(distanceRow[x] <= threshold) << (x % BitGrid::WORD_BITS);
+    }
+
+    return inflated;
+}
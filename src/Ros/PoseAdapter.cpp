@@ -0,0 +1,22 @@
+#include "multibot_util/Ros/PoseAdapter.hpp"
+
+using namespace MAPF_Util;
+
+std::vector<geometry_msgs::msg::Pose2D> Ros::toMsgs(std::span<const Position::Pose> _poses)
+{
+    std::vector<geometry_msgs::msg::Pose2D> msgs(_poses.size());
+    for (std::size_t i = 0; i < _poses.size(); ++i)
+        msgs[i] = toMsg(_poses[i]);
+
+    return msgs;
+}
+
+std::vector<Position::Pose> Ros::fromMsgs(std::span<const geometry_msgs::msg::Pose2D> _msgs)
+{
+    std::vector<Position::Pose> poses;
+    poses.reserve(_msgs.size());
+    for (const auto &msg : _msgs)
+        poses.push_back(fromMsg(msg));
+
+    return poses;
+}
\ No newline at end of file
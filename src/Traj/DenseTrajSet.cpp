@@ -0,0 +1,70 @@
+#include "multibot_util/Traj/DenseTrajSet.hpp"
+
+using namespace MAPF_Util;
+
+Traj::DenseTrajSet Traj::DenseTrajSet::fromTrajSet(const TrajSet &_trajSet, AgentRegistry &_registry)
+{
+    DenseTrajSet denseTrajSet(_registry);
+    for (const auto &[agentName, traj] : _trajSet)
+        denseTrajSet.insert(_registry.intern(agentName), traj);
+
+    return denseTrajSet;
+}
+
+Traj::TrajSet Traj::DenseTrajSet::toTrajSet() const
+{
+    TrajSet trajSet;
+    forEach([&](AgentId _id, const SingleTraj &_traj)
+            { trajSet.emplace(registry_->name(_id), _traj); });
+
+    return trajSet;
+}
+
+Traj::SingleTraj &Traj::DenseTrajSet::insert(AgentId _id, const SingleTraj &_traj)
+{
+    try
+    {
+        if (not registry_->contains(_id))
+            throw _id;
+    }
+    catch (const AgentId &_invalid_id)
+    {
+        std::cerr << "[Error] DenseTrajSet::insert(): "
+                  << "Agent ID " << _invalid_id << " is not registered" << std::endl;
+        std::abort();
+    }
+
+    while (slots_.size() <= _id)
+    {
+        slots_.emplace_back();
+        present_.push_back(false);
+    }
+
+    if (not present_[_id])
+    {
+        present_[_id] = true;
+        ++size_;
+    }
+    slots_[_id] = _traj;
+
+    return slots_[_id];
+}
+
+bool Traj::DenseTrajSet::erase(AgentId _id)
+{
+    if (not contains(_id))
+        return false;
+
+    slots_[_id] = SingleTraj();
+    present_[_id] = false;
+    --size_;
+
+    return true;
+}
+
+void Traj::DenseTrajSet::clear()
+{
+    slots_.clear();
+    present_.clear();
+    size_ = 0;
+}
\ No newline at end of file
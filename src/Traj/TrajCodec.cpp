@@ -0,0 +1,433 @@
+#include "multibot_util/Traj/TrajCodec.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+#include "multibot_util/Util/MappedFile.hpp"
+
+using namespace MAPF_Util;
+
+namespace
+{
+    constexpr char TRAJ_MAGIC[8] = {'M', 'B', 'T', 'R', 'A', 'J', 'S', 0};
+    constexpr std::uint32_t TRAJ_VERSION = 1;
+    constexpr std::uint32_t TRAJ_ENDIAN = 0x01020304;
+    constexpr std::uint64_t TRAJ_ALIGNMENT = 8;
+
+    std::uint64_t align(std::uint64_t _offset)
+    {
+        return (_offset + TRAJ_ALIGNMENT - 1) / TRAJ_ALIGNMENT * TRAJ_ALIGNMENT;
+    }
+
+    template <typename T>
+    T load(const unsigned char *_data)
+    {
+        T value;
+        std::memcpy(&value, _data, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void store(std::vector<unsigned char> &_buffer, std::uint64_t _offset, const T &_value)
+    {
+        std::memcpy(_buffer.data() + _offset, &_value, sizeof(T));
+    }
+
+    std::uint64_t zigzag(std::int64_t _value)
+    {
+        return (static_cast<std::uint64_t>(_value) << 1) ^ static_cast<std::uint64_t>(_value >> 63);
+    }
+
+    std::int64_t unzigzag(std::uint64_t _value)
+    {
+        return static_cast<std::int64_t>(_value >> 1) ^ -static_cast<std::int64_t>(_value & 1);
+    }
+
+    void putVarint(std::vector<unsigned char> &_buffer, std::uint64_t _value)
+    {
+        while (_value >= 0x80)
+        {
+            _buffer.push_back(static_cast<unsigned char>(_value | 0x80));
+            _value >>= 7;
+        }
+        _buffer.push_back(static_cast<unsigned char>(_value));
+    }
+
+    bool getVarint(const unsigned char *&_cursor, const unsigned char *_end, std::uint64_t &_value)
+    {
+        _value = 0;
+        for (int shift = 0; shift < 64 and _cursor < _end; shift += 7)
+        {
+            const unsigned char byte = *_cursor++;
+            _value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if (not(byte & 0x80))
+                return true;
+        }
+
+        return false;
+    }
+
+    std::int64_t quantize(double _value, double _quantum)
+    {
+        return std::llround(_value / _quantum);
+    }
+
+    // Times are stored as zig-zag deltas plus one; zero encodes TimePoint::max()
+    void putTime(std::vector<unsigned char> &_buffer, Traj::TrajCodec::DeltaState &_state,
+                 const Time::TimePoint &_time, double _quantum)
+    {
+        if (_time == Time::TimePoint::max())
+        {
+            putVarint(_buffer, 0);
+            return;
+        }
+
+        const std::int64_t time = quantize(_time.count(), _quantum);
+        putVarint(_buffer, zigzag(time - _state.time_) + 1);
+        _state.time_ = time;
+    }
+
+    void putNode(std::vector<unsigned char> &_buffer, Traj::TrajCodec::DeltaState &_state,
+                 const Traj::SingleTraj::Node &_node, const Traj::TrajCodec::Quantization &_quantization)
+    {
+        const std::int64_t x = quantize(_node.pose_.component_.x, _quantization.position_);
+        const std::int64_t y = quantize(_node.pose_.component_.y, _quantization.position_);
+        const std::int64_t theta = quantize(_node.pose_.component_.theta, _quantization.angle_);
+        putVarint(_buffer, zigzag(x - _state.x_));
+        putVarint(_buffer, zigzag(y - _state.y_));
+        putVarint(_buffer, zigzag(theta - _state.theta_));
+        _state.x_ = x;
+        _state.y_ = y;
+        _state.theta_ = theta;
+
+        putTime(_buffer, _state, _node.arrival_time_, _quantization.time_);
+        putTime(_buffer, _state, _node.departure_time_, _quantization.time_);
+    }
+} // namespace
+
+std::vector<unsigned char> Traj::TrajCodec::encode(const TrajSet &_trajSet, const Quantization &_quantization)
+{
+    try
+    {
+        if (not(_quantization.position_ > 0 and _quantization.angle_ > 0 and _quantization.time_ > 0))
+            throw _quantization;
+    }
+    catch (const Quantization &_invalid_quantization)
+    {
+        std::cerr << "[Error] TrajCodec::encode(): "
+                  << "Invalid Quantization: " << _invalid_quantization.position_ << "m, "
+                  << _invalid_quantization.angle_ << "rad, " << _invalid_quantization.time_ << "s" << std::endl;
+        std::abort();
+    }
+
+    // Intern keys and agent names; they are almost always the same string
+    std::vector<const std::string *> strings;
+    std::unordered_map<std::string_view, std::uint32_t> stringIds;
+    const auto intern = [&](const std::string &_text)
+    {
+        const auto [id, inserted] = stringIds.try_emplace(_text, static_cast<std::uint32_t>(strings.size()));
+        if (inserted)
+            strings.push_back(&_text);
+        return id->second;
+    };
+
+    std::vector<Record> records;
+    records.reserve(_trajSet.size());
+    for (const auto &[key, traj] : _trajSet)
+    {
+        Record record;
+        std::memset(&record, 0, sizeof(record));
+        record.key_string_ = intern(key);
+        record.name_string_ = intern(traj.agentName_);
+        record.pair_count_ = static_cast<std::uint32_t>(traj.nodes_.size());
+        record.cost_ = traj.cost_;
+        records.push_back(record);
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic_, TRAJ_MAGIC, sizeof(TRAJ_MAGIC));
+    header.version_ = TRAJ_VERSION;
+    header.endian_ = TRAJ_ENDIAN;
+    header.traj_count_ = static_cast<std::uint32_t>(records.size());
+    header.string_count_ = static_cast<std::uint32_t>(strings.size());
+    header.position_quantum_ = _quantization.position_;
+    header.angle_quantum_ = _quantization.angle_;
+    header.time_quantum_ = _quantization.time_;
+
+    // String table: count + 1 offsets relative to the character data, then the characters
+    std::uint64_t characters = 0;
+    for (const auto *text : strings)
+        characters += text->size();
+    header.strings_offset_ = align(sizeof(Header));
+    header.records_offset_ = align(header.strings_offset_ + (strings.size() + 1) * sizeof(std::uint32_t) + characters);
+    header.body_offset_ = align(header.records_offset_ + records.size() * sizeof(Record));
+
+    std::vector<unsigned char> buffer(header.body_offset_, 0);
+    std::uint64_t offsetPosition = header.strings_offset_;
+    std::uint64_t characterPosition = header.strings_offset_ + (strings.size() + 1) * sizeof(std::uint32_t);
+    std::uint32_t characterOffset = 0;
+    for (const auto *text : strings)
+    {
+        store(buffer, offsetPosition, characterOffset);
+        std::memcpy(buffer.data() + characterPosition, text->data(), text->size());
+        offsetPosition += sizeof(std::uint32_t);
+        characterPosition += text->size();
+        characterOffset += static_cast<std::uint32_t>(text->size());
+    }
+    store(buffer, offsetPosition, characterOffset);
+
+    auto record = records.begin();
+    for (const auto &trajPair : _trajSet)
+    {
+        record->body_offset_ = buffer.size();
+
+        DeltaState state;
+        for (const auto &[from, to] : trajPair.second.nodes_)
+        {
+            putNode(buffer, state, from, _quantization);
+            putNode(buffer, state, to, _quantization);
+        }
+        ++record;
+    }
+
+    for (std::size_t i = 0; i < records.size(); ++i)
+        store(buffer, header.records_offset_ + i * sizeof(Record), records[i]);
+
+    header.file_bytes_ = buffer.size();
+    store(buffer, 0, header);
+
+    return buffer;
+}
+
+bool Traj::TrajCodec::write(const std::string &_path, const TrajSet &_trajSet, const Quantization &_quantization)
+{
+    const std::vector<unsigned char> buffer = encode(_trajSet, _quantization);
+
+    // Write next to the target and rename, so readers never map a partial file
+    const std::string temporaryPath = _path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (not(file.is_open()))
+        {
+            std::cerr << "[Error] TrajCodec::write(): Cannot write " << temporaryPath << std::endl;
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+        if (not(file.good()))
+        {
+            std::cerr << "[Error] TrajCodec::write(): Failed writing " << temporaryPath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, _path, error);
+    if (error)
+    {
+        std::cerr << "[Error] TrajCodec::write(): " << error.message() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+Traj::TrajView::NodeIterator &Traj::TrajView::NodeIterator::operator++()
+{
+    if (remaining_ == 0)
+        return *this;
+
+    --remaining_;
+    if (remaining_ > 0 and not(decode(pair_.first) and decode(pair_.second)))
+        remaining_ = 0;
+
+    return *this;
+}
+
+bool Traj::TrajView::NodeIterator::decode(SingleTraj::Node &_node)
+{
+    const TrajCodec::Header &header = set_->header_;
+    std::uint64_t dx, dy, dtheta;
+    if (not(getVarint(cursor_, end_, dx) and getVarint(cursor_, end_, dy) and getVarint(cursor_, end_, dtheta)))
+        return false;
+
+    state_.x_ += unzigzag(dx);
+    state_.y_ += unzigzag(dy);
+    state_.theta_ += unzigzag(dtheta);
+    _node.pose_ = Position::Pose(state_.x_ * header.position_quantum_, state_.y_ * header.position_quantum_,
+                                 state_.theta_ * header.angle_quantum_);
+
+    for (Time::TimePoint *time : {&_node.arrival_time_, &_node.departure_time_})
+    {
+        std::uint64_t delta;
+        if (not getVarint(cursor_, end_, delta))
+            return false;
+
+        if (delta == 0)
+        {
+            *time = Time::TimePoint::max();
+            continue;
+        }
+        state_.time_ += unzigzag(delta - 1);
+        *time = Time::TimePoint(state_.time_ * header.time_quantum_);
+    }
+
+    return true;
+}
+
+std::string_view Traj::TrajView::key() const
+{
+    return set_->string(record_.key_string_);
+}
+
+std::string_view Traj::TrajView::agentName() const
+{
+    return set_->string(record_.name_string_);
+}
+
+Traj::TrajView::NodeIterator Traj::TrajView::begin() const
+{
+    NodeIterator iterator;
+    iterator.set_ = set_;
+    iterator.cursor_ = set_->data_ + record_.body_offset_;
+    iterator.end_ = set_->data_ + body_end_;
+    iterator.remaining_ = record_.pair_count_;
+    if (iterator.remaining_ > 0 and not(iterator.decode(iterator.pair_.first) and iterator.decode(iterator.pair_.second)))
+        iterator.remaining_ = 0;
+
+    return iterator;
+}
+
+Traj::SingleTraj Traj::TrajView::toSingleTraj() const
+{
+    SingleTraj traj;
+    traj.agentName_ = std::string(agentName());
+    traj.cost_ = cost();
+    traj.nodes_.reserve(size());
+    for (const auto &nodePair : *this)
+        traj.nodes_.push_back(nodePair);
+
+    return traj;
+}
+
+bool Traj::TrajSetView::open(const unsigned char *_data, std::size_t _size, std::shared_ptr<const void> _backing)
+{
+    data_ = nullptr;
+    size_ = 0;
+    backing_.reset();
+    std::memset(&header_, 0, sizeof(header_));
+
+    if (_data == nullptr or _size < sizeof(TrajCodec::Header))
+        return false;
+
+    const auto header = load<TrajCodec::Header>(_data);
+    if (std::memcmp(header.magic_, TRAJ_MAGIC, sizeof(TRAJ_MAGIC)) != 0 or header.version_ != TRAJ_VERSION or
+        header.endian_ != TRAJ_ENDIAN or header.file_bytes_ != _size)
+    {
+        std::cerr << "[Error] TrajSetView::open(): Not a version " << TRAJ_VERSION << " trajectory set" << std::endl;
+        return false;
+    }
+
+    // Every offset is bounded by _size before anything is added to it, so no end can wrap
+    bool valid = header.strings_offset_ >= sizeof(TrajCodec::Header) and header.strings_offset_ <= _size and
+                 static_cast<std::uint64_t>(header.string_count_) + 1 <= (_size - header.strings_offset_) / sizeof(std::uint32_t);
+    const std::uint64_t offsetsEnd = valid ? header.strings_offset_ + (static_cast<std::uint64_t>(header.string_count_) + 1) * sizeof(std::uint32_t) : 0;
+    valid = valid and header.records_offset_ >= offsetsEnd and header.records_offset_ <= _size and
+            header.traj_count_ <= (_size - header.records_offset_) / sizeof(TrajCodec::Record);
+    const std::uint64_t recordsEnd = valid ? header.records_offset_ + static_cast<std::uint64_t>(header.traj_count_) * sizeof(TrajCodec::Record) : 0;
+    valid = valid and header.body_offset_ >= recordsEnd and header.body_offset_ <= _size;
+    std::uint32_t previousCharacter = 0;
+    for (std::uint32_t i = 0; valid and i <= header.string_count_; ++i)
+    {
+        const auto character = load<std::uint32_t>(_data + header.strings_offset_ + i * sizeof(std::uint32_t));
+        valid = character >= previousCharacter and offsetsEnd + character <= header.records_offset_;
+        previousCharacter = character;
+    }
+    std::uint64_t previousBody = header.body_offset_;
+    for (std::uint32_t i = 0; valid and i < header.traj_count_; ++i)
+    {
+        const auto record = load<TrajCodec::Record>(_data + header.records_offset_ + i * sizeof(TrajCodec::Record));
+        valid = record.key_string_ < header.string_count_ and record.name_string_ < header.string_count_ and
+                record.body_offset_ >= previousBody and record.body_offset_ <= _size;
+        previousBody = record.body_offset_;
+    }
+    if (not valid)
+    {
+        std::cerr << "[Error] TrajSetView::open(): Corrupt trajectory set tables" << std::endl;
+        return false;
+    }
+
+    data_ = _data;
+    size_ = _size;
+    backing_ = std::move(_backing);
+    header_ = header;
+
+    return true;
+}
+
+bool Traj::TrajSetView::open(const std::string &_path)
+{
+    const auto file = MappedFile::open(_path);
+    if (not(file))
+    {
+        std::cerr << "[Error] TrajSetView::open(): Cannot map " << _path << std::endl;
+        return false;
+    }
+
+    return open(file->data(), file->size(), file);
+}
+
+Traj::TrajView Traj::TrajSetView::operator[](std::size_t _i) const
+{
+    const std::uint64_t bodyEnd = _i + 1 < header_.traj_count_ ? record(_i + 1).body_offset_ : header_.file_bytes_;
+    return TrajView(this, record(_i), bodyEnd);
+}
+
+std::optional<Traj::TrajView> Traj::TrajSetView::find(std::string_view _key) const
+{
+    std::size_t low = 0, high = size();
+    while (low < high)
+    {
+        const std::size_t middle = (low + high) / 2;
+        if (string(record(middle).key_string_) < _key)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    if (low == size() or string(record(low).key_string_) != _key)
+        return std::nullopt;
+
+    return (*this)[low];
+}
+
+Traj::TrajSet Traj::TrajSetView::toTrajSet() const
+{
+    TrajSet trajSet;
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        const TrajView traj = (*this)[i];
+        trajSet.emplace_hint(trajSet.end(), std::string(traj.key()), traj.toSingleTraj());
+    }
+
+    return trajSet;
+}
+
+std::string_view Traj::TrajSetView::string(std::uint32_t _id) const
+{
+    const unsigned char *offsets = data_ + header_.strings_offset_;
+    const unsigned char *characters = offsets + (static_cast<std::uint64_t>(header_.string_count_) + 1) * sizeof(std::uint32_t);
+    const auto begin = load<std::uint32_t>(offsets + _id * sizeof(std::uint32_t));
+    const auto end = load<std::uint32_t>(offsets + (_id + 1) * sizeof(std::uint32_t));
+
+    return std::string_view(reinterpret_cast<const char *>(characters) + begin, end - begin);
+}
+
+Traj::TrajCodec::Record Traj::TrajSetView::record(std::size_t _i) const
+{
+    return load<TrajCodec::Record>(data_ + header_.records_offset_ + _i * sizeof(TrajCodec::Record));
+}
\ No newline at end of file
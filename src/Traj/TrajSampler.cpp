@@ -0,0 +1,71 @@
+#include "multibot_util/Traj/TrajSampler.hpp"
+
+#include <iostream>
+
+using namespace MAPF_Util;
+
+namespace
+{
+    void checkBuffer(const char *_caller, std::size_t _agents, std::size_t _poses)
+    {
+        try
+        {
+            if (_poses < _agents)
+                throw _poses;
+        }
+        catch (const std::size_t &_invalid_size)
+        {
+            std::cerr << "[Error] " << _caller << ": "
+                      << "Pose buffer holds " << _invalid_size << " poses for " << _agents << " agents" << std::endl;
+            std::abort();
+        }
+    }
+} // namespace
+
+void Traj::TrajSampler::reset(const TrajSet &_trajSet)
+{
+    agent_names_.clear();
+    trajs_.clear();
+    agent_names_.reserve(_trajSet.size());
+    trajs_.reserve(_trajSet.size());
+    for (const auto &[agentName, traj] : _trajSet)
+    {
+        agent_names_.push_back(&agentName);
+        trajs_.push_back(&traj);
+    }
+
+    cursors_.assign(trajs_.size(), 0);
+    last_time_ = Time::TimePoint(-std::numeric_limits<double>::infinity());
+}
+
+void Traj::TrajSampler::sample(const Time::TimePoint &_time, std::span<Position::Pose> _poses)
+{
+    checkBuffer("TrajSampler::sample()", trajs_.size(), _poses.size());
+
+    const bool forward = _time >= last_time_;
+    for (std::size_t i = 0; i < trajs_.size(); ++i)
+    {
+        const SingleTraj &traj = *trajs_[i];
+        std::size_t &cursor = cursors_[i];
+        if (forward)
+        {
+            while (cursor + 1 < traj.nodes_.size() and traj.nodes_[cursor + 1].first.arrival_time_ <= _time)
+                ++cursor;
+        }
+        else
+            cursor = traj.locate(_time);
+
+        _poses[i] = traj.interpolate(cursor, _time);
+    }
+
+    last_time_ = _time;
+}
+
+void Traj::sample(const TrajSet &_trajSet, const Time::TimePoint &_time, std::span<Position::Pose> _poses)
+{
+    checkBuffer("Traj::sample()", _trajSet.size(), _poses.size());
+
+    std::size_t i = 0;
+    for (const auto &trajPair : _trajSet)
+        _poses[i++] = trajPair.second.poseAt(_time);
+}
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "multibot_util/MAPF_Util.hpp"
+
+#if defined(__x86_64__) and (defined(__GNUC__) or defined(__clang__))
+#include <immintrin.h>
+#define MULTIBOT_UTIL_AVX2_DISPATCH
+#endif
+
+using namespace MAPF_Util;
+
+namespace
+{
+    void checkSize(const char *_caller, std::size_t _size, std::size_t _required)
+    {
+        try
+        {
+            if (_size < _required)
+                throw _size;
+        }
+        catch (const std::size_t &_invalid_size)
+        {
+            std::cerr << "[Error] Position::" << _caller << "(): "
+                      << "Array of " << _invalid_size << " elements for " << _required << " inputs" << std::endl;
+            std::abort();
+        }
+    }
+
+    struct CoordinatesAccess
+    {
+        static double x(const Position::Coordinates &_coord) { return _coord.x_; }
+        static double y(const Position::Coordinates &_coord) { return _coord.y_; }
+    }; // struct CoordinatesAccess
+
+    struct PoseAccess
+    {
+        static double x(const Position::Pose &_pose) { return _pose.component_.x; }
+        static double y(const Position::Pose &_pose) { return _pose.component_.y; }
+        static double theta(const Position::Pose &_pose) { return _pose.component_.theta; }
+    }; // struct PoseAccess
+
+    // Kernels read _second[i * _stride], so a stride of 0 compares every
+    // element of _first against one target. The scalar loops are the fallback
+    // and the tails of the AVX2 kernels; both round identically (no FMA).
+    namespace BatchKernel
+    {
+        template <typename Access, typename Point>
+        void distances(const Point *_first, const Point *_second, std::size_t _stride, double *_out,
+                       std::size_t _begin, std::size_t _end)
+        {
+            for (std::size_t i = _begin; i < _end; ++i)
+            {
+                const double dx = Access::x(_first[i]) - Access::x(_second[i * _stride]);
+                const double dy = Access::y(_first[i]) - Access::y(_second[i * _stride]);
+                _out[i] = std::sqrt(dx * dx + dy * dy);
+            }
+        }
+
+        void angleDiffs(const Position::Pose *_first, const Position::Pose *_second, std::size_t _stride, double *_out,
+                        std::size_t _begin, std::size_t _end)
+        {
+            for (std::size_t i = _begin; i < _end; ++i)
+                _out[i] = std::fabs(Position::normalizeAngle(PoseAccess::theta(_first[i]) - PoseAccess::theta(_second[i * _stride])));
+        }
+
+        void crossProducts(const Position::Coordinates *_first, const Position::Coordinates *_second, double *_out,
+                           std::size_t _begin, std::size_t _end)
+        {
+            for (std::size_t i = _begin; i < _end; ++i)
+                _out[i] = _first[i].x_ * _second[i].y_ - _first[i].y_ * _second[i].x_;
+        }
+
+#ifdef MULTIBOT_UTIL_AVX2_DISPATCH
+        bool hasAvx2()
+        {
+            static const bool supported = __builtin_cpu_supports("avx2");
+            return supported;
+        }
+
+        // Gathers one field of four consecutive points into a register
+        template <typename Point, typename Field>
+        __attribute__((target("avx2"))) inline __m256d load4(const Point *_points, std::size_t _i, std::size_t _stride, Field _field)
+        {
+            return _mm256_setr_pd(_field(_points[_i * _stride]), _field(_points[(_i + 1) * _stride]),
+                                  _field(_points[(_i + 2) * _stride]), _field(_points[(_i + 3) * _stride]));
+        }
+
+        template <typename Access, typename Point>
+        __attribute__((target("avx2"))) void distancesAvx2(const Point *_first, const Point *_second, std::size_t _stride,
+                                                           double *_out, std::size_t _count)
+        {
+            std::size_t i = 0;
+            for (; i + 4 <= _count; i += 4)
+            {
+                const __m256d dx = _mm256_sub_pd(load4(_first, i, 1, Access::x), load4(_second, i, _stride, Access::x));
+                const __m256d dy = _mm256_sub_pd(load4(_first, i, 1, Access::y), load4(_second, i, _stride, Access::y));
+                _mm256_storeu_pd(_out + i, _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy))));
+            }
+            distances<Access>(_first, _second, _stride, _out, i, _count);
+        }
+
+        __attribute__((target("avx2"))) void angleDiffsAvx2(const Position::Pose *_first, const Position::Pose *_second,
+                                                            std::size_t _stride, double *_out, std::size_t _count)
+        {
+            const __m256d twoPi = _mm256_set1_pd(2 * M_PI);
+            const __m256d signMask = _mm256_set1_pd(-0.0);
+
+            std::size_t i = 0;
+            for (; i + 4 <= _count; i += 4)
+            {
+                const __m256d diff = _mm256_sub_pd(load4(_first, i, 1, PoseAccess::theta), load4(_second, i, _stride, PoseAccess::theta));
+                const __m256d turns = _mm256_round_pd(_mm256_div_pd(diff, twoPi), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                const __m256d wrapped = _mm256_sub_pd(diff, _mm256_mul_pd(twoPi, turns));
+                _mm256_storeu_pd(_out + i, _mm256_andnot_pd(signMask, wrapped));
+            }
+            angleDiffs(_first, _second, _stride, _out, i, _count);
+        }
+
+        __attribute__((target("avx2"))) void crossProductsAvx2(const Position::Coordinates *_first, const Position::Coordinates *_second,
+                                                               double *_out, std::size_t _count)
+        {
+            std::size_t i = 0;
+            for (; i + 4 <= _count; i += 4)
+            {
+                const __m256d xy = _mm256_mul_pd(load4(_first, i, 1, CoordinatesAccess::x), load4(_second, i, 1, CoordinatesAccess::y));
+                const __m256d yx = _mm256_mul_pd(load4(_first, i, 1, CoordinatesAccess::y), load4(_second, i, 1, CoordinatesAccess::x));
+                _mm256_storeu_pd(_out + i, _mm256_sub_pd(xy, yx));
+            }
+            crossProducts(_first, _second, _out, i, _count);
+        }
+#endif
+    } // namespace BatchKernel
+
+    template <typename Access, typename Point>
+    void dispatchDistances(const Point *_first, const Point *_second, std::size_t _stride, double *_out, std::size_t _count)
+    {
+#ifdef MULTIBOT_UTIL_AVX2_DISPATCH
+        if (BatchKernel::hasAvx2())
+            return BatchKernel::distancesAvx2<Access>(_first, _second, _stride, _out, _count);
+#endif
+        BatchKernel::distances<Access>(_first, _second, _stride, _out, 0, _count);
+    }
+
+    void dispatchAngleDiffs(const Position::Pose *_first, const Position::Pose *_second, std::size_t _stride,
+                            double *_out, std::size_t _count)
+    {
+#ifdef MULTIBOT_UTIL_AVX2_DISPATCH
+        if (BatchKernel::hasAvx2())
+            return BatchKernel::angleDiffsAvx2(_first, _second, _stride, _out, _count);
+#endif
+        BatchKernel::angleDiffs(_first, _second, _stride, _out, 0, _count);
+    }
+} // namespace
+
+void Position::getDistances(std::span<const Coordinates> _first, std::span<const Coordinates> _second, std::span<double> _distances)
+{
+    checkSize("getDistances", _second.size(), _first.size());
+    checkSize("getDistances", _distances.size(), _first.size());
+
+    dispatchDistances<CoordinatesAccess>(_first.data(), _second.data(), 1, _distances.data(), _first.size());
+}
+
+void Position::getDistances(std::span<const Coordinates> _first, const Coordinates &_target, std::span<double> _distances)
+{
+    checkSize("getDistances", _distances.size(), _first.size());
+
+    dispatchDistances<CoordinatesAccess>(_first.data(), &_target, 0, _distances.data(), _first.size());
+}
+
+void Position::getDistances(std::span<const Pose> _first, std::span<const Pose> _second, std::span<double> _distances)
+{
+    checkSize("getDistances", _second.size(), _first.size());
+    checkSize("getDistances", _distances.size(), _first.size());
+
+    dispatchDistances<PoseAccess>(_first.data(), _second.data(), 1, _distances.data(), _first.size());
+}
+
+void Position::getDistances(std::span<const Pose> _first, const Pose &_target, std::span<double> _distances)
+{
+    checkSize("getDistances", _distances.size(), _first.size());
+
+    dispatchDistances<PoseAccess>(_first.data(), &_target, 0, _distances.data(), _first.size());
+}
+
+void Position::getAngleDiffs(std::span<const Pose> _first, std::span<const Pose> _second, std::span<double> _angleDiffs)
+{
+    checkSize("getAngleDiffs", _second.size(), _first.size());
+    checkSize("getAngleDiffs", _angleDiffs.size(), _first.size());
+
+    dispatchAngleDiffs(_first.data(), _second.data(), 1, _angleDiffs.data(), _first.size());
+}
+
+void Position::getAngleDiffs(std::span<const Pose> _first, const Pose &_target, std::span<double> _angleDiffs)
+{
+    checkSize("getAngleDiffs", _angleDiffs.size(), _first.size());
+
+    dispatchAngleDiffs(_first.data(), &_target, 0, _angleDiffs.data(), _first.size());
+}
+
+void Position::crossProducts(std::span<const Coordinates> _first, std::span<const Coordinates> _second, std::span<double> _products)
+{
+    checkSize("crossProducts", _second.size(), _first.size());
+    checkSize("crossProducts", _products.size(), _first.size());
+
+#ifdef MULTIBOT_UTIL_AVX2_DISPATCH
+    if (BatchKernel::hasAvx2())
+        return BatchKernel::crossProductsAvx2(_first.data(), _second.data(), _products.data(), _first.size());
+#endif
+    BatchKernel::crossProducts(_first.data(), _second.data(), _products.data(), 0, _first.size());
+}
\ No newline at end of file
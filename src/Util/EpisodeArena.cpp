@@ -0,0 +1,38 @@
+#include "multibot_util/Util/EpisodeArena.hpp"
+
+#include <algorithm>
+
+using namespace MAPF_Util;
+
+std::size_t EpisodeArena::capacity() const
+{
+    std::size_t capacity = 0;
+    for (const auto &block : blocks_)
+        capacity += block.size_;
+
+    return capacity;
+}
+
+void *EpisodeArena::do_allocate(std::size_t _bytes, std::size_t _alignment)
+{
+    // Blocks kept from earlier episodes are reused in order; one too small
+    // for this request is skipped until the next reset()
+    for (;;)
+    {
+        for (; current_ < blocks_.size(); ++current_, offset_ = 0)
+        {
+            void *ptr = blocks_[current_].data_.get() + offset_;
+            std::size_t space = blocks_[current_].size_ - offset_;
+            if (std::align(_alignment, _bytes, ptr, space))
+            {
+                offset_ = static_cast<std::byte *>(ptr) - blocks_[current_].data_.get() + _bytes;
+                allocated_ += _bytes;
+                return ptr;
+            }
+        }
+
+        const std::size_t size = std::max(next_block_size_, _bytes + _alignment);
+        blocks_.push_back(Block{std::make_unique_for_overwrite<std::byte[]>(size), size});
+        next_block_size_ *= 2;
+    }
+}
\ No newline at end of file
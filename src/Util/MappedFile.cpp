@@ -0,0 +1,35 @@
+#include "multibot_util/Util/MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace MAPF_Util;
+
+std::shared_ptr<const MappedFile> MappedFile::open(const std::string &_path)
+{
+    const int fd = ::open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return nullptr;
+
+    struct stat status;
+    if (::fstat(fd, &status) != 0 or status.st_size <= 0)
+    {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const std::size_t size = static_cast<std::size_t>(status.st_size);
+    void *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        return nullptr;
+
+    return std::make_shared<const MappedFile>(data, size);
+}
+
+MappedFile::~MappedFile()
+{
+    ::munmap(data_, size_);
+}
@@ -0,0 +1,153 @@
+#include "multibot_util/Util/Parallel.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace MAPF_Util;
+
+namespace
+{
+    struct Job
+    {
+        std::size_t end_;
+        std::size_t chunk_;
+        unsigned int workers_;
+        void (*invoke_)(void *, std::size_t, std::size_t, unsigned int);
+        void *context_;
+
+        std::atomic<std::size_t> next_;
+        // Worker ids handed out so far, the caller's 0 included
+        unsigned int joined_ = 1;
+        // Pool threads still running chunks of this job
+        std::atomic<unsigned int> active_{0};
+
+        bool exhausted() const
+        {
+            return next_.load(std::memory_order_relaxed) >= end_;
+        }
+
+        void work(unsigned int _worker)
+        {
+            for (;;)
+            {
+                const std::size_t chunkBegin = next_.fetch_add(chunk_, std::memory_order_relaxed);
+                if (chunkBegin >= end_)
+                    return;
+                invoke_(context_, chunkBegin, std::min(end_, chunkBegin + chunk_), _worker);
+            }
+        }
+    }; // struct Job
+
+    class Pool
+    {
+    public:
+        void submit(const std::shared_ptr<Job> &_job)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                if (threads_.empty())
+                    start();
+                jobs_.push_back(_job);
+            }
+            cv_.notify_all();
+        }
+
+        // After this no pool thread can join _job; the ones that did are waited for
+        void retire(const std::shared_ptr<Job> &_job)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                const auto job = std::find(jobs_.begin(), jobs_.end(), _job);
+                if (job != jobs_.end())
+                    jobs_.erase(job);
+            }
+
+            for (unsigned int active = _job->active_.load(); active != 0; active = _job->active_.load())
+                _job->active_.wait(active);
+        }
+
+    private:
+        void start()
+        {
+            const unsigned int threads = Parallel::hardwareThreads() - 1;
+            for (unsigned int i = 0; i < threads; ++i)
+                threads_.emplace_back([this]()
+                                      { loop(); });
+        }
+
+        void loop()
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            for (;;)
+            {
+                cv_.wait(lock, [this]()
+                         { return stop_ or not(jobs_.empty()); });
+                if (stop_)
+                    return;
+
+                const std::shared_ptr<Job> job = jobs_.front();
+                if (job->exhausted() or job->joined_ >= job->workers_)
+                {
+                    jobs_.pop_front();
+                    continue;
+                }
+
+                const unsigned int worker = job->joined_++;
+                job->active_.fetch_add(1);
+                if (job->joined_ >= job->workers_)
+                    jobs_.pop_front();
+
+                lock.unlock();
+                job->work(worker);
+                if (job->active_.fetch_sub(1) == 1)
+                    job->active_.notify_all();
+                lock.lock();
+            }
+        }
+
+    private:
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        std::deque<std::shared_ptr<Job>> jobs_;
+        std::vector<std::thread> threads_;
+        bool stop_ = false;
+
+    public:
+        ~Pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+            for (auto &thread : threads_)
+                thread.join();
+        }
+    }; // class Pool
+
+    Pool &pool()
+    {
+        static Pool instance;
+        return instance;
+    }
+} // namespace
+
+void Parallel::run(std::size_t _begin, std::size_t _end, std::size_t _chunk, unsigned int _workers,
+                   void (*_invoke)(void *, std::size_t, std::size_t, unsigned int), void *_context)
+{
+    auto job = std::make_shared<Job>();
+    job->end_ = _end;
+    job->chunk_ = _chunk;
+    job->workers_ = _workers;
+    job->invoke_ = _invoke;
+    job->context_ = _context;
+    job->next_.store(_begin, std::memory_order_relaxed);
+
+    pool().submit(job);
+    job->work(0);
+    pool().retire(job);
+}
\ No newline at end of file
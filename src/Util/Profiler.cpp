@@ -0,0 +1,389 @@
+#include "multibot_util/Util/Profiler.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace MAPF_Util;
+
+namespace
+{
+    struct Event
+    {
+        const char *name_;
+        std::uint64_t begin_ns_;
+        std::uint64_t end_ns_;
+    }; // struct Event
+
+    constexpr std::size_t EVENT_BLOCK = 4096;
+
+    // Slots live in std::map nodes, so references handed out stay valid.
+    // mtx_ is only contended while an export or reset runs. Events are
+    // appended by the owning thread alone into blocks that are never freed,
+    // and event_count_ publishes them to the exporter.
+    struct ThreadBuffer
+    {
+        std::uint32_t thread_id_;
+        // Guarded by Registry::mtx_
+        bool in_use_ = true;
+        std::mutex mtx_;
+        std::map<std::string, Profiler::ScopeStats> scopes_;
+        std::map<std::string, Profiler::Counter> counters_;
+        std::map<std::string, Profiler::Histogram> histograms_;
+        std::vector<std::unique_ptr<Event[]>> event_blocks_;
+        std::atomic<std::size_t> event_count_{0};
+        std::atomic<std::uint64_t> dropped_events_{0};
+    }; // struct ThreadBuffer
+
+    // Buffers outlive their threads so that their data can still be exported.
+    // A thread that exits hands its buffer back, and the next new thread
+    // keeps adding to it, so there are never more buffers than threads ever
+    // alive at once. shared_ is used by code running after its thread gave
+    // its buffer back, from other thread_local destructors.
+    struct Registry
+    {
+        std::mutex mtx_;
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+        std::shared_ptr<ThreadBuffer> shared_;
+        std::atomic<std::size_t> event_capacity_{std::size_t(1) << 20};
+        const std::chrono::steady_clock::time_point epoch_ = std::chrono::steady_clock::now();
+    }; // struct Registry
+
+    Registry &registry()
+    {
+        static Registry instance;
+        return instance;
+    }
+
+    std::shared_ptr<ThreadBuffer> createBuffer(Registry &_registry)
+    {
+        auto created = std::make_shared<ThreadBuffer>();
+        created->thread_id_ = static_cast<std::uint32_t>(_registry.buffers_.size());
+        _registry.buffers_.push_back(created);
+        return created;
+    }
+
+    thread_local ThreadBuffer *local_buffer = nullptr;
+    thread_local bool buffer_released = false;
+
+    class BufferLease
+    {
+    private:
+        std::shared_ptr<ThreadBuffer> buffer_;
+
+    public:
+        BufferLease()
+        {
+            std::lock_guard<std::mutex> lock(registry().mtx_);
+            for (const auto &buffer : registry().buffers_)
+            {
+                if (not buffer->in_use_)
+                {
+                    buffer_ = buffer;
+                    buffer_->in_use_ = true;
+                    break;
+                }
+            }
+            if (not buffer_)
+                buffer_ = createBuffer(registry());
+            local_buffer = buffer_.get();
+        }
+
+        ~BufferLease()
+        {
+            std::lock_guard<std::mutex> lock(registry().mtx_);
+            buffer_->in_use_ = false;
+            local_buffer = nullptr;
+            buffer_released = true;
+        }
+    }; // class BufferLease
+
+    // nullptr once the calling thread has given its buffer back
+    ThreadBuffer *localBuffer()
+    {
+        if (local_buffer == nullptr and not buffer_released)
+            thread_local BufferLease lease;
+
+        return local_buffer;
+    }
+
+    template <typename Slot>
+    Slot &slot(std::map<std::string, Slot> ThreadBuffer::*_slots, const char *_name)
+    {
+        ThreadBuffer *buffer = localBuffer();
+        if (buffer == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(registry().mtx_);
+            if (not registry().shared_)
+                registry().shared_ = createBuffer(registry());
+            buffer = registry().shared_.get();
+        }
+
+        std::lock_guard<std::mutex> lock(buffer->mtx_);
+        return (*buffer.*_slots)[_name];
+    }
+
+    // Calls _function on every thread buffer with that buffer locked
+    template <typename Function>
+    void forEachBuffer(Function &&_function)
+    {
+        std::lock_guard<std::mutex> lock(registry().mtx_);
+        for (const auto &buffer : registry().buffers_)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mtx_);
+            _function(*buffer);
+        }
+    }
+
+    std::string escape(const std::string &_text)
+    {
+        std::string escaped;
+        for (const char c : _text)
+        {
+            if (c == '"' or c == '\\')
+                escaped.push_back('\\');
+            escaped.push_back(c);
+        }
+
+        return escaped;
+    }
+
+    // Upper bound of the bucket holding the percentile, capped at the maximum
+    double approximatePercentile(const std::uint64_t (&_buckets)[Profiler::Histogram::BUCKETS], std::uint64_t _count,
+                                 double _max, double _ratio)
+    {
+        if (_count == 0)
+            return 0.0;
+
+        const std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(_ratio * _count));
+        std::uint64_t seen = 0;
+        for (int i = 0; i < Profiler::Histogram::BUCKETS; ++i)
+        {
+            seen += _buckets[i];
+            if (seen >= rank)
+                return std::min(std::ldexp(1.0, i), _max);
+        }
+
+        return _max;
+    }
+} // namespace
+
+void Profiler::Histogram::record(double _value)
+{
+    if (std::isnan(_value))
+        return;
+
+    const int bucket = _value < 1.0 ? 0 : std::min(BUCKETS - 1, std::ilogb(_value) + 1);
+    buckets_[bucket].store(buckets_[bucket].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    sum_.store(sum_.load(std::memory_order_relaxed) + _value, std::memory_order_relaxed);
+    if (_value > max_.load(std::memory_order_relaxed))
+        max_.store(_value, std::memory_order_relaxed);
+}
+
+std::uint64_t Profiler::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - registry().epoch_).count();
+}
+
+Profiler::ScopeStats &Profiler::scopeSlot(const char *_name)
+{
+    return slot(&ThreadBuffer::scopes_, _name);
+}
+
+Profiler::Counter &Profiler::counterSlot(const char *_name)
+{
+    return slot(&ThreadBuffer::counters_, _name);
+}
+
+Profiler::Histogram &Profiler::histogramSlot(const char *_name)
+{
+    return slot(&ThreadBuffer::histograms_, _name);
+}
+
+void Profiler::recordScope(const char *_name, ScopeStats &_stats, std::uint64_t _begin_ns, std::uint64_t _end_ns)
+{
+    const std::uint64_t duration = _end_ns - _begin_ns;
+    _stats.calls_.store(_stats.calls_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    _stats.total_ns_.store(_stats.total_ns_.load(std::memory_order_relaxed) + duration, std::memory_order_relaxed);
+    if (duration > _stats.max_ns_.load(std::memory_order_relaxed))
+        _stats.max_ns_.store(duration, std::memory_order_relaxed);
+
+    ThreadBuffer *buffer = localBuffer();
+    if (buffer == nullptr)
+        return;
+
+    std::size_t count = buffer->event_count_.load(std::memory_order_relaxed);
+    if (count >= registry().event_capacity_.load(std::memory_order_relaxed))
+    {
+        buffer->dropped_events_.store(buffer->dropped_events_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Only this thread grows the block list, so reading it needs no lock
+    if (count / EVENT_BLOCK == buffer->event_blocks_.size())
+    {
+        auto block = std::make_unique_for_overwrite<Event[]>(EVENT_BLOCK);
+        std::lock_guard<std::mutex> lock(buffer->mtx_);
+        buffer->event_blocks_.push_back(std::move(block));
+    }
+    buffer->event_blocks_[count / EVENT_BLOCK][count % EVENT_BLOCK] = Event{_name, _begin_ns, _end_ns};
+
+    // Fails only if reset() ran meanwhile, which drops this event
+    buffer->event_count_.compare_exchange_strong(count, count + 1, std::memory_order_release, std::memory_order_relaxed);
+}
+
+void Profiler::setEventCapacity(std::size_t _events_per_thread)
+{
+    registry().event_capacity_.store(_events_per_thread, std::memory_order_relaxed);
+}
+
+void Profiler::reset()
+{
+    forEachBuffer([](ThreadBuffer &_buffer)
+    {
+        for (auto &[name, stats] : _buffer.scopes_)
+        {
+            stats.calls_ = 0;
+            stats.total_ns_ = 0;
+            stats.max_ns_ = 0;
+        }
+        for (auto &[name, counter] : _buffer.counters_)
+            counter.value_ = 0;
+        for (auto &[name, histogram] : _buffer.histograms_)
+        {
+            for (auto &bucket : histogram.buckets_)
+                bucket = 0;
+            histogram.count_ = 0;
+            histogram.sum_ = 0.0;
+            histogram.max_ = 0.0;
+        }
+        _buffer.event_count_.store(0, std::memory_order_relaxed);
+        _buffer.dropped_events_.store(0, std::memory_order_relaxed);
+    });
+}
+
+bool Profiler::writeChromeTrace(const std::string &_path)
+{
+    std::ofstream file(_path);
+    if (not(file.is_open()))
+    {
+        std::cerr << "[Error] Profiler::writeChromeTrace(): Cannot open " << _path << std::endl;
+        return false;
+    }
+
+    const std::uint64_t end = now();
+    bool first = true;
+    const auto separator = [&]() -> const char *
+    {
+        const bool wasFirst = first;
+        first = false;
+        return wasFirst ? "\n" : ",\n";
+    };
+
+    file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" << std::fixed << std::setprecision(3);
+    forEachBuffer([&](ThreadBuffer &_buffer)
+    {
+        file << separator() << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << _buffer.thread_id_
+             << ", \"args\": {\"name\": \"thread " << _buffer.thread_id_ << "\"}}";
+
+        const std::size_t events = _buffer.event_count_.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < events; ++i)
+        {
+            const Event &event = _buffer.event_blocks_[i / EVENT_BLOCK][i % EVENT_BLOCK];
+            file << separator() << "{\"name\": \"" << escape(event.name_) << "\", \"ph\": \"X\", \"pid\": 1"
+                 << ", \"tid\": " << _buffer.thread_id_
+                 << ", \"ts\": " << event.begin_ns_ * 1e-3
+                 << ", \"dur\": " << (event.end_ns_ - event.begin_ns_) * 1e-3 << "}";
+        }
+
+        for (const auto &[name, counter] : _buffer.counters_)
+        {
+            file << separator() << "{\"name\": \"" << escape(name) << "\", \"ph\": \"C\", \"pid\": 1"
+                 << ", \"tid\": " << _buffer.thread_id_ << ", \"ts\": " << end * 1e-3
+                 << ", \"args\": {\"value\": " << counter.value_.load(std::memory_order_relaxed) << "}}";
+        }
+    });
+    file << "\n]}\n";
+
+    return file.good();
+}
+
+void Profiler::writeSummary(std::ostream &_os)
+{
+    struct ScopeTotal
+    {
+        std::uint64_t calls_ = 0, total_ns_ = 0, max_ns_ = 0;
+    };
+    struct HistogramTotal
+    {
+        std::uint64_t buckets_[Histogram::BUCKETS] = {};
+        std::uint64_t count_ = 0;
+        double sum_ = 0.0, max_ = 0.0;
+    };
+
+    std::map<std::string, ScopeTotal> scopes;
+    std::map<std::string, std::int64_t> counters;
+    std::map<std::string, HistogramTotal> histograms;
+    std::uint64_t droppedEvents = 0;
+    forEachBuffer([&](ThreadBuffer &_buffer)
+    {
+        for (const auto &[name, stats] : _buffer.scopes_)
+        {
+            auto &total = scopes[name];
+            total.calls_ += stats.calls_.load(std::memory_order_relaxed);
+            total.total_ns_ += stats.total_ns_.load(std::memory_order_relaxed);
+            total.max_ns_ = std::max(total.max_ns_, stats.max_ns_.load(std::memory_order_relaxed));
+        }
+        for (const auto &[name, counter] : _buffer.counters_)
+            counters[name] += counter.value_.load(std::memory_order_relaxed);
+        for (const auto &[name, histogram] : _buffer.histograms_)
+        {
+            auto &total = histograms[name];
+            for (int i = 0; i < Histogram::BUCKETS; ++i)
+                total.buckets_[i] += histogram.buckets_[i].load(std::memory_order_relaxed);
+            total.count_ += histogram.count_.load(std::memory_order_relaxed);
+            total.sum_ += histogram.sum_.load(std::memory_order_relaxed);
+            total.max_ = std::max(total.max_, histogram.max_.load(std::memory_order_relaxed));
+        }
+        droppedEvents += _buffer.dropped_events_.load(std::memory_order_relaxed);
+    });
+
+    const auto flags = _os.flags();
+    _os << std::fixed << std::setprecision(3);
+
+    _os << std::left << std::setw(48) << "Scope" << std::right << std::setw(12) << "Calls"
+        << std::setw(14) << "Total(ms)" << std::setw(14) << "Mean(us)" << std::setw(14) << "Max(us)" << std::endl;
+    for (const auto &[name, total] : scopes)
+    {
+        _os << std::left << std::setw(48) << name << std::right << std::setw(12) << total.calls_
+            << std::setw(14) << total.total_ns_ * 1e-6
+            << std::setw(14) << (total.calls_ > 0 ? total.total_ns_ * 1e-3 / total.calls_ : 0.0)
+            << std::setw(14) << total.max_ns_ * 1e-3 << std::endl;
+    }
+
+    _os << std::endl << std::left << std::setw(48) << "Counter" << std::right << std::setw(20) << "Value" << std::endl;
+    for (const auto &[name, value] : counters)
+        _os << std::left << std::setw(48) << name << std::right << std::setw(20) << value << std::endl;
+
+    _os << std::endl << std::left << std::setw(48) << "Histogram" << std::right << std::setw(12) << "Count"
+        << std::setw(14) << "Mean" << std::setw(14) << "~P50" << std::setw(14) << "~P99" << std::setw(14) << "Max" << std::endl;
+    for (const auto &[name, total] : histograms)
+    {
+        _os << std::left << std::setw(48) << name << std::right << std::setw(12) << total.count_
+            << std::setw(14) << (total.count_ > 0 ? total.sum_ / total.count_ : 0.0)
+            << std::setw(14) << approximatePercentile(total.buckets_, total.count_, total.max_, 0.5)
+            << std::setw(14) << approximatePercentile(total.buckets_, total.count_, total.max_, 0.99)
+            << std::setw(14) << total.max_ << std::endl;
+    }
+
+    if (droppedEvents > 0)
+        _os << std::endl << "[Warn] " << droppedEvents << " trace events dropped; raise setEventCapacity()" << std::endl;
+
+    _os.flags(flags);
+}
\ No newline at end of file
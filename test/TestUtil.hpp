@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+#include "multibot_util/Instance.hpp"
+
+namespace TestUtil
+{
+    inline Instance::MapInstance::BinaryOccupancyMap makeMap(int _width, int _height, double _resolution = 0.1,
+                                                             Position::Coordinates _origin = Position::Coordinates(0.0, 0.0))
+    {
+        Instance::MapInstance::BinaryOccupancyMap::MapProperty property;
+        property.origin_ = _origin;
+        property.width_ = _width;
+        property.height_ = _height;
+        property.resolution_ = _resolution;
+
+        Instance::MapInstance::BinaryOccupancyMap map;
+        map.initialize(property);
+
+        return map;
+    }
+
+    // Occupies every cell with probability _density
+    inline void scatterObstacles(Instance::MapInstance::BinaryOccupancyMap &_map, double _density, std::mt19937 &_rng)
+    {
+        std::bernoulli_distribution occupied(_density);
+        for (int y = 0; y < _map.property_.height_; ++y)
+            for (int x = 0; x < _map.property_.width_; ++x)
+                _map.setOccupied(Position::Index(x, y), occupied(_rng));
+    }
+
+    inline Position::Index randomIndex(const Instance::MapInstance::BinaryOccupancyMap &_map, std::mt19937 &_rng)
+    {
+        return Position::Index(std::uniform_int_distribution<int>(0, _map.property_.width_ - 1)(_rng),
+                               std::uniform_int_distribution<int>(0, _map.property_.height_ - 1)(_rng));
+    }
+
+    // Squared cell distance to the nearest occupied cell, by exhaustive search
+    inline std::uint32_t bruteForceSquaredDistance(const Instance::MapInstance::BitGrid &_occupancy, int _x, int _y)
+    {
+        std::uint32_t best = Instance::MapInstance::DistanceField::INF;
+        _occupancy.forEachSet([&](int _ox, int _oy)
+                              {
+                                  const std::uint32_t dx = static_cast<std::uint32_t>(std::abs(_ox - _x));
+                                  const std::uint32_t dy = static_cast<std::uint32_t>(std::abs(_oy - _y));
+                                  best = std::min(best, dx * dx + dy * dy);
+                              });
+
+        return best;
+    }
+
+    // Straight moves between (x, y, time) waypoints, heading along each move
+    inline Traj::SingleTraj makeTraj(const std::string &_agentName, const std::vector<std::array<double, 3>> &_waypoints)
+    {
+        Traj::SingleTraj traj;
+        traj.agentName_ = _agentName;
+        for (std::size_t i = 0; i + 1 < _waypoints.size(); ++i)
+        {
+            const auto &[x0, y0, t0] = _waypoints[i];
+            const auto &[x1, y1, t1] = _waypoints[i + 1];
+            const double heading = (x0 == x1 and y0 == y1) ? 0.0 : std::atan2(y1 - y0, x1 - x0);
+            traj.nodes_.emplace_back(Traj::Node{Position::Pose(x0, y0, heading), Time::TimePoint(t0), Time::TimePoint(t0)},
+                                     Traj::Node{Position::Pose(x1, y1, heading), Time::TimePoint(t1), Time::TimePoint(t1)});
+        }
+        traj.cost_ = _waypoints.empty() ? 0.0 : _waypoints.back()[2] - _waypoints.front()[2];
+
+        return traj;
+    }
+
+    // _nodes unit-ish moves and waits inside [0, _extent)^2, starting at time 0
+    inline Traj::SingleTraj randomTraj(const std::string &_agentName, int _nodes, double _extent, std::mt19937 &_rng)
+    {
+        std::uniform_real_distribution<double> coordinate(0.5, _extent - 0.5);
+        std::uniform_real_distribution<double> step(-1.0, 1.0);
+        std::uniform_real_distribution<double> duration(0.5, 2.0);
+
+        std::vector<std::array<double, 3>> waypoints{{coordinate(_rng), coordinate(_rng), 0.0}};
+        for (int i = 0; i < _nodes; ++i)
+        {
+            const auto &last = waypoints.back();
+            const bool wait = _rng() % 4 == 0;
+            waypoints.push_back({std::clamp(last[0] + (wait ? 0.0 : step(_rng)), 0.5, _extent - 0.5),
+                                 std::clamp(last[1] + (wait ? 0.0 : step(_rng)), 0.5, _extent - 0.5),
+                                 last[2] + duration(_rng)});
+        }
+
+        return makeTraj(_agentName, waypoints);
+    }
+} // namespace TestUtil
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+
+#include "multibot_util/MAPF_Util.hpp"
+
+using namespace MAPF_Util;
+
+namespace
+{
+    std::vector<Position::Pose> randomPoses(std::size_t _count, std::mt19937 &_rng)
+    {
+        std::uniform_real_distribution<double> coordinate(-100.0, 100.0);
+        std::uniform_real_distribution<double> angle(-20.0, 20.0);
+
+        std::vector<Position::Pose> poses;
+        for (std::size_t i = 0; i < _count; ++i)
+            poses.emplace_back(coordinate(_rng), coordinate(_rng), angle(_rng));
+
+        return poses;
+    }
+
+    std::vector<Position::Coordinates> coordinatesOf(const std::vector<Position::Pose> &_poses)
+    {
+        std::vector<Position::Coordinates> coordinates;
+        for (const auto &pose : _poses)
+            coordinates.emplace_back(pose.component_.x, pose.component_.y);
+
+        return coordinates;
+    }
+} // namespace
+
+TEST(Position, NormalizeAngleWrapsIntoPlusMinusPi)
+{
+    std::mt19937 rng(20);
+    std::uniform_real_distribution<double> angle(-1e4, 1e4);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const double value = angle(rng);
+        const double wrapped = Position::normalizeAngle(value);
+        ASSERT_LE(std::fabs(wrapped), M_PI) << value;
+        ASSERT_NEAR(std::remainder(wrapped - value, 2 * M_PI), 0.0, 1e-9) << value;
+    }
+    EXPECT_EQ(Position::normalizeAngle(0.0), 0.0);
+    EXPECT_DOUBLE_EQ(Position::getAngleDiff(Position::Pose(0, 0, 3.0), Position::Pose(0, 0, -3.0)), 2 * M_PI - 6.0);
+}
+
+TEST(Position, BatchKernelsMatchScalarBitForBit)
+{
+    std::mt19937 rng(21);
+    // Every tail length of the vector loops, and a long run
+    std::vector<std::size_t> sizes(18);
+    std::iota(sizes.begin(), sizes.end(), 0);
+    sizes.push_back(1001);
+
+    for (const std::size_t size : sizes)
+    {
+        const auto first = randomPoses(size, rng);
+        const auto second = randomPoses(size, rng);
+        const auto firstCoordinates = coordinatesOf(first);
+        const auto secondCoordinates = coordinatesOf(second);
+        const Position::Pose target = randomPoses(1, rng).front();
+        const Position::Coordinates targetCoordinates(target.component_.x, target.component_.y);
+
+        std::vector<double> out(size);
+        Position::getDistances(first, second, out);
+        for (std::size_t i = 0; i < size; ++i)
+            ASSERT_EQ(out[i], Position::getDistance(first[i], second[i])) << size << ": " << i;
+        Position::getDistances(first, target, out);
+        for (std::size_t i = 0; i < size; ++i)
+            ASSERT_EQ(out[i], Position::getDistance(first[i], target)) << size << ": " << i;
+        Position::getDistances(firstCoordinates, secondCoordinates, out);
+        for (std::size_t i = 0; i < size; ++i)
+            ASSERT_EQ(out[i], Position::getDistance(firstCoordinates[i], secondCoordinates[i])) << size << ": " << i;
+        Position::getDistances(firstCoordinates, targetCoordinates, out);
+        for (std::size_t i = 0; i < size; ++i)
+            ASSERT_EQ(out[i], Position::getDistance(firstCoordinates[i], targetCoordinates)) << size << ": " << i;
+
+        Position::getAngleDiffs(first, second, out);
+        for (std::size_t i = 0; i < size; ++i)
+            ASSERT_EQ(out[i], Position::getAngleDiff(first[i], second[i])) << size << ": " << i;
+        Position::getAngleDiffs(first, target, out);
+        for (std::size_t i = 0; i < size; ++i)
+            ASSERT_EQ(out[i], Position::getAngleDiff(first[i], target)) << size << ": " << i;
+
+        Position::crossProducts(firstCoordinates, secondCoordinates, out);
+        for (std::size_t i = 0; i < size; ++i)
+            ASSERT_EQ(out[i], Position::crossProduct(firstCoordinates[i], secondCoordinates[i])) << size << ": " << i;
+    }
+}
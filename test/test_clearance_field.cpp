@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include "TestUtil.hpp"
+
+using namespace Instance::MapInstance;
+
+namespace
+{
+    BinaryOccupancyMap makeScatteredMap(int _width, int _height, std::uint32_t _seed)
+    {
+        std::mt19937 rng(_seed);
+        auto map = TestUtil::makeMap(_width, _height, 0.05, Position::Coordinates(-1.0, 2.0));
+        TestUtil::scatterObstacles(map, 0.01, rng);
+        map.computeDistanceField();
+        return map;
+    }
+} // namespace
+
+TEST(ClearanceField, CellsHoldTheObstacleDistanceInMeters)
+{
+    auto map = makeScatteredMap(70, 50, 25);
+    const ClearanceField &field = map.clearanceField();
+    ASSERT_EQ(field.width(), 70);
+    ASSERT_EQ(field.height(), 50);
+
+    for (int y = 0; y < 50; ++y)
+    {
+        for (int x = 0; x < 70; ++x)
+        {
+            const double expected = std::sqrt(static_cast<double>(TestUtil::bruteForceSquaredDistance(map.mapData_, x, y))) * 0.05;
+            ASSERT_NEAR(field.cellClearance(x, y), expected, 1e-5) << x << ", " << y;
+            // Cell centers sample exactly
+            ASSERT_NEAR(field.clearance(map.getCoordinates(Position::Index(x, y))), field.cellClearance(x, y), 1e-9);
+        }
+    }
+
+    auto empty = TestUtil::makeMap(30, 40, 0.1);
+    EXPECT_DOUBLE_EQ(empty.clearanceField().maxClearance(), std::hypot(3.0, 4.0));
+    EXPECT_FLOAT_EQ(empty.clearanceField().cellClearance(7, 7), std::hypot(3.0, 4.0));
+}
+
+TEST(ClearanceField, InterpolatesBilinearlyWithAnExactGradient)
+{
+    auto map = makeScatteredMap(60, 60, 26);
+    const ClearanceField &field = map.clearanceField();
+
+    std::mt19937 rng(27);
+    std::uniform_real_distribution<double> offset(0.05, 0.95);
+    for (int i = 0; i < 2000; ++i)
+    {
+        const Position::Index idx(rng() % 59, rng() % 59);
+        const double tx = offset(rng), ty = offset(rng);
+        const Position::Coordinates corner = map.getCoordinates(idx);
+        const Position::Coordinates coord(corner.x_ + tx * 0.05, corner.y_ + ty * 0.05);
+
+        const double c00 = field.cellClearance(idx.x_, idx.y_), c10 = field.cellClearance(idx.x_ + 1, idx.y_);
+        const double c01 = field.cellClearance(idx.x_, idx.y_ + 1), c11 = field.cellClearance(idx.x_ + 1, idx.y_ + 1);
+        const double expected = (1 - ty) * ((1 - tx) * c00 + tx * c10) + ty * ((1 - tx) * c01 + tx * c11);
+
+        Position::Coordinates gradient;
+        ASSERT_NEAR(field.clearance(coord, gradient), expected, 1e-9);
+        ASSERT_NEAR(field.clearance(coord), expected, 1e-9);
+
+        // Bilinear is linear along each axis inside a cell, so a small difference is exact
+        const double h = 1e-4;
+        const double dx = (field.clearance(Position::Coordinates(coord.x_ + h, coord.y_)) -
+                           field.clearance(Position::Coordinates(coord.x_ - h, coord.y_))) / (2 * h);
+        const double dy = (field.clearance(Position::Coordinates(coord.x_, coord.y_ + h)) -
+                           field.clearance(Position::Coordinates(coord.x_, coord.y_ - h))) / (2 * h);
+        ASSERT_NEAR(gradient.x_, dx, 1e-6);
+        ASSERT_NEAR(gradient.y_, dy, 1e-6);
+    }
+}
+
+TEST(ClearanceField, BatchMatchesScalar)
+{
+    auto map = makeScatteredMap(50, 40, 28);
+    const ClearanceField &field = map.clearanceField();
+
+    std::mt19937 rng(29);
+    std::uniform_real_distribution<double> x(-2.0, 2.0), y(1.0, 5.0);
+    std::vector<Position::Coordinates> coords(333);
+    for (auto &coord : coords)
+        coord = Position::Coordinates(x(rng), y(rng));
+
+    std::vector<double> clearances(coords.size()), withGradient(coords.size());
+    std::vector<Position::Coordinates> gradients(coords.size());
+    field.clearances(coords, clearances);
+    field.clearances(coords, withGradient, gradients);
+    for (std::size_t i = 0; i < coords.size(); ++i)
+    {
+        Position::Coordinates gradient;
+        const double scalar = field.clearance(coords[i], gradient);
+        EXPECT_EQ(clearances[i], scalar);
+        EXPECT_EQ(withGradient[i], scalar);
+        EXPECT_EQ(gradients[i], gradient);
+    }
+}
+
+TEST(ClearanceField, ClampsOutsideTheMapAndPropagatesNan)
+{
+    auto map = makeScatteredMap(40, 30, 30);
+    const ClearanceField &field = map.clearanceField();
+    const double inf = std::numeric_limits<double>::infinity();
+
+    // Far outside, infinite ones included, reads the nearest border cell
+    EXPECT_DOUBLE_EQ(field.clearance(Position::Coordinates(-100.0, -100.0)), field.cellClearance(0, 0));
+    EXPECT_DOUBLE_EQ(field.clearance(Position::Coordinates(inf, inf)), field.cellClearance(39, 29));
+    EXPECT_DOUBLE_EQ(field.clearance(Position::Coordinates(-inf, inf)), field.cellClearance(0, 29));
+
+    Position::Coordinates gradient;
+    EXPECT_TRUE(std::isnan(field.clearance(Position::Coordinates(std::nan(""), 3.0), gradient)));
+    EXPECT_TRUE(std::isnan(gradient.x_) and std::isnan(gradient.y_));
+    EXPECT_TRUE(std::isnan(field.clearance(Position::Coordinates(0.0, std::nan("")))));
+
+    // A single row has no second cell to interpolate towards
+    auto row = TestUtil::makeMap(10, 1, 0.1);
+    row.markOccupied(Position::Index(0, 0));
+    EXPECT_NEAR(row.clearanceField().clearance(Position::Coordinates(0.45, 0.3)), 0.45, 1e-6);
+}
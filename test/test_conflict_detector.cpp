@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include "multibot_util/Agent/ConflictDetector.hpp"
+#include "TestUtil.hpp"
+
+using namespace Instance::AgentInstance;
+
+namespace
+{
+    // Position along straight moves, parked at the goal afterwards
+    Position::Coordinates positionAt(const Traj::SingleTraj &_traj, double _time)
+    {
+        for (const auto &[from, to] : _traj.nodes_)
+        {
+            if (_time > to.arrival_time_.count())
+                continue;
+
+            const double duration = to.arrival_time_.count() - from.departure_time_.count();
+            const double s = duration > 0 ? std::clamp((_time - from.departure_time_.count()) / duration, 0.0, 1.0) : 1.0;
+            return Position::Coordinates(from.pose_.component_.x + s * (to.pose_.component_.x - from.pose_.component_.x),
+                                         from.pose_.component_.y + s * (to.pose_.component_.y - from.pose_.component_.y));
+        }
+
+        const auto &goal = _traj.nodes_.back().second.pose_;
+        return Position::Coordinates(goal.component_.x, goal.component_.y);
+    }
+} // namespace
+
+TEST(ConflictDetector, FindsTheContactTimeOfCrossingDiscs)
+{
+    ConflictDetector detector;
+    detector.setRadius("a", 0.5);
+    detector.setRadius("b", 0.5);
+
+    // Head-on at 1 m/s each from 10 m apart: the discs touch when 1 m apart, at t = 4.5
+    Traj::TrajSet trajSet;
+    trajSet["a"] = TestUtil::makeTraj("a", {{{0.0, 0.0, 0.0}, {10.0, 0.0, 10.0}}});
+    trajSet["b"] = TestUtil::makeTraj("b", {{{10.0, 0.0, 0.0}, {0.0, 0.0, 10.0}}});
+
+    const auto conflict = detector.findFirstConflict(trajSet);
+    ASSERT_TRUE(conflict.has_value());
+    EXPECT_NEAR(conflict->time_.count(), 4.5, 1e-9);
+    EXPECT_NEAR(conflict->first_coord_.x_, 4.5, 1e-9);
+    EXPECT_NEAR(conflict->second_coord_.x_, 5.5, 1e-9);
+
+    // Passing 1.2 m apart never touches
+    trajSet["b"] = TestUtil::makeTraj("b", {{{10.0, 1.2, 0.0}, {0.0, 1.2, 10.0}}});
+    EXPECT_FALSE(detector.findFirstConflict(trajSet).has_value());
+    EXPECT_TRUE(detector.findConflicts(trajSet).empty());
+}
+
+TEST(ConflictDetector, ParkedAgentsBlockTheirGoal)
+{
+    ConflictDetector detector;
+    detector.setRadius("parked", 0.2);
+    detector.setRadius("passing", 0.2);
+
+    Traj::TrajSet trajSet;
+    trajSet["parked"] = TestUtil::makeTraj("parked", {{{0.0, 5.0, 0.0}, {5.0, 5.0, 1.0}}});
+    trajSet["passing"] = TestUtil::makeTraj("passing", {{{5.0, 0.0, 0.0}, {5.0, 10.0, 10.0}}});
+
+    const auto conflict = detector.findFirstConflict(trajSet);
+    ASSERT_TRUE(conflict.has_value());
+    EXPECT_NEAR(conflict->time_.count(), 4.6, 1e-9);
+
+    detector.setParkAtGoal(false);
+    EXPECT_FALSE(detector.findFirstConflict(trajSet).has_value());
+}
+
+TEST(ConflictDetector, MatchesSampledPairwiseDistances)
+{
+    constexpr int AGENTS = 60;
+    constexpr double STEP = 0.002;
+    std::mt19937 rng(10);
+
+    ConflictDetector detector;
+    Traj::TrajSet trajSet;
+    std::vector<std::string> names;
+    std::vector<double> radii;
+    double horizon = 0.0;
+    for (int i = 0; i < AGENTS; ++i)
+    {
+        names.push_back("agent" + std::to_string(i));
+        radii.push_back(0.1 + 0.05 * (i % 4));
+        trajSet[names.back()] = TestUtil::randomTraj(names.back(), 15, 12.0, rng);
+        detector.setRadius(names.back(), radii.back());
+        horizon = std::max(horizon, trajSet[names.back()].nodes_.back().second.arrival_time_.count());
+    }
+
+    const int samples = static_cast<int>(horizon / STEP) + 2;
+    std::vector<std::vector<Position::Coordinates>> positions(AGENTS);
+    for (int i = 0; i < AGENTS; ++i)
+        for (int k = 0; k < samples; ++k)
+            positions[i].push_back(positionAt(trajSet[names[i]], k * STEP));
+
+    std::map<std::pair<std::string, std::string>, double> reported;
+    const auto conflicts = detector.findConflicts(trajSet);
+    for (const auto &conflict : conflicts)
+        reported[std::minmax(conflict.first_agent_, conflict.second_agent_)] = conflict.time_.count();
+    ASSERT_EQ(reported.size(), conflicts.size());
+    ASSERT_FALSE(conflicts.empty());
+
+    for (int i = 0; i < AGENTS; ++i)
+    {
+        for (int j = i + 1; j < AGENTS; ++j)
+        {
+            const double reach = radii[i] + radii[j];
+            double closest = std::numeric_limits<double>::infinity();
+            double firstOverlap = std::numeric_limits<double>::infinity();
+            for (int k = 0; k < samples; ++k)
+            {
+                const double distance = std::hypot(positions[i][k].x_ - positions[j][k].x_, positions[i][k].y_ - positions[j][k].y_);
+                closest = std::min(closest, distance);
+                if (distance < reach - 1e-2 and firstOverlap == std::numeric_limits<double>::infinity())
+                    firstOverlap = k * STEP;
+            }
+
+            const auto conflict = reported.find(std::minmax(names[i], names[j]));
+            if (closest < reach - 1e-2)
+            {
+                ASSERT_NE(conflict, reported.end()) << names[i] << " x " << names[j];
+                EXPECT_LE(conflict->second, firstOverlap) << names[i] << " x " << names[j];
+            }
+            if (conflict != reported.end())
+            {
+                EXPECT_LE(closest, reach + 1e-2) << names[i] << " x " << names[j];
+            }
+        }
+    }
+
+    const auto first = detector.findFirstConflict(trajSet);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_DOUBLE_EQ(first->time_.count(), conflicts.front().time_.count());
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "multibot_util/Traj/DenseTrajSet.hpp"
+#include "TestUtil.hpp"
+
+using namespace MAPF_Util;
+
+TEST(AgentRegistry, InternsDenseStableIds)
+{
+    Traj::AgentRegistry registry;
+    EXPECT_EQ(registry.intern("b"), 0u);
+    EXPECT_EQ(registry.intern("a"), 1u);
+    EXPECT_EQ(registry.intern("b"), 0u);
+    EXPECT_EQ(registry.find("a"), 1u);
+    EXPECT_EQ(registry.find("c"), Traj::INVALID_AGENT);
+    EXPECT_FALSE(registry.contains(2));
+
+    // Names stay put while the registry grows
+    const std::string *name = &registry.name(0);
+    for (int i = 0; i < 1000; ++i)
+        registry.intern("agent" + std::to_string(i));
+    EXPECT_EQ(name, &registry.name(0));
+    EXPECT_EQ(*name, "b");
+    EXPECT_EQ(registry.size(), 1002u);
+}
+
+TEST(DenseTrajSet, RoundTripsATrajSet)
+{
+    std::mt19937 rng(13);
+    Traj::TrajSet trajSet;
+    for (int i = 0; i < 10; ++i)
+    {
+        const std::string name = "agent" + std::to_string(9 - i);
+        trajSet[name] = TestUtil::randomTraj(name, 5, 10.0, rng);
+    }
+
+    Traj::AgentRegistry registry;
+    const Traj::DenseTrajSet dense = Traj::DenseTrajSet::fromTrajSet(trajSet, registry);
+    EXPECT_EQ(dense.size(), trajSet.size());
+
+    const Traj::TrajSet restored = dense.toTrajSet();
+    ASSERT_EQ(restored.size(), trajSet.size());
+    for (const auto &[name, traj] : trajSet)
+    {
+        const Traj::AgentId id = registry.find(name);
+        ASSERT_TRUE(dense.contains(id));
+        EXPECT_EQ(dense[id].agentName_, name);
+        EXPECT_EQ(restored.at(name).cost_, traj.cost_);
+        ASSERT_EQ(restored.at(name).nodes_.size(), traj.nodes_.size());
+        EXPECT_EQ(restored.at(name).nodes_.back().second.pose_, traj.nodes_.back().second.pose_);
+    }
+}
+
+TEST(DenseTrajSet, EraseKeepsOtherSlotsInPlace)
+{
+    Traj::AgentRegistry registry;
+    Traj::DenseTrajSet dense(registry);
+    Traj::SingleTraj &first = dense.insert(TestUtil::makeTraj("a", {{{0.0, 0.0, 0.0}, {1.0, 0.0, 1.0}}}));
+    dense.insert(TestUtil::makeTraj("b", {{{0.0, 1.0, 0.0}, {1.0, 1.0, 1.0}}}));
+    for (int i = 0; i < 100; ++i)
+        dense.insert(TestUtil::makeTraj("c" + std::to_string(i), {{{0.0, 2.0, 0.0}, {1.0, 2.0, 1.0}}}));
+
+    const Traj::AgentId b = registry.find("b");
+    EXPECT_TRUE(dense.erase(b));
+    EXPECT_FALSE(dense.erase(b));
+    EXPECT_FALSE(dense.contains(b));
+    EXPECT_EQ(dense.find(b), nullptr);
+    EXPECT_EQ(dense.size(), 101u);
+    EXPECT_EQ(&first, dense.find(registry.find("a")));
+
+    std::vector<Traj::AgentId> visited;
+    dense.forEach([&](Traj::AgentId _id, const Traj::SingleTraj &) { visited.push_back(_id); });
+    ASSERT_EQ(visited.size(), dense.size());
+    EXPECT_TRUE(std::is_sorted(visited.begin(), visited.end()));
+
+    // Re-inserting reuses the agent's ID
+    dense.insert(TestUtil::makeTraj("b", {{{0.0, 1.0, 0.0}, {2.0, 1.0, 2.0}}}));
+    EXPECT_EQ(registry.find("b"), b);
+    EXPECT_EQ(dense[b].cost_, 2.0);
+
+    dense.clear();
+    EXPECT_TRUE(dense.empty());
+    EXPECT_FALSE(dense.contains(b));
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "multibot_util/Util/EpisodeArena.hpp"
+#include "TestUtil.hpp"
+
+using namespace MAPF_Util;
+
+TEST(EpisodeArena, HandsOutAlignedDisjointBlocks)
+{
+    EpisodeArena arena(256);
+    std::vector<std::pair<std::byte *, std::size_t>> allocations;
+    for (std::size_t i = 1; i < 200; ++i)
+    {
+        const std::size_t alignment = std::size_t(1) << (i % 7);
+        const std::size_t bytes = i * 3;
+        auto *ptr = static_cast<std::byte *>(arena.allocate(bytes, alignment));
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignment, 0u) << i;
+        std::memset(ptr, static_cast<int>(i), bytes);
+        allocations.emplace_back(ptr, bytes);
+    }
+
+    // Nothing was overwritten by a later allocation
+    for (std::size_t i = 0; i < allocations.size(); ++i)
+        for (std::size_t b = 0; b < allocations[i].second; ++b)
+            ASSERT_EQ(allocations[i].first[b], static_cast<std::byte>(i + 1)) << i;
+
+    // Larger than any block
+    EXPECT_NE(arena.allocate(1 << 20, 64), nullptr);
+    EXPECT_GE(arena.bytesAllocated(), std::size_t(1) << 20);
+}
+
+TEST(EpisodeArena, ResetReusesBlocksWithoutGrowing)
+{
+    EpisodeArena arena(1024);
+    const auto episode = [&arena]()
+    {
+        void *first = arena.allocate(64, 16);
+        for (int i = 0; i < 100; ++i)
+            (void)arena.allocate(100, 8);
+        return first;
+    };
+
+    void *first = episode();
+    const std::size_t capacity = arena.capacity();
+    const std::size_t allocated = arena.bytesAllocated();
+    for (int round = 0; round < 10; ++round)
+    {
+        arena.reset();
+        EXPECT_EQ(arena.bytesAllocated(), 0u);
+        EXPECT_EQ(episode(), first);
+        EXPECT_EQ(arena.capacity(), capacity);
+        EXPECT_EQ(arena.bytesAllocated(), allocated);
+    }
+}
+
+TEST(EpisodeArena, ArenaTimeLinesBehaveLikeHeapTimeLines)
+{
+    EpisodeArena arena;
+    Time::pmr::TimeLine pooled(Position::Index(1, 2), false, &arena);
+    Time::TimeLine heap(Position::Index(1, 2));
+
+    std::mt19937 rng(24);
+    std::uniform_int_distribution<int> slot(0, 40);
+    for (int i = 0; i < 200; ++i)
+    {
+        int begin = slot(rng), end = slot(rng);
+        if (begin > end)
+            std::swap(begin, end);
+        if (rng() % 3 != 0)
+        {
+            pooled.insertReservation(Time::TimePoint(begin), Time::TimePoint(end));
+            heap.insertReservation(Time::TimePoint(begin), Time::TimePoint(end));
+        }
+        else
+        {
+            pooled.removeReservation(Time::TimePoint(begin), Time::TimePoint(end));
+            heap.removeReservation(Time::TimePoint(begin), Time::TimePoint(end));
+        }
+
+        ASSERT_TRUE(std::equal(pooled.interval_list_.begin(), pooled.interval_list_.end(),
+                               heap.interval_list_.begin(), heap.interval_list_.end())) << i;
+    }
+    // Spilled past the inline intervals into the arena
+    EXPECT_GT(arena.bytesAllocated(), 0u);
+
+    const Time::TimeLine copied(pooled);
+    EXPECT_TRUE(std::equal(copied.interval_list_.begin(), copied.interval_list_.end(),
+                           heap.interval_list_.begin(), heap.interval_list_.end()));
+}
+
+TEST(EpisodeArena, CopiedOutTrajectoriesOutliveReset)
+{
+    std::mt19937 rng(25);
+    const Traj::SingleTraj reference = TestUtil::randomTraj("agent_with_a_long_heap_name", 50, 10.0, rng);
+
+    EpisodeArena arena;
+    Traj::SingleTraj result;
+    {
+        Traj::pmr::SingleTraj pooled(reference, &arena);
+        EXPECT_GE(arena.bytesAllocated(), reference.nodes_.size() * sizeof(Traj::Node) * 2);
+        result = Traj::SingleTraj(pooled);
+    }
+
+    // Scribble over everything the arena handed out
+    const std::size_t used = arena.bytesAllocated();
+    arena.reset();
+    while (arena.bytesAllocated() < used)
+        std::memset(arena.allocate(64, 8), 0xab, 64);
+
+    EXPECT_EQ(result.agentName_, reference.agentName_);
+    EXPECT_EQ(result.cost_, reference.cost_);
+    ASSERT_EQ(result.nodes_.size(), reference.nodes_.size());
+    for (std::size_t i = 0; i < result.nodes_.size(); ++i)
+    {
+        EXPECT_EQ(result.nodes_[i].first.pose_, reference.nodes_[i].first.pose_);
+        EXPECT_EQ(result.nodes_[i].second.arrival_time_, reference.nodes_[i].second.arrival_time_);
+    }
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "multibot_util/Agent/FleetState.hpp"
+
+using namespace Instance::AgentInstance;
+
+namespace
+{
+    std::vector<Agent> makeAgents(int _count, std::mt19937 &_rng)
+    {
+        std::uniform_real_distribution<double> coordinate(-10.0, 10.0);
+        std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+        std::uniform_real_distribution<double> limit(0.2, 2.0);
+
+        std::vector<Agent> agents(_count);
+        for (auto &agent : agents)
+        {
+            agent.pose_ = Position::Pose(coordinate(_rng), coordinate(_rng), angle(_rng));
+            agent.goal_ = Position::Pose(coordinate(_rng), coordinate(_rng), 0.0);
+            agent.linVel_ = 0.0;
+            agent.angVel_ = 0.0;
+            agent.max_linVel_ = limit(_rng);
+            agent.max_linAcc_ = limit(_rng);
+            agent.max_angVel_ = limit(_rng);
+            agent.max_angAcc_ = limit(_rng);
+        }
+
+        return agents;
+    }
+
+    // One agent at a time, the way a per-agent controller would step
+    void step(Agent &_agent, double _linCommand, double _angCommand, double _dt)
+    {
+        const auto limit = [_dt](double _velocity, double _command, double _max_velocity, double _max_acceleration)
+        {
+            const double velocity = std::clamp(_command, _velocity - _max_acceleration * _dt, _velocity + _max_acceleration * _dt);
+            return std::clamp(velocity, -_max_velocity, _max_velocity);
+        };
+        _agent.linVel_ = limit(_agent.linVel_, _linCommand, _agent.max_linVel_, _agent.max_linAcc_);
+        _agent.angVel_ = limit(_agent.angVel_, _angCommand, _agent.max_angVel_, _agent.max_angAcc_);
+
+        auto &pose = _agent.pose_.component_;
+        const double heading = pose.theta + 0.5 * _agent.angVel_ * _dt;
+        pose.x += _agent.linVel_ * _dt * std::cos(heading);
+        pose.y += _agent.linVel_ * _dt * std::sin(heading);
+        pose.theta = std::remainder(pose.theta + _agent.angVel_ * _dt, 2 * M_PI);
+    }
+} // namespace
+
+TEST(FleetState, BatchStepsMatchPerAgentSteps)
+{
+    constexpr int AGENTS = 37;
+    constexpr double DT = 0.05;
+    std::mt19937 rng(15);
+    std::vector<Agent> agents = makeAgents(AGENTS, rng);
+    FleetState fleet(agents);
+    ASSERT_EQ(fleet.size(), agents.size());
+
+    std::uniform_real_distribution<double> command(-3.0, 3.0);
+    std::vector<double> linCommands(AGENTS), angCommands(AGENTS);
+    for (int tick = 0; tick < 400; ++tick)
+    {
+        for (int i = 0; i < AGENTS; ++i)
+        {
+            linCommands[i] = command(rng);
+            angCommands[i] = command(rng);
+            step(agents[i], linCommands[i], angCommands[i], DT);
+        }
+        fleet.applyCommands(linCommands, angCommands, DT);
+        fleet.integrate(DT);
+    }
+
+    std::vector<Agent> written = agents;
+    fleet.writeBack(written);
+    std::vector<double> distances(AGENTS);
+    fleet.distanceToGoal(distances);
+    for (int i = 0; i < AGENTS; ++i)
+    {
+        EXPECT_DOUBLE_EQ(written[i].linVel_, agents[i].linVel_);
+        EXPECT_DOUBLE_EQ(written[i].angVel_, agents[i].angVel_);
+        EXPECT_NEAR(written[i].pose_.component_.x, agents[i].pose_.component_.x, 1e-9);
+        EXPECT_NEAR(written[i].pose_.component_.y, agents[i].pose_.component_.y, 1e-9);
+        EXPECT_NEAR(std::remainder(written[i].pose_.component_.theta - agents[i].pose_.component_.theta, 2 * M_PI), 0.0, 1e-9);
+        EXPECT_GE(written[i].pose_.component_.theta, -M_PI);
+        EXPECT_LE(written[i].pose_.component_.theta, M_PI);
+        EXPECT_NEAR(distances[i], Position::getDistance(written[i].pose_, written[i].goal_), 1e-12);
+    }
+}
+
+TEST(FleetState, StraightMotionIsExact)
+{
+    std::mt19937 rng(16);
+    std::vector<Agent> agents = makeAgents(1, rng);
+    agents[0].pose_ = Position::Pose(1.0, 2.0, M_PI / 2);
+    agents[0].linVel_ = 0.5;
+
+    FleetState fleet(agents);
+    for (int tick = 0; tick < 10; ++tick)
+        fleet.integrate(0.2);
+
+    EXPECT_NEAR(fleet.pose(0).component_.x, 1.0, 1e-12);
+    EXPECT_NEAR(fleet.pose(0).component_.y, 3.0, 1e-12);
+    EXPECT_DOUBLE_EQ(fleet.pose(0).component_.theta, M_PI / 2);
+}
+
+TEST(FleetState, WrapsHeadingsOfAnyMagnitude)
+{
+    std::mt19937 rng(17);
+    std::vector<Agent> agents = makeAgents(3, rng);
+    agents[0].pose_ = Position::Pose(0.0, 0.0, 7 * M_PI + 0.25);
+    agents[1].pose_ = Position::Pose(0.0, 0.0, -20.0);
+    agents[2].pose_ = Position::Pose(0.0, 0.0, 0.5);
+    agents[2].angVel_ = 30.0;
+
+    FleetState fleet(agents);
+    EXPECT_NEAR(fleet.pose(0).component_.theta, -M_PI + 0.25, 1e-12);
+    EXPECT_NEAR(fleet.pose(1).component_.theta, -20.0 + 6 * M_PI, 1e-12);
+
+    fleet.integrate(1.0);
+    EXPECT_NEAR(fleet.pose(2).component_.theta, 30.5 - 10 * M_PI, 1e-12);
+    for (std::size_t i = 0; i < fleet.size(); ++i)
+    {
+        EXPECT_GE(fleet.pose(i).component_.theta, -M_PI);
+        EXPECT_LE(fleet.pose(i).component_.theta, M_PI);
+    }
+}
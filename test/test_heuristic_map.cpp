@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <queue>
+
+#include "multibot_util/Map/HeuristicMap.hpp"
+#include "TestUtil.hpp"
+
+using namespace Instance::MapInstance;
+
+namespace
+{
+    // Plain Dijkstra over the same 8-connected moves with the given step costs
+    template <typename Cost>
+    std::vector<Cost> dijkstra(const BitGrid &_blocked, const Position::Index &_goal, Cost _straight, Cost _diagonal)
+    {
+        const int width = _blocked.width(), height = _blocked.height();
+        const Cost unreached = std::numeric_limits<Cost>::max();
+        std::vector<Cost> cost(static_cast<std::size_t>(width) * height, unreached);
+        std::priority_queue<std::pair<Cost, int>, std::vector<std::pair<Cost, int>>, std::greater<>> open;
+        cost[_goal.y_ * width + _goal.x_] = 0;
+        open.emplace(0, _goal.y_ * width + _goal.x_);
+
+        const auto free = [&](int _x, int _y)
+        { return _x >= 0 and _y >= 0 and _x < width and _y < height and not _blocked.get(_x, _y); };
+        while (not open.empty())
+        {
+            const auto [current, cell] = open.top();
+            open.pop();
+            if (current != cost[cell])
+                continue;
+
+            const int x = cell % width, y = cell / width;
+            for (int dy = -1; dy <= 1; ++dy)
+            {
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    if ((dx == 0 and dy == 0) or not free(x + dx, y + dy))
+                        continue;
+                    // No cutting blocked corners
+                    if (dx != 0 and dy != 0 and not(free(x + dx, y) and free(x, y + dy)))
+                        continue;
+
+                    const Cost next = current + (dx != 0 and dy != 0 ? _diagonal : _straight);
+                    const int neighbor = (y + dy) * width + x + dx;
+                    if (next < cost[neighbor])
+                    {
+                        cost[neighbor] = next;
+                        open.emplace(next, neighbor);
+                    }
+                }
+            }
+        }
+
+        return cost;
+    }
+} // namespace
+
+TEST(HeuristicMap, NeverOverestimatesTheGridDistance)
+{
+    std::mt19937 rng(17);
+    auto map = TestUtil::makeMap(90, 70, 0.05);
+    TestUtil::scatterObstacles(map, 0.01, rng);
+    const BitGrid &blocked = map.inflate(0.1);
+
+    for (int trial = 0; trial < 5; ++trial)
+    {
+        Position::Index goal = TestUtil::randomIndex(map, rng);
+        while (blocked.get(goal.x_, goal.y_))
+            goal = TestUtil::randomIndex(map, rng);
+
+        const auto heuristic = HeuristicMap::compute(blocked, map.property_, goal);
+        const auto steps = dijkstra<std::uint32_t>(blocked, goal, 29, 41);
+        const auto meters = dijkstra<double>(blocked, goal, 0.05, 0.05 * M_SQRT2);
+        EXPECT_EQ(heuristic->distance(goal), 0.0);
+
+        for (int y = 0; y < 70; ++y)
+        {
+            for (int x = 0; x < 90; ++x)
+            {
+                const std::size_t cell = static_cast<std::size_t>(y) * 90 + x;
+                const double distance = heuristic->distance(Position::Index(x, y));
+                if (meters[cell] == std::numeric_limits<double>::max())
+                {
+                    ASSERT_FALSE(heuristic->isReachable(Position::Index(x, y))) << x << ", " << y;
+                    continue;
+                }
+
+                ASSERT_NEAR(distance, steps[cell] * heuristic->quantum(), 1e-9) << x << ", " << y;
+                ASSERT_LE(distance, meters[cell] + 1e-9) << x << ", " << y;
+                ASSERT_GE(distance, meters[cell] * 41.0 / (29.0 * M_SQRT2) - 1e-9) << x << ", " << y;
+            }
+        }
+    }
+
+    EXPECT_FALSE(HeuristicMap::compute(blocked, map.property_, Position::Index(-1, 0))->isReachable(Position::Index(0, 0)));
+    EXPECT_EQ(HeuristicMap::compute(blocked, map.property_, Position::Index(0, 0))->distance(Position::Index(90, 0)),
+              std::numeric_limits<double>::infinity());
+}
+
+TEST(HeuristicMap, CoarsensLongPathsInsteadOfOverflowing)
+{
+    auto map = TestUtil::makeMap(3000, 1, 0.1);
+    const BitGrid &blocked = map.inflate(0.0);
+    const auto heuristic = HeuristicMap::compute(blocked, map.property_, Position::Index(0, 0));
+
+    EXPECT_GT(heuristic->quantum(), 0.1 / 29);
+    double previous = 0.0;
+    for (int x = 1; x < 3000; ++x)
+    {
+        const double distance = heuristic->distance(Position::Index(x, 0));
+        ASSERT_TRUE(heuristic->isReachable(Position::Index(x, 0))) << x;
+        ASSERT_LE(distance, x * 0.1 + 1e-9) << x;
+        ASSERT_GE(distance, x * 0.1 - heuristic->quantum()) << x;
+        ASSERT_GE(distance, previous) << x;
+        previous = distance;
+    }
+}
+
+TEST(HeuristicCache, SharesMapsAndEvictsLeastRecentlyUsed)
+{
+    std::mt19937 rng(18);
+    auto map = TestUtil::makeMap(60, 60, 0.1);
+    TestUtil::scatterObstacles(map, 0.02, rng);
+    map.computeDistanceField();
+
+    HeuristicCache cache(map);
+    const auto first = cache.get(Position::Index(5, 5), 0.2);
+    EXPECT_EQ(cache.get(Position::Index(5, 5), 0.2), first);
+    // Radii that inflate to the same cells share a map
+    EXPECT_EQ(cache.get(Position::Index(5, 5), 0.2 + 1e-6), first);
+    EXPECT_NE(cache.get(Position::Index(5, 5), 0.5), first);
+
+    const auto expected = HeuristicMap::compute(map.inflate(0.2), map.property_, Position::Index(5, 5));
+    EXPECT_TRUE(std::equal(first->data(), first->data() + 3600, expected->data()));
+
+    // Batched misses, including a repeated goal, are computed once each
+    cache.clear();
+    const auto batch = cache.get(std::vector<Position::Index>{{1, 1}, {2, 2}, {1, 1}, {3, 3}}, 0.2);
+    EXPECT_EQ(batch[0], batch[2]);
+    EXPECT_EQ(cache.size(), 3u);
+
+    cache.setCapacity(2 * first->memoryUsage());
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_LE(cache.memoryUsage(), 2 * first->memoryUsage());
+    EXPECT_NE(cache.get(Position::Index(1, 1), 0.2), batch[0]);
+    EXPECT_EQ(cache.get(Position::Index(3, 3), 0.2), batch[3]);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include "multibot_util/Map/MapSnapshot.hpp"
+#include "TestUtil.hpp"
+
+using namespace Instance::MapInstance;
+
+// Every incrementally maintained layer must equal a from-scratch rebuild of
+// the same occupancy, however many edits it has absorbed
+TEST(IncrementalConsistency, LayersMatchAFreshRecomputeAfterRandomEdits)
+{
+    constexpr double RADIUS = 0.2;
+    constexpr double VIEW_RADIUS = 0.35;
+    std::mt19937 rng(31);
+
+    auto map = TestUtil::makeMap(130, 70, 0.05);
+    TestUtil::scatterObstacles(map, 0.01, rng);
+    map.inflate(RADIUS);
+    const InflatedView &view = map.inflatedView(VIEW_RADIUS);
+    map.clearanceField();
+    VersionedMap versioned(map, 64);
+
+    for (int edit = 1; edit <= 1000; ++edit)
+    {
+        // Clustered edits, so obstacles appear and vanish next to each other
+        Position::Index idx = TestUtil::randomIndex(map, rng);
+        if (edit % 3 != 0)
+            idx = Position::Index(20 + rng() % 12, 30 + rng() % 12);
+        const bool occupied = not map.isOccupied(idx);
+        if (occupied)
+            map.markOccupied(idx);
+        else
+            map.markFree(idx);
+        versioned.update({{idx, occupied}});
+
+        if (edit % 100 != 0)
+            continue;
+
+        BinaryOccupancyMap fresh = TestUtil::makeMap(130, 70, 0.05);
+        fresh.mapData_ = map.mapData_;
+        fresh.computeDistanceField();
+        const BitGrid freshView = fresh.inflate(VIEW_RADIUS);
+        const BitGrid &freshInflated = fresh.inflate(RADIUS);
+        const ClearanceField &freshClearance = fresh.clearanceField();
+        const ClearanceField &clearance = map.clearanceField();
+        const auto snapshot = versioned.snapshot();
+
+        ASSERT_EQ(map.inflated_mapData_, freshInflated) << "after edit " << edit;
+        for (int y = 0; y < 70; ++y)
+        {
+            for (int x = 0; x < 130; ++x)
+            {
+                const Position::Index cell(x, y);
+                ASSERT_EQ(map.distance_field_.squaredDistance(x, y), fresh.distance_field_.squaredDistance(x, y))
+                    << cell << " after edit " << edit;
+                ASSERT_EQ(view.isInflated(cell), freshView.get(x, y)) << cell << " after edit " << edit;
+                ASSERT_EQ(clearance.cellClearance(x, y), freshClearance.cellClearance(x, y)) << cell << " after edit " << edit;
+                ASSERT_EQ(snapshot->isOccupied(cell), map.isOccupied(cell)) << cell << " after edit " << edit;
+                ASSERT_EQ(snapshot->isInflated(cell), freshInflated.get(x, y)) << cell << " after edit " << edit;
+            }
+        }
+    }
+}
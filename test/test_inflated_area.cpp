@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <set>
+#include <thread>
+
+#include "TestUtil.hpp"
+
+using namespace Instance::MapInstance;
+
+namespace
+{
+    std::vector<std::vector<Position::Index>> randomRootAreas(const BinaryOccupancyMap &_map, std::size_t _count, std::mt19937 &_rng)
+    {
+        std::vector<std::vector<Position::Index>> rootAreas(_count);
+        for (auto &rootArea : rootAreas)
+        {
+            const std::size_t cells = 1 + _rng() % 4;
+            for (std::size_t i = 0; i < cells; ++i)
+                rootArea.push_back(TestUtil::randomIndex(_map, _rng));
+        }
+
+        return rootAreas;
+    }
+} // namespace
+
+TEST(InflatedArea, StaysWithinTheRadiusOfTheRoots)
+{
+    std::mt19937 rng(22);
+    const auto map = TestUtil::makeMap(80, 60, 0.05);
+    const double radius = 0.2;
+    const double margin = radius + std::sqrt(2) * 0.05 + 1e-8;
+
+    for (const auto &rootArea : randomRootAreas(map, 100, rng))
+    {
+        const auto area = map.getInflatedArea(rootArea, radius);
+        std::set<std::pair<int, int>> cells;
+        for (const auto &idx : area)
+        {
+            ASSERT_FALSE(map.isOutofMap(idx));
+            ASSERT_TRUE(cells.emplace(idx.x_, idx.y_).second) << "duplicate " << idx;
+            double nearest = std::numeric_limits<double>::infinity();
+            for (const auto &root : rootArea)
+                nearest = std::min(nearest, 0.05 * std::hypot(idx.x_ - root.x_, idx.y_ - root.y_));
+            ASSERT_LE(nearest, margin) << idx;
+        }
+        for (const auto &root : rootArea)
+            EXPECT_TRUE(cells.count({root.x_, root.y_})) << root;
+    }
+
+    // Out-of-map roots are skipped
+    EXPECT_TRUE(map.getInflatedArea({Position::Index(-5, 3), Position::Index(80, 0)}, radius).empty());
+}
+
+TEST(InflatedArea, BatchMatchesSerialQueries)
+{
+    std::mt19937 rng(23);
+    const auto map = TestUtil::makeMap(120, 120, 0.05);
+    const auto rootAreas = randomRootAreas(map, 300, rng);
+
+    const auto batch = map.getInflatedAreas(rootAreas, 0.25);
+    ASSERT_EQ(batch.size(), rootAreas.size());
+
+    InflationWorkspace workspace;
+    std::pmr::monotonic_buffer_resource resource;
+    for (std::size_t i = 0; i < rootAreas.size(); ++i)
+    {
+        const auto serial = map.getInflatedArea(rootAreas[i], 0.25, workspace);
+        EXPECT_EQ(batch[i], serial) << i;
+        const auto pooled = map.getInflatedArea(rootAreas[i], 0.25, workspace, &resource);
+        EXPECT_TRUE(std::equal(pooled.begin(), pooled.end(), serial.begin(), serial.end())) << i;
+    }
+}
+
+TEST(InflatedArea, WorkspacesSurviveEpochWrapAndOtherMaps)
+{
+    std::mt19937 rng(24);
+    const auto small = TestUtil::makeMap(20, 20, 0.1);
+    const auto large = TestUtil::makeMap(200, 150, 0.05);
+    const std::vector<Position::Index> root{Position::Index(10, 10)};
+    const auto expected = small.getInflatedArea(root, 0.3);
+
+    // Enough queries to wrap the 16-bit epoch, interleaved with another map
+    InflationWorkspace workspace;
+    for (int i = 0; i < 70000; ++i)
+    {
+        if (i % 10000 == 0)
+            large.getInflatedArea({TestUtil::randomIndex(large, rng)}, 0.5, workspace);
+        ASSERT_EQ(small.getInflatedArea(root, 0.3, workspace), expected) << i;
+    }
+}
+
+TEST(InflatedArea, ConcurrentQueriesShareOneMap)
+{
+    std::mt19937 rng(25);
+    const auto map = TestUtil::makeMap(100, 100, 0.05);
+    const auto rootAreas = randomRootAreas(map, 200, rng);
+    std::vector<std::vector<Position::Index>> expected;
+    for (const auto &rootArea : rootAreas)
+        expected.push_back(map.getInflatedArea(rootArea, 0.2));
+
+    std::vector<std::thread> threads;
+    std::atomic<int> mismatches{0};
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&]()
+                             {
+                                 for (std::size_t i = 0; i < rootAreas.size(); ++i)
+                                     if (map.getInflatedArea(rootAreas[i], 0.2) != expected[i])
+                                         mismatches.fetch_add(1);
+                             });
+    for (auto &thread : threads)
+        thread.join();
+
+    EXPECT_EQ(mismatches.load(), 0);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <queue>
+
+#include "../benchmark/MapGenerator.hpp"
+
+using namespace Instance::MapInstance;
+
+namespace
+{
+    // Free cells 4-connected to the first free cell
+    std::size_t reachableCells(const BitGrid &_grid)
+    {
+        std::vector<bool> seen(static_cast<std::size_t>(_grid.width()) * _grid.height(), false);
+        std::queue<std::pair<int, int>> open;
+        for (int i = 0; i < _grid.width() * _grid.height() and open.empty(); ++i)
+        {
+            if (not _grid.get(i % _grid.width(), i / _grid.width()))
+            {
+                seen[i] = true;
+                open.emplace(i % _grid.width(), i / _grid.width());
+            }
+        }
+
+        std::size_t count = 0;
+        while (not open.empty())
+        {
+            const auto [x, y] = open.front();
+            open.pop();
+            ++count;
+            for (const auto &[dx, dy] : {std::pair{1, 0}, {-1, 0}, {0, 1}, {0, -1}})
+            {
+                const int nx = x + dx, ny = y + dy;
+                if (nx < 0 or ny < 0 or nx >= _grid.width() or ny >= _grid.height() or _grid.get(nx, ny) or seen[ny * _grid.width() + nx])
+                    continue;
+                seen[ny * _grid.width() + nx] = true;
+                open.emplace(nx, ny);
+            }
+        }
+
+        return count;
+    }
+
+    std::size_t freeCells(const BitGrid &_grid)
+    {
+        return static_cast<std::size_t>(_grid.width()) * _grid.height() - _grid.count();
+    }
+} // namespace
+
+TEST(MapGenerator, LayoutsAreDeterministicAndConnected)
+{
+    for (const auto layout : {Benchmark::MapGenerator::RANDOM, Benchmark::MapGenerator::MAZE, Benchmark::MapGenerator::WAREHOUSE})
+    {
+        BinaryOccupancyMap map, again;
+        Benchmark::MapGenerator::generate(map, layout, 300, 0.05, 7);
+        Benchmark::MapGenerator::generate(again, layout, 300, 0.05, 7);
+        EXPECT_EQ(map.mapData_, again.mapData_) << Benchmark::MapGenerator::layoutName(layout);
+        EXPECT_TRUE(map.hasDistanceField());
+
+        const std::size_t free = freeCells(map.mapData_);
+        ASSERT_GT(free, 0u);
+        if (layout == Benchmark::MapGenerator::RANDOM)
+        {
+            EXPECT_NEAR(static_cast<double>(map.mapData_.count()) / (300 * 300), 0.05, 0.01);
+            continue;
+        }
+        // Mazes and warehouses have no sealed-off free space
+        EXPECT_EQ(reachableCells(map.mapData_), free) << Benchmark::MapGenerator::layoutName(layout);
+    }
+}
+
+TEST(MapGenerator, WarehousesAreWalledIn)
+{
+    BinaryOccupancyMap map;
+    Benchmark::MapGenerator::generate(map, Benchmark::MapGenerator::WAREHOUSE, 200);
+    for (int i = 0; i < 200; ++i)
+    {
+        ASSERT_TRUE(map.mapData_.get(i, 0));
+        ASSERT_TRUE(map.mapData_.get(i, 199));
+        ASSERT_TRUE(map.mapData_.get(0, i));
+        ASSERT_TRUE(map.mapData_.get(199, i));
+    }
+}
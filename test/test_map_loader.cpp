@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "multibot_util/Map/MapLoader.hpp"
+
+using namespace Instance::MapInstance;
+
+namespace
+{
+    class MapLoaderTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            directory_ = std::filesystem::temp_directory_path() /
+                         ("multibot_util_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+            std::filesystem::create_directories(directory_);
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(directory_);
+        }
+
+        std::string write(const std::string &_name, const std::string &_contents) const
+        {
+            const std::string path = (directory_ / _name).string();
+            std::ofstream(path, std::ios::binary) << _contents;
+            return path;
+        }
+
+        std::string writeYaml(const std::string &_image, const std::string &_resolution = "0.5",
+                              const std::string &_origin = "[-1.0, 2.0, 0.0]") const
+        {
+            return write("map.yaml", "image: " + _image + "\nresolution: " + _resolution + "\norigin: " + _origin +
+                                         "\nnegate: 0\noccupied_thresh: 0.65\nfree_thresh: 0.196\n");
+        }
+
+        // Top row: occupied, free, unknown; bottom row: free, occupied, free
+        std::string writeBinaryImage() const
+        {
+            const std::string pixels{char(0), char(254), char(205), char(254), char(0), char(254)};
+            return write("map.pgm", "P5\n# comment\n3 2\n255\n" + pixels);
+        }
+
+        std::filesystem::path directory_;
+    }; // class MapLoaderTest
+
+    void expectTestImage(const BinaryOccupancyMap &_map, bool _unknown_as_occupied)
+    {
+        ASSERT_EQ(_map.property_.width_, 3);
+        ASSERT_EQ(_map.property_.height_, 2);
+        EXPECT_TRUE(_map.isOccupied(Position::Index(0, 1)));
+        EXPECT_FALSE(_map.isOccupied(Position::Index(1, 1)));
+        EXPECT_EQ(_map.isOccupied(Position::Index(2, 1)), _unknown_as_occupied);
+        EXPECT_FALSE(_map.isOccupied(Position::Index(0, 0)));
+        EXPECT_TRUE(_map.isOccupied(Position::Index(1, 0)));
+        EXPECT_FALSE(_map.isOccupied(Position::Index(2, 0)));
+    }
+} // namespace
+
+TEST_F(MapLoaderTest, LoadsBinaryPgmBottomRowFirst)
+{
+    writeBinaryImage();
+    BinaryOccupancyMap map;
+    ASSERT_TRUE(MapLoader::loadYaml(writeYaml("map.pgm"), map));
+
+    expectTestImage(map, true);
+    // Cell coordinates are cell centers
+    EXPECT_DOUBLE_EQ(map.property_.resolution_, 0.5);
+    EXPECT_DOUBLE_EQ(map.property_.origin_.x_, -0.75);
+    EXPECT_DOUBLE_EQ(map.property_.origin_.y_, 2.25);
+}
+
+TEST_F(MapLoaderTest, LoadsAsciiPgm)
+{
+    write("map.pgm", "P2\n3 2\n255\n0 254 205\n254 0 254\n");
+    BinaryOccupancyMap map;
+    ASSERT_TRUE(MapLoader::loadYaml(writeYaml("map.pgm"), map, false));
+
+    expectTestImage(map, false);
+}
+
+TEST_F(MapLoaderTest, RejectsMalformedNumbers)
+{
+    writeBinaryImage();
+    MapLoader::MapMetaData metaData;
+    EXPECT_FALSE(MapLoader::parseYaml(writeYaml("map.pgm", "0.5x"), metaData));
+    EXPECT_FALSE(MapLoader::parseYaml(writeYaml("map.pgm", "0.5", "[1.0]"), metaData));
+    EXPECT_TRUE(MapLoader::parseYaml(writeYaml("map.pgm", "0.5", "[1.0, 2.0]"), metaData));
+
+    write("bad.pgm", "P2\n3 x\n255\n0 0 0\n0 0 0\n");
+    BinaryOccupancyMap map;
+    EXPECT_FALSE(MapLoader::loadYaml(writeYaml("bad.pgm"), map));
+}
+
+TEST_F(MapLoaderTest, RejectsPixelsAboveMaxValue)
+{
+    write("map.pgm", "P2\n3 2\n255\n0 254 300\n254 0 254\n");
+    BinaryOccupancyMap map;
+    EXPECT_FALSE(MapLoader::loadYaml(writeYaml("map.pgm"), map));
+
+    write("map.pgm", "P2\n3 2\n255\n0 254 -1\n254 0 254\n");
+    EXPECT_FALSE(MapLoader::loadYaml(writeYaml("map.pgm"), map));
+}
+
+TEST_F(MapLoaderTest, CacheRoundTripsOccupancyAndDistanceField)
+{
+    writeBinaryImage();
+    const std::string yaml = writeYaml("map.pgm");
+    const std::string cache = (directory_ / "map.cache").string();
+
+    BinaryOccupancyMap parsed;
+    ASSERT_TRUE(MapLoader::load(yaml, cache, parsed));
+    ASSERT_TRUE(std::filesystem::exists(cache));
+
+    BinaryOccupancyMap cached;
+    ASSERT_TRUE(MapLoader::readCache(cache, cached, MapLoader::sourceStamp(yaml)));
+    EXPECT_EQ(cached.mapData_, parsed.mapData_);
+    ASSERT_TRUE(cached.hasDistanceField());
+    for (int y = 0; y < 2; ++y)
+        for (int x = 0; x < 3; ++x)
+            EXPECT_EQ(cached.distance_field_.squaredDistance(x, y), parsed.distance_field_.squaredDistance(x, y));
+
+    // A different source invalidates the cache
+    writeYaml("map.pgm", "0.25");
+    EXPECT_FALSE(MapLoader::readCache(cache, cached, MapLoader::sourceStamp(yaml)));
+}
+
+TEST_F(MapLoaderTest, RejectedCacheLeavesTheMapUntouched)
+{
+    writeBinaryImage();
+    const std::string yaml = writeYaml("map.pgm");
+    const std::string cache = (directory_ / "map.cache").string();
+    BinaryOccupancyMap parsed;
+    ASSERT_TRUE(MapLoader::load(yaml, cache, parsed));
+
+    std::string bytes;
+    {
+        std::ifstream file(cache, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    // Byte offsets of the cache header fields: width_, resolution_, words_per_row_, occupancy_offset_
+    int count = 0;
+    const auto corrupt = [&](std::size_t _offset, auto _value)
+    {
+        std::string patched = bytes;
+        std::memcpy(patched.data() + _offset, &_value, sizeof(_value));
+        return write("corrupt" + std::to_string(count++) + ".cache", patched);
+    };
+    const std::string corruptCaches[] = {corrupt(24, std::int32_t(1 << 20)), corrupt(32, 0.0), corrupt(32, -0.5),
+                                         corrupt(56, std::uint64_t(2)), corrupt(64, std::uint64_t(bytes.size())),
+                                         corrupt(64, std::uint64_t(1))};
+
+    BinaryOccupancyMap::MapProperty property;
+    property.width_ = 70;
+    property.height_ = 5;
+    property.resolution_ = 0.1;
+    for (const auto &path : corruptCaches)
+    {
+        BinaryOccupancyMap map;
+        map.initialize(property);
+        map.setOccupied(Position::Index(65, 4), true);
+        const BitGrid before = map.mapData_;
+
+        EXPECT_FALSE(MapLoader::readCache(path, map, MapLoader::sourceStamp(yaml)));
+        EXPECT_EQ(map.property_.width_, 70);
+        EXPECT_EQ(map.property_.resolution_, 0.1);
+        EXPECT_EQ(map.mapData_, before);
+    }
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "multibot_util/Map/MapSnapshot.hpp"
+#include "TestUtil.hpp"
+
+using namespace Instance::MapInstance;
+
+namespace
+{
+    constexpr double RADIUS = 0.15;
+
+    // A fresh map with the same occupancy, inflated from scratch
+    void expectMatchesRecompute(const MapSnapshot &_snapshot, const BitGrid &_occupancy)
+    {
+        auto fresh = TestUtil::makeMap(_occupancy.width(), _occupancy.height(), _snapshot.property().resolution_);
+        fresh.mapData_ = _occupancy;
+        fresh.computeDistanceField();
+        const BitGrid &inflated = fresh.inflate(RADIUS);
+
+        for (int y = 0; y < _occupancy.height(); ++y)
+        {
+            for (int x = 0; x < _occupancy.width(); ++x)
+            {
+                ASSERT_EQ(_snapshot.isOccupied(Position::Index(x, y)), _occupancy.get(x, y)) << x << ", " << y;
+                ASSERT_EQ(_snapshot.isInflated(Position::Index(x, y)), inflated.get(x, y)) << x << ", " << y;
+            }
+        }
+    }
+} // namespace
+
+TEST(VersionedMap, SnapshotsAreImmutableAndShareUntouchedTiles)
+{
+    std::mt19937 rng(23);
+    auto map = TestUtil::makeMap(200, 130, 0.05);
+    TestUtil::scatterObstacles(map, 0.005, rng);
+    map.inflate(RADIUS);
+    BitGrid occupancy = map.mapData_;
+
+    VersionedMap versioned(map, 64);
+    const auto initial = versioned.snapshot();
+    EXPECT_EQ(initial->tilesX(), 4);
+    EXPECT_EQ(initial->tilesY(), 3);
+    expectMatchesRecompute(*initial, occupancy);
+
+    const auto updated = versioned.update({{Position::Index(10, 10), true}, {Position::Index(150, 100), true}});
+    occupancy.set(10, 10, true);
+    occupancy.set(150, 100, true);
+    EXPECT_EQ(updated->version(), initial->version() + 1);
+    expectMatchesRecompute(*updated, occupancy);
+
+    // The old version still shows the old map
+    EXPECT_FALSE(initial->isOccupied(Position::Index(10, 10)));
+    EXPECT_TRUE(updated->isOccupied(Position::Index(10, 10)));
+    EXPECT_NE(updated->tile(0, 0), initial->tile(0, 0));
+    EXPECT_NE(updated->tile(2, 1), initial->tile(2, 1));
+    EXPECT_EQ(updated->tile(3, 0), initial->tile(3, 0));
+    EXPECT_EQ(updated->tile(1, 2), initial->tile(1, 2));
+
+    // No-op changes and out-of-map cells still publish a version, copying nothing
+    const auto unchanged = versioned.update({{Position::Index(10, 10), true}, {Position::Index(-1, 0), true}});
+    for (int tileY = 0; tileY < unchanged->tilesY(); ++tileY)
+        for (int tileX = 0; tileX < unchanged->tilesX(); ++tileX)
+            EXPECT_EQ(unchanged->tile(tileX, tileY), updated->tile(tileX, tileY));
+}
+
+TEST(VersionedMap, RandomUpdatesMatchARecompute)
+{
+    std::mt19937 rng(24);
+    auto map = TestUtil::makeMap(150, 100, 0.05);
+    TestUtil::scatterObstacles(map, 0.01, rng);
+    map.inflate(RADIUS);
+    BitGrid occupancy = map.mapData_;
+    VersionedMap versioned(map, 64);
+
+    for (int round = 0; round < 20; ++round)
+    {
+        std::vector<std::pair<Position::Index, bool>> changes;
+        for (int i = 0; i < 10; ++i)
+        {
+            const Position::Index idx = TestUtil::randomIndex(map, rng);
+            const bool occupied = rng() % 2 == 0;
+            changes.emplace_back(idx, occupied);
+            occupancy.set(idx.x_, idx.y_, occupied);
+        }
+        versioned.update(changes);
+    }
+    expectMatchesRecompute(*versioned.snapshot(), occupancy);
+}
+
+TEST(VersionedMap, ReadersSeeWholeVersions)
+{
+    auto map = TestUtil::makeMap(128, 128, 0.05);
+    map.inflate(RADIUS);
+    VersionedMap versioned(map, 64);
+
+    // Version v has exactly the cells (0..v-1, 127) occupied
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+    std::thread readerThread([&]()
+                       {
+                           VersionedMap::Reader reader(versioned);
+                           while (not done.load())
+                           {
+                               const MapSnapshot &snapshot = reader.current();
+                               const int version = static_cast<int>(snapshot.version());
+                               if (snapshot.isOccupied(Position::Index(version % 128, 127)) or
+                                   (version > 0 and not snapshot.isOccupied(Position::Index((version - 1) % 128, 127))))
+                                   inconsistent.fetch_add(1);
+                           }
+                       });
+
+    for (int x = 0; x < 100; ++x)
+    {
+        versioned.update({{Position::Index(x, 127), true}});
+        std::this_thread::yield();
+    }
+    done.store(true);
+    readerThread.join();
+
+    EXPECT_EQ(inconsistent.load(), 0);
+    VersionedMap::Reader reader(versioned);
+    EXPECT_EQ(reader.current().version(), 100u);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "multibot_util/Agent/MotionTiming.hpp"
+
+using namespace Instance::AgentInstance;
+
+namespace
+{
+    std::vector<Position::Pose> randomPoses(std::size_t _count, std::mt19937 &_rng)
+    {
+        std::uniform_real_distribution<double> coordinate(-5.0, 5.0);
+        std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+        std::vector<Position::Pose> poses;
+        for (std::size_t i = 0; i < _count; ++i)
+            poses.emplace_back(coordinate(_rng), coordinate(_rng), angle(_rng));
+
+        return poses;
+    }
+} // namespace
+
+TEST(MotionProfile, FollowsTrapezoidalAndTriangularProfiles)
+{
+    const MotionProfile profile(1.0, 2.0, 0.5, 1.0);
+
+    // 0.25 m ramping up, 1.5 m cruising, 0.25 m ramping down
+    EXPECT_DOUBLE_EQ(profile.translationTime(2.0), 2.5);
+    EXPECT_DOUBLE_EQ(profile.translationTime(0.2), 2.0 * std::sqrt(0.1));
+    // Both branches meet where the velocity limit is just reached
+    EXPECT_DOUBLE_EQ(profile.translationTime(0.5), 1.0);
+    EXPECT_DOUBLE_EQ(profile.rotationTime(M_PI), M_PI / 0.5 + 0.5);
+
+    // Already facing the target: no turn before departing
+    const auto [turn, drive] = profile.moveTime(Position::Pose(0.0, 0.0, 0.0), Position::Pose(2.0, 0.0, M_PI / 2));
+    EXPECT_DOUBLE_EQ(turn, 0.0);
+    EXPECT_DOUBLE_EQ(drive, 2.5 + profile.rotationTime(M_PI / 2));
+}
+
+TEST(MotionProfile, GridStepsMatchEdgeTimes)
+{
+    MotionProfile profile(0.8, 0.5, 1.2, 2.0);
+    profile.precomputeGrid(0.1);
+
+    for (int turn = 0; turn < 8; ++turn)
+    {
+        const double heading = turn * M_PI_4;
+        const double length = turn % 2 ? 0.1 * M_SQRT2 : 0.1;
+        const Position::Pose to(length * std::cos(heading), length * std::sin(heading), heading);
+        EXPECT_NEAR(profile.gridStepTime(turn, turn % 2), profile.edgeTime(Position::Pose(0.0, 0.0, 0.0), to), 1e-12) << turn;
+    }
+}
+
+TEST(MotionTiming, BatchEdgeTimesMatchScalar)
+{
+    std::mt19937 rng(16);
+    const MotionProfile profile(0.7, 0.4, 1.0, 1.5);
+    const std::vector<Position::Pose> from = randomPoses(257, rng);
+    const std::vector<Position::Pose> to = randomPoses(257, rng);
+
+    std::vector<double> times(to.size());
+    MotionTiming::edgeTimes(profile, from, to, times);
+    for (std::size_t i = 0; i < to.size(); ++i)
+        EXPECT_DOUBLE_EQ(times[i], profile.edgeTime(from[i], to[i])) << i;
+
+    MotionTiming::edgeTimes(profile, from.front(), to, times);
+    for (std::size_t i = 0; i < to.size(); ++i)
+        EXPECT_DOUBLE_EQ(times[i], profile.edgeTime(from.front(), to[i])) << i;
+}
+
+TEST(MotionTiming, TimesPoseSequencesBackToBack)
+{
+    std::mt19937 rng(17);
+    const MotionProfile profile(0.7, 0.4, 1.0, 1.5);
+    std::vector<Position::Pose> poses = randomPoses(20, rng);
+    // A pure turn in place
+    poses.insert(poses.begin() + 5, Position::Pose(poses[4].component_.x, poses[4].component_.y, poses[4].component_.theta + 1.0));
+
+    const Traj::SingleTraj traj = MotionTiming::timeTrajectory("a", poses, profile, Time::TimePoint(3.0));
+    ASSERT_EQ(traj.nodes_.size(), poses.size() - 1);
+
+    double time = 3.0;
+    for (std::size_t i = 0; i < traj.nodes_.size(); ++i)
+    {
+        const auto &[from, to] = traj.nodes_[i];
+        const auto [turn, drive] = profile.moveTime(poses[i], poses[i + 1]);
+        EXPECT_EQ(from.pose_, poses[i]);
+        EXPECT_EQ(to.pose_, poses[i + 1]);
+        EXPECT_NEAR(from.arrival_time_.count(), time, 1e-9);
+        EXPECT_NEAR((from.departure_time_ - from.arrival_time_).count(), turn, 1e-9);
+        EXPECT_NEAR((to.arrival_time_ - from.departure_time_).count(), drive, 1e-9);
+        time = to.arrival_time_.count();
+    }
+    EXPECT_NEAR(traj.cost_, time - 3.0, 1e-9);
+
+    EXPECT_TRUE(MotionTiming::timeTrajectory("a", {poses.front()}, profile).nodes_.empty());
+}
+
+TEST(ProfileTable, SharesOneProfilePerType)
+{
+    std::vector<Agent> agents(3);
+    for (std::size_t i = 0; i < agents.size(); ++i)
+    {
+        agents[i].name_ = "agent" + std::to_string(i);
+        agents[i].type_ = i == 1 ? "fast" : "slow";
+        agents[i].max_linVel_ = i == 1 ? 2.0 : 0.5;
+        agents[i].max_linAcc_ = agents[i].max_angVel_ = agents[i].max_angAcc_ = 1.0;
+    }
+
+    const ProfileTable table(agents);
+    EXPECT_EQ(table.size(), 2u);
+    EXPECT_EQ(table.profileId("slow"), 0u);
+    EXPECT_EQ(table.profileId("fast"), 1u);
+    EXPECT_DOUBLE_EQ(table.profile("fast").maxLinVel(), 2.0);
+}
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+
+#include "TestUtil.hpp"
+
+using namespace Instance::MapInstance;
+
+TEST(BitGrid, SetsAndClearsSingleBits)
+{
+    BitGrid grid(130, 3);
+    grid.set(0, 0, true);
+    grid.set(63, 1, true);
+    grid.set(64, 1, true);
+    grid.set(129, 2, true);
+
+    EXPECT_TRUE(grid.get(0, 0));
+    EXPECT_TRUE(grid.get(63, 1));
+    EXPECT_TRUE(grid.get(64, 1));
+    EXPECT_TRUE(grid.get(129, 2));
+    EXPECT_FALSE(grid.get(1, 0));
+    EXPECT_EQ(grid.count(), 4u);
+
+    grid.set(63, 1, false);
+    EXPECT_FALSE(grid.get(63, 1));
+    EXPECT_EQ(grid.count(), 3u);
+}
+
+TEST(BitGrid, KeepsPaddingCleared)
+{
+    BitGrid grid(70, 5, true);
+    EXPECT_EQ(grid.wordsPerRow(), 2u);
+    EXPECT_EQ(grid.count(), 70u * 5u);
+
+    std::size_t visited = 0;
+    grid.forEachSet([&](int _x, int _y)
+                    {
+                        EXPECT_LT(_x, 70);
+                        EXPECT_LT(_y, 5);
+                        ++visited;
+                    });
+    EXPECT_EQ(visited, 70u * 5u);
+}
+
+TEST(BinaryOccupancyMap, StoresOccupancyPerCell)
+{
+    auto map = TestUtil::makeMap(100, 40);
+    map.setOccupied(Position::Index(3, 7), true);
+    map.markOccupied(Position::Index(99, 39));
+
+    EXPECT_TRUE(map.isOccupied(Position::Index(3, 7)));
+    EXPECT_TRUE(map.cell(Position::Index(99, 39)).occupied_);
+    EXPECT_FALSE(map.isOccupied(Position::Index(4, 7)));
+    EXPECT_EQ(map.mapData_.count(), 2u);
+
+    map.markFree(Position::Index(3, 7));
+    EXPECT_FALSE(map.isOccupied(Position::Index(3, 7)));
+}
+
+TEST(BinaryOccupancyMap, ConvertsBetweenIndexAndCoordinates)
+{
+    const auto map = TestUtil::makeMap(50, 50, 0.05, Position::Coordinates(-1.0, 2.0));
+    for (const auto &idx : {Position::Index(0, 0), Position::Index(49, 0), Position::Index(17, 33)})
+        EXPECT_EQ(map.getIndex(map.getCoordinates(idx)), idx);
+
+    EXPECT_TRUE(map.isOutofMap(Position::Index(50, 0)));
+    EXPECT_TRUE(map.isOutofMap(Position::Index(0, -1)));
+    EXPECT_FALSE(map.isOutofMap(Position::Index(49, 49)));
+}
+
+TEST(BinaryOccupancyMap, CopiesAreIndependent)
+{
+    auto map = TestUtil::makeMap(20, 20);
+    map.setOccupied(Position::Index(5, 5), true);
+
+    BinaryOccupancyMap copy(map);
+    copy.setOccupied(Position::Index(6, 6), true);
+
+    EXPECT_TRUE(copy.isOccupied(Position::Index(5, 5)));
+    EXPECT_FALSE(map.isOccupied(Position::Index(6, 6)));
+}
+
+TEST(DistanceField, MatchesBruteForce)
+{
+    std::mt19937 rng(2);
+    for (const auto &[width, height] : {std::pair(1, 1), std::pair(37, 23), std::pair(64, 65), std::pair(130, 9)})
+    {
+        auto map = TestUtil::makeMap(width, height);
+        TestUtil::scatterObstacles(map, 0.03, rng);
+        map.computeDistanceField();
+
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width; ++x)
+                ASSERT_EQ(map.distance_field_.squaredDistance(x, y), TestUtil::bruteForceSquaredDistance(map.mapData_, x, y))
+                    << width << " x " << height << " at " << x << ", " << y;
+    }
+}
+
+TEST(DistanceField, IsInfiniteWithoutObstacles)
+{
+    auto map = TestUtil::makeMap(12, 8);
+    map.computeDistanceField();
+
+    EXPECT_EQ(map.distance_field_.squaredDistance(0, 0), DistanceField::INF);
+    EXPECT_EQ(map.distance_field_.squaredDistance(11, 7), DistanceField::INF);
+}
+
+TEST(BinaryOccupancyMap, EdtInflationIsExact)
+{
+    std::mt19937 rng(3);
+    auto map = TestUtil::makeMap(90, 70, 0.05);
+    TestUtil::scatterObstacles(map, 0.01, rng);
+
+    for (const double radius : {0.0, 0.05, 0.12, 0.3})
+    {
+        const BitGrid edt = map.inflate(radius, InflationMode::EDT);
+        const std::uint32_t threshold = getInflationThreshold(radius, map.property_.resolution_);
+        for (int y = 0; y < map.property_.height_; ++y)
+            for (int x = 0; x < map.property_.width_; ++x)
+                ASSERT_EQ(edt.get(x, y), TestUtil::bruteForceSquaredDistance(map.mapData_, x, y) <= threshold)
+                    << "radius " << radius << " at " << x << ", " << y;
+
+        // Brushfire follows the obstacle labels of its neighbours, which may
+        // miss the nearest obstacle, so it never inflates more than EDT
+        const BitGrid brushfire = map.inflate(radius, InflationMode::BRUSHFIRE);
+        brushfire.forEachSet([&](int _x, int _y)
+                             { EXPECT_TRUE(edt.get(_x, _y)) << "radius " << radius << " at " << _x << ", " << _y; });
+        EXPECT_GE(brushfire.count(), map.mapData_.count());
+    }
+}
+
+TEST(BinaryOccupancyMap, IncrementalUpdatesMatchRecompute)
+{
+    std::mt19937 rng(4);
+    auto map = TestUtil::makeMap(60, 45, 0.05);
+    TestUtil::scatterObstacles(map, 0.02, rng);
+    map.inflate(0.15);
+
+    for (int edit = 0; edit < 200; ++edit)
+    {
+        const Position::Index idx = TestUtil::randomIndex(map, rng);
+        const BitGrid before = map.inflated_mapData_;
+        const auto flipped = map.isOccupied(idx) ? map.markFree(idx) : map.markOccupied(idx);
+
+        BinaryOccupancyMap fresh = map;
+        fresh.computeDistanceField();
+        ASSERT_EQ(fresh.inflate(0.15), map.inflated_mapData_) << "after edit " << edit;
+        for (int y = 0; y < map.property_.height_; ++y)
+            for (int x = 0; x < map.property_.width_; ++x)
+                ASSERT_EQ(map.distance_field_.squaredDistance(x, y), fresh.distance_field_.squaredDistance(x, y));
+
+        // markOccupied()/markFree() report exactly the cells whose inflation flipped
+        std::size_t changed = 0;
+        for (int y = 0; y < map.property_.height_; ++y)
+            for (int x = 0; x < map.property_.width_; ++x)
+                changed += before.get(x, y) != map.inflated_mapData_.get(x, y);
+        ASSERT_EQ(flipped.size(), changed);
+        for (const auto &cell : flipped)
+            ASSERT_NE(before.get(cell.x_, cell.y_), map.isInflated(cell));
+    }
+}
+
+TEST(BinaryOccupancyMap, RemovingTheLastObstacleClearsInflation)
+{
+    auto map = TestUtil::makeMap(20, 20, 0.1);
+    map.markOccupied(Position::Index(10, 10));
+    map.inflate(0.3);
+    ASSERT_GT(map.inflated_mapData_.count(), 1u);
+
+    map.markFree(Position::Index(10, 10));
+    EXPECT_EQ(map.inflated_mapData_.count(), 0u);
+    EXPECT_EQ(map.distance_field_.squaredDistance(10, 10), DistanceField::INF);
+}
+
+TEST(InflatedView, MatchesInflateAtEveryRadius)
+{
+    std::mt19937 rng(5);
+    auto map = TestUtil::makeMap(50, 40, 0.05);
+    TestUtil::scatterObstacles(map, 0.02, rng);
+
+    for (const double radius : {0.0, 0.1, 0.25})
+    {
+        const InflatedView &view = map.inflatedView(radius);
+        const BitGrid &inflated = map.inflate(radius);
+
+        BitGrid materialized;
+        view.materialize(materialized);
+        EXPECT_EQ(materialized, inflated);
+        EXPECT_EQ(view.count(), inflated.count());
+        EXPECT_EQ(view.isInflated(7, 9), inflated.get(7, 9));
+    }
+}
+
+TEST(InflatedView, IsSharedByRadiiWithTheSameThreshold)
+{
+    auto map = TestUtil::makeMap(30, 30, 0.1);
+    map.markOccupied(Position::Index(15, 15));
+
+    const InflatedView &view = map.inflatedView(0.2);
+    EXPECT_EQ(&map.inflatedView(0.2 + 1e-12), &view);
+    EXPECT_NE(&map.inflatedView(0.5), &view);
+}
+
+TEST(InflatedView, FollowsIncrementalUpdates)
+{
+    auto map = TestUtil::makeMap(30, 30, 0.1);
+    map.markOccupied(Position::Index(5, 5));
+    const InflatedView &view = map.inflatedView(0.2);
+    ASSERT_FALSE(view.isInflated(20, 20));
+
+    map.markOccupied(Position::Index(20, 21));
+    EXPECT_TRUE(view.isInflated(20, 20));
+    map.markFree(Position::Index(20, 21));
+    EXPECT_FALSE(view.isInflated(20, 20));
+}
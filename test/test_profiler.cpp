@@ -0,0 +1,118 @@
+#ifndef MULTIBOT_UTIL_PROFILING
+#define MULTIBOT_UTIL_PROFILING
+#endif
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "multibot_util/Util/Profiler.hpp"
+
+using namespace MAPF_Util;
+
+namespace
+{
+    // First number after _name on the summary line that starts with it
+    double summaryValue(const std::string &_summary, const std::string &_name)
+    {
+        std::istringstream lines(_summary);
+        for (std::string line; std::getline(lines, line);)
+        {
+            std::istringstream fields(line);
+            std::string name;
+            double value;
+            if (fields >> name and name == _name and fields >> value)
+                return value;
+        }
+
+        return -1.0;
+    }
+
+    std::string summary()
+    {
+        std::ostringstream os;
+        Profiler::writeSummary(os);
+        return os.str();
+    }
+
+    std::string chromeTrace()
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "multibot_util_profiler_test.json").string();
+        EXPECT_TRUE(Profiler::writeChromeTrace(path));
+        std::ifstream file(path);
+        const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        std::filesystem::remove(path);
+
+        return contents;
+    }
+
+    std::size_t occurrences(const std::string &_text, const std::string &_pattern)
+    {
+        std::size_t count = 0;
+        for (std::size_t at = _text.find(_pattern); at != std::string::npos; at = _text.find(_pattern, at + 1))
+            ++count;
+
+        return count;
+    }
+
+    void work(int _scopes)
+    {
+        for (int i = 0; i < _scopes; ++i)
+        {
+            MULTIBOT_PROFILE_SCOPE("test_scope");
+            MULTIBOT_PROFILE_COUNT("test_counter", 2);
+            MULTIBOT_PROFILE_HISTOGRAM("test_histogram", i + 1);
+        }
+    }
+} // namespace
+
+TEST(Profiler, MergesSlotsAcrossThreads)
+{
+    Profiler::setEventCapacity(std::size_t(1) << 20);
+    Profiler::reset();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+        threads.emplace_back(work, 250);
+    for (auto &thread : threads)
+        thread.join();
+
+    const std::string text = summary();
+    EXPECT_EQ(summaryValue(text, "test_scope"), 1000.0) << text;
+    EXPECT_EQ(summaryValue(text, "test_counter"), 2000.0) << text;
+    EXPECT_EQ(summaryValue(text, "test_histogram"), 1000.0) << text;
+    EXPECT_EQ(occurrences(chromeTrace(), "\"name\": \"test_scope\", \"ph\": \"X\""), 1000u);
+
+    Profiler::reset();
+    EXPECT_EQ(summaryValue(summary(), "test_scope"), 0.0);
+}
+
+TEST(Profiler, CountsEventsPastTheCapacityAsDropped)
+{
+    Profiler::setEventCapacity(10);
+    Profiler::reset();
+
+    std::thread(work, 15).join();
+    const std::string text = summary();
+    EXPECT_EQ(summaryValue(text, "test_scope"), 15.0);
+    EXPECT_NE(text.find("5 trace events dropped"), std::string::npos) << text;
+    EXPECT_EQ(occurrences(chromeTrace(), "\"name\": \"test_scope\", \"ph\": \"X\""), 10u);
+
+    Profiler::setEventCapacity(std::size_t(1) << 20);
+}
+
+TEST(Profiler, ExitedThreadsHandTheirBuffersOn)
+{
+    Profiler::reset();
+    const std::size_t before = occurrences(chromeTrace(), "\"thread_name\"");
+
+    // Sequential threads adopt the buffer of the one before, so the trace grows by at most one row
+    for (int i = 0; i < 200; ++i)
+        std::thread(work, 1).join();
+
+    EXPECT_LE(occurrences(chromeTrace(), "\"thread_name\""), before + 1);
+    EXPECT_EQ(summaryValue(summary(), "test_scope"), 200.0);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include "multibot_util/Map/ReservationTable.hpp"
+#include "TestUtil.hpp"
+
+using namespace Instance::MapInstance;
+
+namespace
+{
+    BinaryOccupancyMap::MapProperty makeProperty()
+    {
+        return TestUtil::makeMap(60, 60, 0.1).property_;
+    }
+
+    // Every cell's safety at a grid of times
+    std::vector<bool> snapshot(const ReservationTable &_table)
+    {
+        std::vector<bool> safe;
+        for (int y = 0; y < 60; ++y)
+            for (int x = 0; x < 60; ++x)
+                for (double time = 0.0; time < 30.0; time += 0.25)
+                    safe.push_back(_table.isSafe(Position::Index(x, y), Time::TimePoint(time)));
+
+        return safe;
+    }
+} // namespace
+
+TEST(ReservationTable, ReservesCellsAlongTheSweptDisc)
+{
+    ReservationTable table(makeProperty());
+    table.insert(TestUtil::makeTraj("a", {{{1.0, 1.0, 0.0}, {3.0, 1.0, 2.0}}}), 0.1);
+    ASSERT_TRUE(table.contains("a"));
+
+    const Position::Index middle(20, 10);
+    EXPECT_TRUE(table.isSafe(middle, Time::TimePoint(0.0)));
+    EXPECT_FALSE(table.isSafe(middle, Time::TimePoint(1.0)));
+    EXPECT_TRUE(table.isSafe(middle, Time::TimePoint(1.9)));
+    ASSERT_NE(table.reservations(middle), nullptr);
+    EXPECT_EQ(table.reservations(middle)->size(), 1u);
+
+    // Parked at the goal forever, and never touching cells off the path
+    EXPECT_FALSE(table.isSafe(Position::Index(30, 10), Time::TimePoint(1e6)));
+    EXPECT_TRUE(table.isSafe(Position::Index(20, 30), Time::TimePoint(1.0)));
+    EXPECT_EQ(table.timeLine(Position::Index(20, 30)), nullptr);
+}
+
+TEST(ReservationTable, RemoveKeepsOtherAgents)
+{
+    ReservationTable table(makeProperty());
+    table.insert(TestUtil::makeTraj("a", {{{1.0, 1.0, 0.0}, {3.0, 1.0, 2.0}}}), 0.1);
+    table.insert(TestUtil::makeTraj("b", {{{2.0, 3.0, 0.0}, {2.0, 0.5, 5.0}}}), 0.1);
+
+    const Position::Index crossing(20, 10);
+    EXPECT_FALSE(table.isSafe(crossing, Time::TimePoint(1.0)));
+    EXPECT_FALSE(table.isSafe(crossing, Time::TimePoint(4.0)));
+
+    EXPECT_TRUE(table.remove("a"));
+    EXPECT_FALSE(table.remove("a"));
+    EXPECT_TRUE(table.isSafe(crossing, Time::TimePoint(1.0)));
+    EXPECT_FALSE(table.isSafe(crossing, Time::TimePoint(4.0)));
+    EXPECT_EQ(table.agentCount(), 1u);
+
+    table.remove("b");
+    EXPECT_EQ(table.reservedCells(), 0u);
+}
+
+TEST(ReservationTable, IncrementalEditsMatchARebuild)
+{
+    std::mt19937 rng(10);
+    Traj::TrajSet trajSet;
+    std::map<std::string, double> radii;
+    for (int i = 0; i < 8; ++i)
+    {
+        const std::string name = "agent" + std::to_string(i);
+        trajSet[name] = TestUtil::randomTraj(name, 12, 6.0, rng);
+        radii[name] = 0.1 + 0.05 * (i % 3);
+    }
+
+    ReservationTable incremental(makeProperty(), false);
+    incremental.build(trajSet, radii);
+
+    // Replace two trajectories and drop one
+    for (const std::string name : {"agent2", "agent5"})
+    {
+        trajSet[name] = TestUtil::randomTraj(name, 12, 6.0, rng);
+        incremental.insert(trajSet[name], radii[name]);
+    }
+    trajSet.erase("agent7");
+    incremental.remove("agent7");
+
+    ReservationTable rebuilt(makeProperty(), false);
+    rebuilt.build(trajSet, radii);
+
+    EXPECT_EQ(incremental.agentCount(), rebuilt.agentCount());
+    EXPECT_EQ(incremental.reservedCells(), rebuilt.reservedCells());
+    EXPECT_EQ(snapshot(incremental), snapshot(rebuilt));
+}
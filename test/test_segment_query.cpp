@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include "multibot_util/Map/SegmentQuery.hpp"
+#include "TestUtil.hpp"
+
+using namespace Instance::MapInstance;
+
+namespace
+{
+    Position::Coordinates randomCoordinates(const BinaryOccupancyMap &_map, std::mt19937 &_rng)
+    {
+        const auto &property = _map.property_;
+        std::uniform_real_distribution<double> x(property.origin_.x_, property.origin_.x_ + (property.width_ - 1) * property.resolution_);
+        std::uniform_real_distribution<double> y(property.origin_.y_, property.origin_.y_ + (property.height_ - 1) * property.resolution_);
+        return Position::Coordinates(x(_rng), y(_rng));
+    }
+
+    bool sampledCollision(const BinaryOccupancyMap &_map, const Position::Coordinates &_from, const Position::Coordinates &_to)
+    {
+        for (int step = 0; step <= 1000; ++step)
+        {
+            const double s = step / 1000.0;
+            const Position::Index idx = _map.getIndex(Position::Coordinates(_from.x_ + s * (_to.x_ - _from.x_),
+                                                                            _from.y_ + s * (_to.y_ - _from.y_)));
+            if (_map.isOutofMap(idx) or _map.isInflated(idx))
+                return true;
+        }
+
+        return false;
+    }
+} // namespace
+
+TEST(SegmentQuery, ReportsTheFirstBlockedCellInTravelOrder)
+{
+    auto map = TestUtil::makeMap(200, 20, 0.1);
+    map.setOccupied(Position::Index(70, 10), true);
+    map.setOccupied(Position::Index(130, 10), true);
+    const BitGrid &inflated = map.inflate(0.0);
+    int first = 10, last = 190;
+    while (not inflated.get(first, 10))
+        ++first;
+    while (not inflated.get(last, 10))
+        --last;
+    ASSERT_LE(first, 70);
+    ASSERT_GE(last, 130);
+
+    const auto forward = findSegmentCollision(map, map.getCoordinates(Position::Index(10, 10)), map.getCoordinates(Position::Index(190, 10)));
+    ASSERT_TRUE(forward.collides_);
+    EXPECT_EQ(forward.idx_, Position::Index(first, 10));
+
+    const auto backward = findSegmentCollision(map, map.getCoordinates(Position::Index(190, 10)), map.getCoordinates(Position::Index(10, 10)));
+    ASSERT_TRUE(backward.collides_);
+    EXPECT_EQ(backward.idx_, Position::Index(last, 10));
+
+    EXPECT_FALSE(findSegmentCollision(map, map.getCoordinates(Position::Index(10, 5)), map.getCoordinates(Position::Index(190, 5))).collides_);
+}
+
+TEST(SegmentQuery, LeavingTheMapCollides)
+{
+    auto map = TestUtil::makeMap(50, 50, 0.1);
+    map.inflate(0.0);
+
+    EXPECT_TRUE(findSegmentCollision(map, Position::Coordinates(2.0, 2.0), Position::Coordinates(7.0, 2.0)).collides_);
+    EXPECT_TRUE(findSegmentCollision(map, Position::Coordinates(2.0, 2.0), Position::Coordinates(2.0, -1.0)).collides_);
+    EXPECT_FALSE(findSegmentCollision(map, Position::Coordinates(0.0, 0.0), Position::Coordinates(4.9, 4.9)).collides_);
+}
+
+TEST(SegmentQuery, CoversEverySampledCell)
+{
+    std::mt19937 rng(7);
+    auto map = TestUtil::makeMap(120, 90, 0.05);
+    TestUtil::scatterObstacles(map, 0.002, rng);
+    map.inflate(0.1);
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        const Position::Coordinates from = randomCoordinates(map, rng);
+        const Position::Coordinates to = randomCoordinates(map, rng);
+        const SegmentCollision collision = findSegmentCollision(map, from, to);
+
+        // The swept supercover holds every cell a dense sampling visits
+        if (sampledCollision(map, from, to))
+        {
+            ASSERT_TRUE(collision.collides_) << from << " -> " << to;
+        }
+        if (collision.collides_)
+        {
+            EXPECT_TRUE(map.isOutofMap(collision.idx_) or map.isInflated(collision.idx_));
+            // The reported cell touches the segment
+            const Position::Coordinates center = map.getCoordinates(collision.idx_);
+            const Position::Coordinates direction = to - from;
+            const double length = std::hypot(direction.x_, direction.y_);
+            const double cross = std::fabs(direction.x_ * (center.y_ - from.y_) - direction.y_ * (center.x_ - from.x_));
+            EXPECT_LE(cross / std::max(length, 1e-12), map.property_.resolution_ * std::sqrt(0.5) + 1e-9);
+        }
+    }
+}
+
+TEST(SegmentQuery, BatchAndViewMatchScalar)
+{
+    std::mt19937 rng(8);
+    auto map = TestUtil::makeMap(100, 100, 0.05);
+    TestUtil::scatterObstacles(map, 0.003, rng);
+    map.inflate(0.15);
+    const InflatedView &view = map.inflatedView(0.15);
+
+    std::vector<Segment> segments;
+    for (int i = 0; i < 500; ++i)
+    {
+        const Position::Coordinates from = randomCoordinates(map, rng);
+        const Position::Coordinates to = randomCoordinates(map, rng);
+        segments.emplace_back(Position::Pose(from.x_, from.y_, 0.0), Position::Pose(to.x_, to.y_, 0.0));
+    }
+
+    const auto batch = findSegmentCollisions(map, segments);
+    const auto viewBatch = findSegmentCollisions(map, view, segments);
+    ASSERT_EQ(batch.size(), segments.size());
+    ASSERT_EQ(viewBatch.size(), segments.size());
+    for (std::size_t i = 0; i < segments.size(); ++i)
+    {
+        const auto scalar = findSegmentCollision(map, segments[i].first, segments[i].second);
+        EXPECT_EQ(batch[i].collides_, scalar.collides_);
+        EXPECT_EQ(batch[i].idx_, scalar.idx_);
+        EXPECT_EQ(viewBatch[i].collides_, scalar.collides_);
+        EXPECT_EQ(viewBatch[i].idx_, scalar.idx_);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "multibot_util/Interface/Subject.hpp"
+
+using namespace Observer;
+
+namespace
+{
+    class Recorder : public ObserverInterface<int>
+    {
+    public:
+        void update(const int &_msg) override
+        {
+            thread_ = std::this_thread::get_id();
+            last_.store(_msg);
+            count_.fetch_add(1);
+        }
+
+        std::atomic<int> last_{-1};
+        std::atomic<int> count_{0};
+        std::thread::id thread_;
+    }; // class Recorder
+
+    bool waitFor(const std::function<bool()> &_condition)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (not _condition())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::yield();
+        }
+
+        return true;
+    }
+} // namespace
+
+TEST(Subject, SyncObserversRunOnThePublisher)
+{
+    Subject<int> subject;
+    Recorder recorder;
+    subject.attach(recorder);
+    subject.attach(recorder);
+    EXPECT_EQ(subject.observerCount(), 1u);
+
+    subject.publish(7);
+    EXPECT_EQ(recorder.last_.load(), 7);
+    EXPECT_EQ(recorder.count_.load(), 1);
+    EXPECT_EQ(recorder.thread_, std::this_thread::get_id());
+
+    subject.detach(recorder);
+    subject.publish(8);
+    EXPECT_EQ(recorder.last_.load(), 7);
+    EXPECT_EQ(*subject.message(), 8);
+    EXPECT_EQ(subject.observerCount(), 0u);
+}
+
+TEST(Subject, AsyncObserversEventuallySeeTheLatestMessage)
+{
+    Subject<int> subject;
+    Recorder recorder;
+    subject.attach(recorder, DispatchMode::ASYNC);
+
+    for (int i = 1; i <= 1000; ++i)
+        subject.publish(i);
+    ASSERT_TRUE(waitFor([&]() { return recorder.last_.load() == 1000; }));
+    // Stale messages are replaced, never delivered out of order
+    EXPECT_LE(recorder.count_.load(), 1000);
+    EXPECT_NE(recorder.thread_, std::this_thread::get_id());
+
+    subject.detach(recorder);
+    const int delivered = recorder.count_.load();
+    subject.publish(1001);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(recorder.count_.load(), delivered);
+}
+
+TEST(Subject, ObserversMayDetachThemselves)
+{
+    class OneShot : public ObserverInterface<int>
+    {
+    public:
+        void update(const int &) override
+        {
+            count_.fetch_add(1);
+            subject_->detach(*this);
+        }
+
+        Subject<int> *subject_;
+        std::atomic<int> count_{0};
+    };
+
+    for (const DispatchMode mode : {DispatchMode::SYNC, DispatchMode::ASYNC})
+    {
+        Subject<int> subject;
+        OneShot oneShot;
+        oneShot.subject_ = &subject;
+        subject.attach(oneShot, mode);
+
+        subject.publish(1);
+        ASSERT_TRUE(waitFor([&]() { return subject.observerCount() == 0; }));
+        subject.publish(2);
+        EXPECT_EQ(oneShot.count_.load(), 1);
+    }
+}
+
+TEST(Subject, DetachWaitsForConcurrentPublishers)
+{
+    Subject<int> subject;
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> publishers;
+    for (int i = 0; i < 2; ++i)
+        publishers.emplace_back([&]()
+                                {
+                                    for (int value = 0; not stop.load(); ++value)
+                                        subject.publish(value);
+                                });
+
+    for (int round = 0; round < 200; ++round)
+    {
+        Recorder recorder;
+        subject.attach(recorder);
+        ASSERT_TRUE(waitFor([&]() { return recorder.count_.load() > 0; }));
+        subject.detach(recorder);
+
+        // Nothing may still be inside update() once detach() returns
+        const int delivered = recorder.count_.load();
+        std::this_thread::yield();
+        ASSERT_EQ(recorder.count_.load(), delivered);
+    }
+
+    stop.store(true);
+    for (auto &publisher : publishers)
+        publisher.join();
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "multibot_util/Map/TiledOccupancyMap.hpp"
+#include "TestUtil.hpp"
+
+using namespace Instance::MapInstance;
+
+namespace
+{
+    class TiledOccupancyMapTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            std::mt19937 rng(6);
+            // Not a multiple of the tile size, so edge tiles are partial
+            map_ = TestUtil::makeMap(150, 100, 0.05);
+            TestUtil::scatterObstacles(map_, 0.01, rng);
+            store_ = (std::filesystem::temp_directory_path() / "multibot_util_tiled_test.store").string();
+            ASSERT_TRUE(TiledOccupancyMap::writeStore(store_, map_, 64));
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove(store_);
+        }
+
+        BinaryOccupancyMap map_;
+        std::string store_;
+    }; // class TiledOccupancyMapTest
+} // namespace
+
+TEST_F(TiledOccupancyMapTest, ReadsTheStoredOccupancy)
+{
+    TiledOccupancyMap tiled;
+    ASSERT_TRUE(tiled.open(store_, 2));
+    EXPECT_EQ(tiled.property_.width_, map_.property_.width_);
+    EXPECT_EQ(tiled.property_.height_, map_.property_.height_);
+
+    for (int y = 0; y < map_.property_.height_; ++y)
+        for (int x = 0; x < map_.property_.width_; ++x)
+            ASSERT_EQ(tiled.isOccupied(Position::Index(x, y)), map_.isOccupied(Position::Index(x, y))) << x << ", " << y;
+
+    EXPECT_LE(tiled.residentTiles(), 2u);
+    EXPECT_TRUE(tiled.isOutofMap(Position::Index(150, 0)));
+}
+
+TEST_F(TiledOccupancyMapTest, InflatesExactlyAcrossTileBorders)
+{
+    TiledOccupancyMap tiled;
+    ASSERT_TRUE(tiled.open(store_, 3));
+
+    for (const double radius : {0.1, 0.35})
+    {
+        tiled.inflate(radius);
+        const BitGrid &inflated = map_.inflate(radius);
+        for (int y = 0; y < map_.property_.height_; ++y)
+            for (int x = 0; x < map_.property_.width_; ++x)
+                ASSERT_EQ(tiled.isInflated(Position::Index(x, y)), inflated.get(x, y))
+                    << "radius " << radius << " at " << x << ", " << y;
+
+        EXPECT_LE(tiled.residentTiles(), 6u);
+    }
+}
+
+TEST_F(TiledOccupancyMapTest, RejectsTileSizesOffWordBoundaries)
+{
+    EXPECT_FALSE(TiledOccupancyMap::writeStore(store_, map_, 48));
+}
+
+TEST_F(TiledOccupancyMapTest, RejectsCorruptTileLayouts)
+{
+    // Byte offsets of width_, height_, tile_size_, tiles_x_ and tiles_y_ in the store header
+    const auto corrupt = [this](std::streamoff _field, std::int32_t _value)
+    {
+        ASSERT_TRUE(TiledOccupancyMap::writeStore(store_, map_, 64));
+        std::fstream store(store_, std::ios::binary | std::ios::in | std::ios::out);
+        store.seekp(_field);
+        store.write(reinterpret_cast<const char *>(&_value), sizeof(_value));
+    };
+
+    TiledOccupancyMap tiled;
+    for (const std::int32_t tileSize : {0, -64, 32})
+    {
+        corrupt(24, tileSize);
+        EXPECT_FALSE(tiled.open(store_)) << tileSize;
+    }
+    corrupt(16, 0);
+    EXPECT_FALSE(tiled.open(store_));
+    corrupt(20, -100);
+    EXPECT_FALSE(tiled.open(store_));
+    corrupt(28, 2);
+    EXPECT_FALSE(tiled.open(store_));
+    corrupt(32, 3);
+    EXPECT_FALSE(tiled.open(store_));
+
+    // A store cut short of its last tile
+    ASSERT_TRUE(TiledOccupancyMap::writeStore(store_, map_, 64));
+    std::filesystem::resize_file(store_, std::filesystem::file_size(store_) - 1);
+    EXPECT_FALSE(tiled.open(store_));
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "multibot_util/MAPF_Util.hpp"
+
+using namespace MAPF_Util;
+
+namespace
+{
+    // Sorted, contiguous, alternating partition of [0, max)
+    void expectPartition(const Time::TimeLine &_timeLine)
+    {
+        const auto &intervals = _timeLine.interval_list_;
+        ASSERT_FALSE(intervals.empty());
+        EXPECT_EQ(intervals.front().startTime_, Time::TimePoint(0));
+        EXPECT_EQ(intervals.back().endTime_, Time::TimePoint::max());
+        for (std::size_t i = 0; i < intervals.size(); ++i)
+        {
+            EXPECT_LT(intervals[i].startTime_, intervals[i].endTime_);
+            if (i == 0)
+                continue;
+            EXPECT_EQ(intervals[i].startTime_, intervals[i - 1].endTime_);
+            EXPECT_NE(intervals[i].is_safe_, intervals[i - 1].is_safe_);
+        }
+    }
+} // namespace
+
+TEST(TimeLine, StartsAsOneSafeInterval)
+{
+    const Time::TimeLine timeLine;
+    ASSERT_EQ(timeLine.interval_list_.size(), 1u);
+    EXPECT_TRUE(timeLine.isSafe(Time::TimePoint(0)));
+    EXPECT_TRUE(timeLine.isSafe(Time::TimePoint(1e9)));
+    EXPECT_EQ(timeLine.findSafeInterval(Time::TimePoint(3)), timeLine.interval_list_.begin());
+    EXPECT_EQ(timeLine.findNextSafeInterval(Time::TimePoint(3)), timeLine.interval_list_.end());
+}
+
+TEST(TimeLine, SplitsAndMergesReservations)
+{
+    Time::TimeLine timeLine;
+    timeLine.insertReservation(Time::TimePoint(2), Time::TimePoint(4));
+    ASSERT_EQ(timeLine.interval_list_.size(), 3u);
+    expectPartition(timeLine);
+
+    EXPECT_TRUE(timeLine.isSafe(Time::TimePoint(1.999)));
+    EXPECT_FALSE(timeLine.isSafe(Time::TimePoint(2)));
+    EXPECT_FALSE(timeLine.isSafe(Time::TimePoint(3.999)));
+    EXPECT_TRUE(timeLine.isSafe(Time::TimePoint(4)));
+
+    const auto next = timeLine.findNextSafeInterval(Time::TimePoint(3));
+    ASSERT_NE(next, timeLine.interval_list_.end());
+    EXPECT_EQ(next->startTime_, Time::TimePoint(4));
+    EXPECT_EQ(timeLine.findSafeInterval(Time::TimePoint(3)), timeLine.interval_list_.end());
+
+    // Overlapping and adjacent reservations merge into one collision interval
+    timeLine.insertReservation(Time::TimePoint(3), Time::TimePoint(6));
+    timeLine.insertReservation(Time::TimePoint(6), Time::TimePoint(7));
+    ASSERT_EQ(timeLine.interval_list_.size(), 3u);
+    EXPECT_EQ(timeLine.interval_list_[1].endTime_, Time::TimePoint(7));
+
+    // Removing the middle splits it, removing the rest merges back to one safe interval
+    timeLine.removeReservation(Time::TimePoint(4), Time::TimePoint(5));
+    EXPECT_EQ(timeLine.interval_list_.size(), 5u);
+    expectPartition(timeLine);
+    timeLine.removeReservation(Time::TimePoint(0), Time::TimePoint(10));
+    EXPECT_EQ(timeLine.interval_list_.size(), 1u);
+    EXPECT_TRUE(timeLine.interval_list_.front().is_safe_);
+}
+
+TEST(TimeLine, IgnoresEmptyRanges)
+{
+    Time::TimeLine timeLine;
+    timeLine.insertReservation(Time::TimePoint(5), Time::TimePoint(5));
+    timeLine.insertReservation(Time::TimePoint(6), Time::TimePoint(4));
+    EXPECT_EQ(timeLine.interval_list_.size(), 1u);
+}
+
+TEST(TimeLine, MatchesASlotReference)
+{
+    constexpr int SLOTS = 80;
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int> slot(0, SLOTS);
+
+    Time::TimeLine timeLine;
+    bool reserved[SLOTS] = {};
+    for (int edit = 0; edit < 2000; ++edit)
+    {
+        int begin = slot(rng), end = slot(rng);
+        if (begin > end)
+            std::swap(begin, end);
+        const bool insert = rng() % 2 == 0;
+
+        if (insert)
+            timeLine.insertReservation(Time::TimePoint(begin * 0.5), Time::TimePoint(end * 0.5));
+        else
+            timeLine.removeReservation(Time::TimePoint(begin * 0.5), Time::TimePoint(end * 0.5));
+        for (int s = begin; s < end; ++s)
+            reserved[s] = insert;
+
+        expectPartition(timeLine);
+        for (int s = 0; s < SLOTS; ++s)
+        {
+            ASSERT_EQ(timeLine.isSafe(Time::TimePoint(s * 0.5 + 0.25)), not reserved[s]) << "slot " << s << " after edit " << edit;
+
+            // First safe run starting after the query; slots past SLOTS are free
+            int nextSafe = s + 1;
+            while (nextSafe <= SLOTS and not(reserved[nextSafe - 1] and (nextSafe == SLOTS or not reserved[nextSafe])))
+                ++nextSafe;
+
+            const auto next = timeLine.findNextSafeInterval(Time::TimePoint(s * 0.5 + 0.25));
+            if (nextSafe > SLOTS)
+            {
+                ASSERT_EQ(next, timeLine.interval_list_.end()) << "slot " << s << " after edit " << edit;
+                continue;
+            }
+            ASSERT_NE(next, timeLine.interval_list_.end()) << "slot " << s << " after edit " << edit;
+            ASSERT_EQ(next->startTime_, Time::TimePoint(nextSafe * 0.5)) << "slot " << s << " after edit " << edit;
+        }
+    }
+}
+
+TEST(TimeLine, ClearDropsEveryReservation)
+{
+    Time::TimeLine timeLine;
+    timeLine.insertReservation(Time::TimePoint(1), Time::TimePoint(2));
+    timeLine.insertReservation(Time::TimePoint(3), Time::TimePoint(4));
+    timeLine.clear();
+
+    ASSERT_EQ(timeLine.interval_list_.size(), 1u);
+    EXPECT_TRUE(timeLine.isSafe(Time::TimePoint(1.5)));
+}
\ No newline at end of file
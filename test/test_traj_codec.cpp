@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+
+#include "multibot_util/Traj/TrajCodec.hpp"
+#include "TestUtil.hpp"
+
+using namespace MAPF_Util;
+
+namespace
+{
+    Traj::TrajSet makeTrajSet(std::mt19937 &_rng)
+    {
+        Traj::TrajSet trajSet;
+        for (int i = 0; i < 12; ++i)
+        {
+            const std::string name = "agent" + std::to_string(i);
+            trajSet[name] = TestUtil::randomTraj(name, 5 + i, 30.0, _rng);
+            // Negative coordinates, a wait, and a goal held forever
+            trajSet[name].nodes_.front().first.pose_.component_.x -= 40.0;
+            trajSet[name].nodes_.front().first.departure_time_ += Time::TimePoint(0.75);
+            trajSet[name].nodes_.back().second.departure_time_ = Time::TimePoint::max();
+        }
+        trajSet["empty"].agentName_ = "empty";
+        trajSet["empty"].cost_ = 0.0;
+
+        return trajSet;
+    }
+
+    void expectNear(const Traj::Node &_decoded, const Traj::Node &_original, const Traj::TrajCodec::Quantization &_quantization)
+    {
+        EXPECT_NEAR(_decoded.pose_.component_.x, _original.pose_.component_.x, _quantization.position_ / 2 + 1e-12);
+        EXPECT_NEAR(_decoded.pose_.component_.y, _original.pose_.component_.y, _quantization.position_ / 2 + 1e-12);
+        EXPECT_NEAR(_decoded.pose_.component_.theta, _original.pose_.component_.theta, _quantization.angle_ / 2 + 1e-12);
+        EXPECT_NEAR(_decoded.arrival_time_.count(), _original.arrival_time_.count(), _quantization.time_ / 2 + 1e-12);
+        if (_original.departure_time_ == Time::TimePoint::max())
+            EXPECT_EQ(_decoded.departure_time_, Time::TimePoint::max());
+        else
+            EXPECT_NEAR(_decoded.departure_time_.count(), _original.departure_time_.count(), _quantization.time_ / 2 + 1e-12);
+    }
+
+    void expectRoundTrip(const Traj::TrajSet &_decoded, const Traj::TrajSet &_original, const Traj::TrajCodec::Quantization &_quantization)
+    {
+        ASSERT_EQ(_decoded.size(), _original.size());
+        for (const auto &[name, traj] : _original)
+        {
+            const auto decoded = _decoded.find(name);
+            ASSERT_NE(decoded, _decoded.end()) << name;
+            EXPECT_EQ(decoded->second.agentName_, traj.agentName_);
+            EXPECT_EQ(decoded->second.cost_, traj.cost_);
+            ASSERT_EQ(decoded->second.nodes_.size(), traj.nodes_.size()) << name;
+            for (std::size_t i = 0; i < traj.nodes_.size(); ++i)
+            {
+                expectNear(decoded->second.nodes_[i].first, traj.nodes_[i].first, _quantization);
+                expectNear(decoded->second.nodes_[i].second, traj.nodes_[i].second, _quantization);
+            }
+        }
+    }
+} // namespace
+
+TEST(TrajCodec, RoundTripsWithinQuantization)
+{
+    std::mt19937 rng(12);
+    const Traj::TrajSet trajSet = makeTrajSet(rng);
+
+    for (const Traj::TrajCodec::Quantization quantization : {Traj::TrajCodec::Quantization(),
+                                                             Traj::TrajCodec::Quantization{1e-2, 1e-3, 1e-2}})
+    {
+        const std::vector<unsigned char> encoded = Traj::TrajCodec::encode(trajSet, quantization);
+        Traj::TrajSetView view;
+        ASSERT_TRUE(view.open(encoded.data(), encoded.size()));
+        expectRoundTrip(view.toTrajSet(), trajSet, quantization);
+    }
+}
+
+TEST(TrajCodec, ViewsDecodeInPlace)
+{
+    std::mt19937 rng(13);
+    const Traj::TrajSet trajSet = makeTrajSet(rng);
+    const std::vector<unsigned char> encoded = Traj::TrajCodec::encode(trajSet);
+
+    Traj::TrajSetView view;
+    ASSERT_TRUE(view.open(encoded.data(), encoded.size()));
+    ASSERT_EQ(view.size(), trajSet.size());
+
+    // Stored in key order, iterating matches the decoded copy
+    std::size_t i = 0;
+    for (const auto &[name, traj] : trajSet)
+    {
+        const Traj::TrajView trajView = view[i++];
+        EXPECT_EQ(trajView.key(), name);
+        ASSERT_EQ(trajView.size(), traj.nodes_.size());
+        const Traj::SingleTraj copy = trajView.toSingleTraj();
+        std::size_t pair = 0;
+        for (const auto &[from, to] : trajView)
+        {
+            EXPECT_EQ(from.pose_, copy.nodes_[pair].first.pose_);
+            EXPECT_EQ(to.arrival_time_, copy.nodes_[pair].second.arrival_time_);
+            ++pair;
+        }
+        EXPECT_EQ(pair, traj.nodes_.size());
+    }
+
+    const auto found = view.find("agent7");
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(found->agentName(), "agent7");
+    EXPECT_FALSE(view.find("agent70").has_value());
+}
+
+TEST(TrajCodec, ReadsFilesAndRejectsDamagedBuffers)
+{
+    std::mt19937 rng(14);
+    const Traj::TrajSet trajSet = makeTrajSet(rng);
+    const std::string path = (std::filesystem::temp_directory_path() / "multibot_util_traj_codec_test.traj").string();
+    ASSERT_TRUE(Traj::TrajCodec::write(path, trajSet));
+
+    Traj::TrajSetView view;
+    ASSERT_TRUE(view.open(path));
+    expectRoundTrip(view.toTrajSet(), trajSet, Traj::TrajCodec::Quantization());
+    std::filesystem::remove(path);
+
+    std::vector<unsigned char> encoded = Traj::TrajCodec::encode(trajSet);
+    EXPECT_FALSE(view.open(encoded.data(), encoded.size() - 1));
+    EXPECT_FALSE(view.open(encoded.data(), sizeof(Traj::TrajCodec::Header) - 1));
+    encoded[0] ^= 0xff;
+    EXPECT_FALSE(view.open(encoded.data(), encoded.size()));
+}
+
+
+TEST(TrajCodec, RejectsTableOffsetsThatWrapAround)
+{
+    std::mt19937 rng(15);
+    const std::vector<unsigned char> encoded = Traj::TrajCodec::encode(makeTrajSet(rng));
+
+    const auto corrupt = [&encoded](std::size_t _field, auto _value)
+    {
+        std::vector<unsigned char> damaged = encoded;
+        std::memcpy(damaged.data() + _field, &_value, sizeof(_value));
+        Traj::TrajSetView view;
+        return view.open(damaged.data(), damaged.size());
+    };
+
+    EXPECT_FALSE(corrupt(offsetof(Traj::TrajCodec::Header, strings_offset_), UINT64_MAX - 3));
+    EXPECT_FALSE(corrupt(offsetof(Traj::TrajCodec::Header, records_offset_), UINT64_MAX - 7));
+    EXPECT_FALSE(corrupt(offsetof(Traj::TrajCodec::Header, body_offset_), UINT64_MAX));
+    EXPECT_FALSE(corrupt(offsetof(Traj::TrajCodec::Header, string_count_), UINT32_MAX));
+    EXPECT_FALSE(corrupt(offsetof(Traj::TrajCodec::Header, traj_count_), UINT32_MAX));
+}
\ No newline at end of file
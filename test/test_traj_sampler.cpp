@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "multibot_util/Traj/TrajSampler.hpp"
+#include "TestUtil.hpp"
+
+using namespace MAPF_Util;
+
+TEST(SingleTraj, PoseAtWaitsThenInterpolates)
+{
+    // Waits at the start over [0, 1), then turns the short way across +-pi while moving
+    Traj::SingleTraj traj;
+    traj.agentName_ = "a";
+    traj.nodes_.emplace_back(Traj::Node{Position::Pose(0.0, 0.0, 3.0), Time::TimePoint(0.0), Time::TimePoint(1.0)},
+                             Traj::Node{Position::Pose(2.0, 4.0, -3.0), Time::TimePoint(3.0), Time::TimePoint(3.0)});
+
+    EXPECT_EQ(traj.poseAt(Time::TimePoint(-1.0)), Position::Pose(0.0, 0.0, 3.0));
+    EXPECT_EQ(traj.poseAt(Time::TimePoint(0.5)), Position::Pose(0.0, 0.0, 3.0));
+    EXPECT_EQ(traj.poseAt(Time::TimePoint(5.0)), Position::Pose(2.0, 4.0, -3.0));
+
+    const Position::Pose middle = traj.poseAt(Time::TimePoint(2.0));
+    EXPECT_NEAR(middle.component_.x, 1.0, 1e-12);
+    EXPECT_NEAR(middle.component_.y, 2.0, 1e-12);
+    EXPECT_NEAR(std::fabs(middle.component_.theta), M_PI, 1e-12);
+}
+
+TEST(TrajSampler, MatchesPoseAtInAnyTimeOrder)
+{
+    std::mt19937 rng(11);
+    Traj::TrajSet trajSet;
+    for (int i = 0; i < 20; ++i)
+    {
+        const std::string name = "agent" + std::to_string(i);
+        trajSet[name] = TestUtil::randomTraj(name, 10 + i, 10.0, rng);
+    }
+
+    Traj::TrajSampler sampler(trajSet);
+    ASSERT_EQ(sampler.size(), trajSet.size());
+    std::vector<Position::Pose> poses(sampler.size()), oneOff(sampler.size());
+
+    const auto expectSamples = [&](double _time)
+    {
+        sampler.sample(Time::TimePoint(_time), poses);
+        Traj::sample(trajSet, Time::TimePoint(_time), oneOff);
+        std::size_t i = 0;
+        for (const auto &[name, traj] : trajSet)
+        {
+            ASSERT_EQ(*sampler.agentNames()[i], name);
+            ASSERT_EQ(poses[i], traj.poseAt(Time::TimePoint(_time))) << name << " at " << _time;
+            ASSERT_EQ(oneOff[i], poses[i]) << name << " at " << _time;
+            ++i;
+        }
+    };
+
+    // Forward sweep through every node time and between them, then random jumps both ways
+    for (double time = -0.5; time < 40.0; time += 0.05)
+        expectSamples(time);
+    for (const auto &[name, traj] : trajSet)
+        for (const auto &[from, to] : traj.nodes_)
+            expectSamples(to.arrival_time_.count());
+
+    std::uniform_real_distribution<double> time(-1.0, 40.0);
+    for (int i = 0; i < 500; ++i)
+        expectSamples(time(rng));
+}
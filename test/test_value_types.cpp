@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "multibot_util/Instance.hpp"
+
+using namespace MAPF_Util;
+
+namespace
+{
+    // Any message with x, y and theta fields, like geometry_msgs::msg::Pose2D
+    struct FakePose2D
+    {
+        double x = 0.0, y = 0.0, theta = 0.0;
+    }; // struct FakePose2D
+
+    static_assert(std::is_trivially_copyable_v<Instance::MapInstance::Cell>);
+    static_assert(std::is_trivially_copyable_v<Position::Pose2D> and sizeof(Position::Pose2D) == 3 * sizeof(double));
+    static_assert(std::is_nothrow_move_constructible_v<Time::TimeLine>);
+    static_assert(std::is_nothrow_move_constructible_v<Traj::SingleTraj>);
+    static_assert(std::is_nothrow_move_assignable_v<Traj::SingleTraj>);
+    static_assert(not std::is_convertible_v<int, Position::Pose2D>);
+} // namespace
+
+TEST(ValueTypes, CopyAsPlainMemory)
+{
+    const Traj::Node node{Position::Pose(1.0, 2.0, 0.5), Time::TimePoint(3.0), Time::TimePoint(4.0)};
+    Traj::Node copy;
+    std::memcpy(static_cast<void *>(&copy), &node, sizeof(node));
+    EXPECT_EQ(copy.pose_, node.pose_);
+    EXPECT_EQ(copy.arrival_time_, node.arrival_time_);
+    EXPECT_EQ(copy.departure_time_, node.departure_time_);
+
+    constexpr Position::Pose pose(1.0, 2.0, 3.0);
+    static_assert(pose == Position::Pose(1.0, 2.0, 3.0));
+}
+
+TEST(ValueTypes, PosesConvertToAndFromMessages)
+{
+    const FakePose2D msg{1.5, -2.5, 0.25};
+    const Position::Pose pose(msg);
+    EXPECT_EQ(pose, Position::Pose(1.5, -2.5, 0.25));
+
+    const FakePose2D back = pose.component_;
+    EXPECT_EQ(back.x, msg.x);
+    EXPECT_EQ(back.y, msg.y);
+    EXPECT_EQ(back.theta, msg.theta);
+
+    Position::Pose assigned;
+    assigned.component_ = msg;
+    EXPECT_EQ(assigned, pose);
+}
+
+TEST(ValueTypes, MovedTrajectoriesKeepTheirNodes)
+{
+    Traj::SingleTraj traj;
+    traj.agentName_ = "a";
+    traj.nodes_.resize(100);
+    const auto *nodes = traj.nodes_.data();
+
+    const Traj::SingleTraj moved = std::move(traj);
+    EXPECT_EQ(moved.nodes_.data(), nodes);
+    EXPECT_EQ(moved.agentName_, "a");
+}